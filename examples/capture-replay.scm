@@ -0,0 +1,57 @@
+;
+; capture-replay.scm -- record a live stream, and play it back.
+;
+; Live sources, an IRC channel or a socket, never send the same thing
+; twice, so a pipeline reading from them can't be timed, or debugged,
+; on the same input twice. The *-capture-* message records every item
+; a node hands out, with the time it came, to a file. A ReplayNode
+; plays the file back, through the same *-read-* and *-stream-*
+; methods, either at the recorded pace, or as fast as it can.
+
+(use-modules (opencog) (opencog sensory))
+
+; --------------------------------------------------------
+; Record from IRC. See `irc-api.scm` for more about this.
+
+(PipeLink (NameNode "irc") (IRChatNode "irc://capbot@irc.libera.chat:6667"))
+(Trigger (SetValue (NameNode "irc") (Predicate "*-capture-*")
+	(Item "/tmp/irc.cap")))
+(Trigger (SetValue (NameNode "irc") (Predicate "*-open-*") (Type 'ItemNode)))
+(Trigger (SetValue (NameNode "irc") (Predicate "*-write-*")
+	(Item "JOIN #opencog")))
+
+; Everything read is recorded, whoever reads it.
+(Trigger (ValueOf (NameNode "irc") (Predicate "*-read-*")))
+(Trigger (ValueOf (NameNode "irc") (Predicate "*-read-*")))
+(Trigger (ValueOf (NameNode "irc") (Predicate "*-monitor-*")))
+
+; Stop recording; this closes the file.
+(Trigger (SetValue (NameNode "irc") (Predicate "*-capture-*") (VoidValue)))
+(Trigger (SetValue (NameNode "irc") (Predicate "*-close-*")))
+
+; --------------------------------------------------------
+; Play it back, at the pace it came in. The *-open-* argument is
+; ignored; the items are whatever was recorded.
+
+(PipeLink (NameNode "replay") (ReplayNode "file:///tmp/irc.cap"))
+(Trigger (SetValue (NameNode "replay") (Predicate "*-open-*") (VoidValue)))
+(Trigger (ValueOf (NameNode "replay") (Predicate "*-read-*")))
+(Trigger (ValueOf (NameNode "replay") (Predicate "*-read-*")))
+
+; --------------------------------------------------------
+; Flat out, for a benchmark: pump the whole recording into a file.
+; Speed 2 would be twice the recorded pace; 0 is no waiting at all.
+
+(PipeLink (NameNode "out") (TextFile "file:///tmp/irc-replayed.txt"))
+(Trigger (SetValue (NameNode "out") (Predicate "*-open-*") (Type 'StringValue)))
+
+(Trigger (SetValue (NameNode "replay") (Predicate "*-speed-*") (Number 0)))
+(Trigger (SetValue (NameNode "replay") (Predicate "*-open-*") (VoidValue)))
+(Trigger (Pump (NameNode "replay") (NameNode "out")))
+(Trigger (ValueOf (NameNode "replay") (Predicate "*-monitor-*")))
+
+(Trigger (SetValue (NameNode "replay") (Predicate "*-close-*")))
+(Trigger (SetValue (NameNode "out") (Predicate "*-close-*")))
+
+; --------------------------------------------------------
+; The End! That's All, Folks!
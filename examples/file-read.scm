@@ -188,5 +188,87 @@
 (Trigger (LgParseBonds (Name "txt stream gen") (LgDict "any") (Number 1)))
 (Trigger (LgParseBonds (Name "txt stream gen") (LgDict "any") (Number 1)))
 
+; --------------------------------------------------------
+; Big files do not have to be read from the start. The *-seek-*
+; message moves the read position to any line (numbered from one)
+; or any byte offset. Seeking by line uses a sparse index of line
+; offsets, built the first time it is needed. The *-index-* message
+; can ask for this index to be saved in a sidecar file, so that it
+; does not have to be rebuilt the next time around.
+
+(Trigger
+	(SetValue (NameNode "file node") (Predicate "*-index-*")
+		(StringValue "/tmp/demo.txt.idx")))
+
+(Trigger
+	(SetValue (NameNode "file node") (Predicate "*-seek-*") (Number 3)))
+(Trigger (ValueOf (NameNode "file node") (Predicate "*-read-*")))
+
+(Trigger
+	(SetValue (NameNode "file node") (Predicate "*-seek-*")
+		(List (Item "byte") (Number 0))))
+(Trigger (ValueOf (NameNode "file node") (Predicate "*-read-*")))
+
+; --------------------------------------------------------
+; Huge files can be split into lines by several threads at once. The
+; *-parallel-* message sets the number of threads; they start on the
+; next read, and cover the file from the read position to its end.
+; Lines come out in file order, unless "unordered" is asked for; this
+; is faster, when the order does not matter.
+
+(Trigger
+	(SetValue (NameNode "file node") (Predicate "*-parallel-*")
+		(List (Number 4) (Item "unordered"))))
+(Trigger
+	(SetValue (NameNode "file node") (Predicate "*-open-*")
+		(Type 'StringValue)))
+(Trigger (ValueOf (NameNode "file node") (Predicate "*-read-*")))
+(Trigger (ValueOf (NameNode "file node") (Predicate "*-read-*")))
+
+; --------------------------------------------------------
+; CSV and TSV files can be split into fields as they are read. Each
+; line becomes a StringValue with one string per field. Quoted fields
+; may contain the delimiter. With the "numeric" option, each line
+; becomes a FloatValue instead; fields that are not numbers are NaN.
+
+(Trigger
+	(SetValue (NameNode "file node") (Predicate "*-parallel-*") (Number 0)))
+(Trigger
+	(SetValue (NameNode "file node") (Predicate "*-fields-*")
+		(List (Item " ") (Item "noquote"))))
+(Trigger
+	(SetValue (NameNode "file node") (Predicate "*-open-*")
+		(Type 'StringValue)))
+(Trigger (ValueOf (NameNode "file node") (Predicate "*-read-*")))
+(Trigger
+	(SetValue (NameNode "file node") (Predicate "*-fields-*") (VoidValue)))
+
+; --------------------------------------------------------
+; JSON-lines (NDJSON) files: open with (Type 'LinkValue), and each
+; line is parsed as JSON. Objects become a LinkValue of (key value)
+; pairs; arrays of numbers become a FloatValue.
+
+(with-output-to-file "/tmp/demo.ndjson"
+	(lambda () (display "{\"who\":\"me\",\"where\":[1.5,2.5]}\n")))
+(PipeLink (NameNode "json node") (TextFile "file:///tmp/demo.ndjson"))
+(Trigger
+	(SetValue (NameNode "json node") (Predicate "*-open-*")
+		(Type 'LinkValue)))
+(Trigger (ValueOf (NameNode "json node") (Predicate "*-read-*")))
+
+; --------------------------------------------------------
+; Lines are read with their trailing newline. The *-normalize-*
+; message can trim it off (and the CR of DOS files), and can check
+; that lines are valid UTF-8: "validate" drops bad lines, and
+; "repair" patches them up with U+FFFD replacement characters.
+
+(Trigger
+	(SetValue (NameNode "file node") (Predicate "*-normalize-*")
+		(StringValue "trim" "repair")))
+(Trigger
+	(SetValue (NameNode "file node") (Predicate "*-open-*")
+		(Type 'StringValue)))
+(Trigger (ValueOf (NameNode "file node") (Predicate "*-read-*")))
+
 ; --------------------------------------------------------
 ; The End! That's All, Folks!
@@ -96,5 +96,94 @@
 (Trigger (DefinedSchema "tail rule applier"))
 (Trigger (DefinedSchema "tail rule applier"))
 
+; --------------------------------------------------------
+; Most lines of a log file are not interesting. Rather than reading
+; them all, and then throwing most away with a FilterLink, a filter
+; can be placed on the file itself. Lines that don't pass never get
+; turned into Values. The filter can be a substring, a prefix or a
+; regex. The *-monitor-* message reports how many lines were kept,
+; and how many were dropped.
+
+(cog-set-value! (NameNode "tail file") (Predicate "*-filter-*")
+	(List (Item "regex") (Item "^(ERROR|WARN) ")))
+(Trigger (ValueOf (NameNode "tail file") (Predicate "*-read-*")))
+(Trigger (ValueOf (NameNode "tail file") (Predicate "*-monitor-*")))
+
+; A VoidValue removes the filter.
+(cog-set-value! (NameNode "tail file") (Predicate "*-filter-*") (VoidValue))
+
+; --------------------------------------------------------
+; Log files can be huge; re-reading them from the start, every time
+; that the process restarts, is a waste. The read offset can be saved
+; to a checkpoint file, at each *-barrier-* and *-close-*, and picked
+; up again on the next *-open-*. With (BoolValue #t), the checkpoint
+; goes into `/tmp/tail.txt.offset`; a StringValue gives another place.
+; The checkpoint is ignored if the file was truncated or replaced.
+;
+; While following, log rotation is handled: if the file is renamed
+; or deleted, the rest of it is read, and then the new file that
+; appears at the same path is followed.
+
+(Trigger (SetValue (NameNode "tail file") (Predicate "*-close-*") (VoidValue)))
+(cog-set-value! (NameNode "tail file") (Predicate "*-checkpoint-*")
+	(BoolValue #t))
+(Trigger
+	(SetValue (NameNode "tail file") (Predicate "*-open-*")
+		(Type 'StringValue)))
+(cog-set-value! (NameNode "tail file") (Predicate "*-follow-*") (BoolValue #t))
+(Trigger (ValueOf (NameNode "tail file") (Predicate "*-read-*")))
+(Trigger (SetValue (NameNode "tail file") (Predicate "*-barrier-*") (VoidValue)))
+
+; --------------------------------------------------------
+; A read of a followed file waits until there is something to read.
+; To poll it instead, give it a timeout, in milliseconds. A read that
+; times out returns a TimeoutValue; end-of-file is still a
+; VoidValue. Zero waits forever again. Sockets, terminals, IRC and
+; Ollama nodes take the same message.
+
+(cog-set-value! (NameNode "tail file") (Predicate "*-timeout-*") (Number 500))
+(Trigger (ValueOf (NameNode "tail file") (Predicate "*-read-*")))
+(cog-set-value! (NameNode "tail file") (Predicate "*-timeout-*") (Number 0))
+
+; --------------------------------------------------------
+; To follow several files (or sockets, or chat channels) from one
+; thread, wait on all of them at once, with a SelectLink. It returns
+; the nodes that have something to read, or, with a timeout, an empty
+; LinkValue if none do. A SelectReadLink also reads from the first
+; one of them. Create `/tmp/other.txt` first; then try
+; `echo foo >> /tmp/other.txt` while it waits.
+
+(PipeLink (NameNode "other file") (TextFile "file:///tmp/other.txt"))
+(Trigger
+	(SetValue (NameNode "other file") (Predicate "*-open-*")
+		(Type 'StringValue)))
+(cog-set-value! (NameNode "other file") (Predicate "*-follow-*")
+	(BoolValue #t))
+
+(Trigger (Select (NameNode "tail file") (NameNode "other file")
+	(Number 10000)))
+(Trigger (SelectRead (NameNode "tail file") (NameNode "other file")))
+
+; --------------------------------------------------------
+; Some files are more like gauges than logs: a sensor appends a new
+; reading many times a second, and only the current one matters.
+; With *-conflate-* on, *-stream-* gives the latest line, skipping
+; those that came in since the last look; the monitor counts how
+; many were skipped ("superseded"). Try `while true; do date +%N
+; >> /tmp/tail.txt; done` in another terminal.
+
+(cog-set-value! (NameNode "tail file") (Predicate "*-conflate-*")
+	(BoolValue #t))
+(Pipe
+	(Name "tail sample")
+	(StreamValueOf (NameNode "tail file") (Predicate "*-stream-*")))
+
+(Trigger (Name "tail sample"))
+(Trigger (Name "tail sample"))
+(Trigger (ValueOf (NameNode "tail file") (Predicate "*-monitor-*")))
+
+(cog-set-value! (NameNode "tail file") (Predicate "*-conflate-*")
+	(BoolValue #f))
+
 ; --------------------------------------------------------
 ; The End! That's All, Folks!
@@ -179,5 +179,22 @@
 ; The writer just invokes this second form in an infinite loop,
 ; until the end-of-file is reached, and then it halts.
 
+; --------------------------------------------------------
+; Compressed files. A file that starts with the gzip or zstd magic
+; number is decompressed as it is read; text written to it is
+; compressed. A new, empty file is compressed if its name ends in
+; .gz or .zst. Each open/close session appends a new gzip member
+; (or zstd frame); `zcat` reads these back as one file. The
+; *-barrier-* message flushes what has been written so far.
+
+(PipeLink (NameNode "gzip file") (TextFile "file:///tmp/demo-out.txt.gz"))
+(Trigger
+	(SetValue (NameNode "gzip file") (Predicate "*-open-*")
+		(Type 'StringValue)))
+(Trigger
+	(SetValue (NameNode "gzip file") (Predicate "*-write-*")
+		(Item "Squeeze me tight\n")))
+(Trigger (SetValue (NameNode "gzip file") (Predicate "*-close-*") (VoidValue)))
+
 ; --------------------------------------------------------
 ; The End! That's All, Folks!
@@ -75,6 +75,66 @@
 	(List (Item "cd") (Item "file:///home"))))
 (Trigger (Put (DefinedSchema "run filesys command") (Item "ls")))
 
+; --------------------------------------------------------
+; Agents tend to list the same directories over and over. Listings
+; and stat results can be cached; the cache watches each directory
+; that was listed, and drops entries as soon as anything changes.
+; Caching is off by default, as each watched directory uses up an
+; inotify watch, and these are a limited system resource.
+
+(Trigger
+	(SetValue (NameNode "fsnode") (Predicate "*-cache-*") (BoolValue #t)))
+
+(Trigger (Put (DefinedSchema "run filesys command") (Item "filesize")))
+(Trigger (Put (DefinedSchema "run filesys command") (Item "filesize")))
+
+; --------------------------------------------------------
+; The `walk` command lists everything below the current directory,
+; recursively. Large trees can hold millions of files, so the results
+; are not returned in one blob. Instead, they are streamed, in batches
+; of a few hundred file URLs at a time, as they are found. Each batch
+; starts with the command, just like the `ls` result does. A batch
+; holding nothing but the command marks the end of the walk. Symlinks
+; are followed, but each directory is visited only once, so symlink
+; loops are harmless.
+
+(Trigger (SetValue (NameNode "fsnode") (Predicate "*-write-*")
+	(List (Item "walk") (Item "file:///usr/share/doc"))))
+
+; Repeat until a batch with only the command comes back.
+(Trigger (ValueOf (NameNode "fsnode") (Predicate "*-read-*")))
+(Trigger (ValueOf (NameNode "fsnode") (Predicate "*-read-*")))
+
+; --------------------------------------------------------
+; Files can be fingerprinted, to find duplicates, or to notice that
+; a file has changed. The fingerprint is a fast 64-bit hash; it is
+; not cryptographically secure. Fingerprints are remembered, and are
+; recomputed only if the file size or modification time changes.
+; Without an argument, every file in the current directory is done;
+; given a directory, every file in the whole tree is done, streamed
+; in batches, just like `walk`.
+
+(Trigger (Put (DefinedSchema "run filesys command") (Item "fingerprint")))
+(Trigger (Put (DefinedSchema "run filesys command")
+	(List (Item "fingerprint") (Item "file:///etc/passwd"))))
+
+; --------------------------------------------------------
+; The contents of all files in a tree can be searched, much like
+; `grep -r`. The `search` command looks for a literal string; the
+; `search-regex` command takes a POSIX extended regular expression.
+; An optional third argument gives the top of the tree to search;
+; the default is the current directory. Matches are streamed, in
+; batches, like `walk`; each match is a (url, line-number, line)
+; triple. Binary files are skipped.
+
+(Trigger (SetValue (NameNode "fsnode") (Predicate "*-write-*")
+	(List (Item "search") (Item "Copyright") (Item "file:///usr/share/doc"))))
+(Trigger (ValueOf (NameNode "fsnode") (Predicate "*-read-*")))
+
+(Trigger (SetValue (NameNode "fsnode") (Predicate "*-write-*")
+	(List (Item "search-regex") (Item "^root:") (Item "file:///etc"))))
+(Trigger (ValueOf (NameNode "fsnode") (Predicate "*-read-*")))
+
 ; --------------------------------------------------------
 ; Directories can also be watched for file additions, removals and
 ; changes. This interfaces works a bit differently than the above:
@@ -119,5 +179,22 @@
 ; If not, you will hard-hang.
 (Trigger (StreamValueOf (NameNode "watchnode") (Predicate "*-stream-*")))
 
+; --------------------------------------------------------
+; Results wait in a queue until they are read. If the reader falls
+; behind, that queue can grow without bound. The *-spill-* message
+; caps it: past so many bytes in memory, results are written to disk,
+; and read back, in order, as the reader catches up. Nothing is lost.
+; It applies from the next *-open-*; the monitor shows how much is in
+; memory, and how much on disk. (Watching uses a set, not a queue,
+; and is not capped.)
+
+(cog-set-value! (NameNode "fsnode") (Predicate "*-spill-*")
+	(List (Number 1000000) (Item "/tmp")))
+(Trigger
+	(SetValue (NameNode "fsnode") (Predicate "*-open-*") (Type 'StringValue)))
+(Trigger
+	(SetValue (NameNode "fsnode") (Predicate "*-write-*") (Item "ls")))
+(Trigger (ValueOf (NameNode "fsnode") (Predicate "*-monitor-*")))
+
 ; --------------------------------------------------------
 ; The End! That's All, Folks!
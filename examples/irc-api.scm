@@ -107,6 +107,27 @@
 
 ; HELP is one of the IRC server commands.
 
+; --------------------------------------------------------
+; Chat lines wait in a queue until read; if the process dies, they
+; are gone, and IRC won't send them again. With a write-ahead log,
+; each line is on disk before it is queued. Set the log before the
+; open; it is used from then on. The directory is made if need be.
+(Trigger (SetValue (NameNode "IRC chat object") (Predicate "*-wal-*")
+	(Item "/tmp/irc-log")))
+
+; After dealing with what was read, acknowledge it. VoidValue means
+; "everything read so far"; a Number names an offset.
+(Trigger (SetValue (NameNode "IRC chat object") (Predicate "*-ack-*")
+	(VoidValue)))
+
+; The last offset read, the last acknowledged, and the next one.
+(Trigger (ValueOf (NameNode "IRC chat object") (Predicate "*-offset-*")))
+
+; After a restart, set the log and open, as above; then replay, to
+; read again whatever was not acknowledged, before anything new.
+(Trigger (SetValue (NameNode "IRC chat object") (Predicate "*-replay-*")
+	(VoidValue)))
+
 ; --------------------------------------------------------
 ; Close the connection, and exit.
 (Trigger
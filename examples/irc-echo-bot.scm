@@ -423,6 +423,18 @@
 ; Run the logger in it's own thread.
 (Trigger (ExecuteThreaded (DefinedSchema "Stream logger")))
 
+; Note that the logger, and the echoer below, both read *-stream-*,
+; and that reading it takes the message away: each of them sees only
+; some of the messages. To have both see all of them, give each one a
+; reader of its own, from *-tee-*, kept somewhere it can be found:
+;
+;;; (cog-set-value! (Anchor "IRC readers") (Predicate "logger")
+;;;	(cog-value (Name "IRC chat object") (Predicate "*-tee-*")))
+;
+; and then use (ValueOf (Anchor "IRC readers") (Predicate "logger"))
+; in place of the *-stream-* above. Each reader made this way gets
+; every message, from when it was made on.
+
 ; The logging will stop, and the thread will exit if the file is closed.
 ;
 ;;; (Trigger
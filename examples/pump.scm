@@ -0,0 +1,100 @@
+;
+; pump.scm -- copying from one node to another with a PumpLink.
+;
+; The `xterm-bridge.scm` demo copies text with a tail-recursive
+; Atomese loop: each line costs an evaluation of the copy-one schema,
+; plus a *-read-* and a *-write-* message. A PumpLink runs the same
+; loop in C++, calling the reader and writer directly.
+;
+; This demo copies a big file three ways, and prints how long each
+; one took: with the tail-call loop, with a PumpLink, and with a
+; PumpLink that flushes the output every 1000 lines.
+
+(use-modules (opencog) (opencog sensory))
+
+; --------------------------------------------------------
+; Make a file to copy.
+
+(define nlines 100000)
+(define in-file "/tmp/pump-in.txt")
+(define out-file "/tmp/pump-out.txt")
+
+(with-output-to-file in-file
+	(lambda ()
+		(do ((i 0 (+ i 1))) ((= i nlines))
+			(format #t "This is line number ~a of the pump demo.\n" i))))
+
+(PipeLink (NameNode "pump in") (TextFile (string-append "file://" in-file)))
+(PipeLink (NameNode "pump out") (TextFile (string-append "file://" out-file)))
+
+; Open both; start over with an empty output file.
+(define (open-both)
+	(if (file-exists? out-file) (delete-file out-file))
+	(Trigger (SetValue (NameNode "pump in") (Predicate "*-open-*")
+		(Type 'StringValue)))
+	(Trigger (SetValue (NameNode "pump out") (Predicate "*-open-*")
+		(Type 'StringValue))))
+
+(define (close-both)
+	(Trigger (SetValue (NameNode "pump in") (Predicate "*-close-*")))
+	(Trigger (SetValue (NameNode "pump out") (Predicate "*-close-*"))))
+
+(define (time-it name thunk)
+	(open-both)
+	(let ((start (get-internal-real-time)))
+		(thunk)
+		(let* ((secs (/ (- (get-internal-real-time) start)
+		                internal-time-units-per-second 1.0)))
+			(close-both)
+			(format #t "~a: ~,3f seconds, ~,0f lines per second\n"
+				name secs (/ nlines secs)))))
+
+; --------------------------------------------------------
+; The tail-call loop, as in `xterm-bridge.scm`. It stops at the end of
+; the input file, when the VoidValue that is read cannot be written.
+
+(Define
+	(DefinedSchema "copy one line")
+	(SetValue (NameNode "pump out") (Predicate "*-write-*")
+		(ValueOf (NameNode "pump in") (Predicate "*-read-*"))))
+
+(Define
+	(DefinedProcedure "copy tail")
+	(PureExec (cog-atomspace)
+		(DefinedSchema "copy one line")
+		(DefinedProcedure "copy tail")))
+
+(time-it "Atomese tail-call"
+	(lambda ()
+		(catch #t
+			(lambda () (Trigger (DefinedProcedure "copy tail")))
+			(lambda args #f))))
+
+; --------------------------------------------------------
+; The same copy, with PumpLinks. Executing one returns the number of
+; lines copied.
+
+(time-it "PumpLink"
+	(lambda ()
+		(Trigger (Pump (NameNode "pump in") (NameNode "pump out")))))
+
+(time-it "PumpLink, batch of 1000"
+	(lambda ()
+		(Trigger (Pump (NameNode "pump in") (NameNode "pump out")
+			(Number 1000)))))
+
+; Check the copy: `cmp /tmp/pump-in.txt /tmp/pump-out.txt`
+
+; --------------------------------------------------------
+; A PumpThreadedLink does the same, in a thread of its own, and
+; returns right away. Executing it again tells how far it has got.
+
+(open-both)
+(define bg-pump (PumpThreaded (NameNode "pump in") (NameNode "pump out")))
+(Trigger bg-pump)
+(sleep 1)
+(Trigger bg-pump)
+(close-both)
+
+; --------------------------------------------------------
+; The End! That's All, Folks!
@@ -0,0 +1,58 @@
+#! /usr/bin/env python3
+#
+# python-api.py -- Driving the sensory nodes from python.
+#
+# The Stream class sends the same messages as the Atomese SetValue
+# and ValueOf do, but without building Atomese to do it. Bulk reads
+# bring in many items per python call, and embeddings come back as
+# buffers that numpy can use in place.
+#
+# Prerequisites, for the second half:
+#   ollama serve
+#   ollama pull nomic-embed-text
+
+import numpy
+
+from opencog.atomspace import AtomSpace
+from opencog.type_constructors import *
+from opencog.utilities import set_default_atomspace
+from opencog.sensory import *
+
+set_default_atomspace(AtomSpace())
+
+# --------------------------------------------------------
+# Read a file, a thousand lines at a time.
+
+demo = Stream(TextFileNode("file:///tmp/demo.txt"))
+demo.open(TypeNode("StringValue"))
+
+nlines = 0
+while not demo.eof:
+    nlines += len(demo.read_strings(1000))
+print("Read", nlines, "lines")
+demo.close()
+
+# Write a few lines to a new file.
+out = Stream(TextFileNode("file:///tmp/python-out.txt"))
+out.open(TypeNode("StringValue"))
+out.write("Hello from python")
+out.write(StringValue(["two", "strings"]))
+print(out.monitor())
+out.close()
+
+# --------------------------------------------------------
+# Embeddings from Ollama; numpy.asarray() shares the memory of the
+# Float32Value, rather than copying it.
+
+ollama = Stream(OllamaNode("python-embedder"))
+ollama.open(ItemNode("ollama://localhost:11434/nomic-embed-text"))
+
+vec = numpy.asarray(ollama.embed("The quick brown fox"))
+print("Embedding:", vec.dtype, vec.shape, vec[:4])
+
+other = numpy.asarray(ollama.embed("A lazy dog"))
+print("Cosine:", vec.dot(other) / numpy.linalg.norm(vec) / numpy.linalg.norm(other))
+ollama.close()
+
+# --------------------------------------------------------
+# The End! That's All, Folks!
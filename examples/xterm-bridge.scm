@@ -171,5 +171,16 @@
 
 ; That's it. Text typed into either terminal is sent to the other.
 
+; --------------------------------------------------------
+; Option 4) Let a PumpLink run the loop, in C++. This does the same as
+; the copy-one tail-calls of Option 2), but without evaluating any
+; Atomese for each line. A PumpThreadedLink runs in a thread of its
+; own, and returns right away. It ends when either terminal is closed.
+
+(Trigger (PumpThreaded (NameNode "bxterm") (NameNode "axterm")))
+(Trigger (PumpThreaded (NameNode "axterm") (NameNode "bxterm")))
+
+; See `pump.scm` for how much faster this is.
+
 ; --------------------------------------------------------
 ; The End! That's All, Folks!
@@ -0,0 +1,411 @@
+/*
+ * opencog/atoms/filedir/Compression.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <functional>
+
+#include <opencog/util/exceptions.h>
+
+#include "Compression.h"
+
+using namespace opencog;
+
+// Size of the read and write buffers.
+#define ZBUFSZ (128 * 1024)
+
+static bool ends_with(const std::string& s, const char* sfx)
+{
+	size_t n = strlen(sfx);
+	return n <= s.size() and 0 == s.compare(s.size() - n, n, sfx);
+}
+
+Codec opencog::detect_codec(int fd, const std::string& path)
+{
+	unsigned char magic[4];
+	ssize_t got = pread(fd, magic, sizeof(magic), 0);
+
+	if (2 <= got and 0x1f == magic[0] and 0x8b == magic[1])
+		return Codec::GZIP;
+	if (4 <= got and 0x28 == magic[0] and 0xb5 == magic[1] and
+	    0x2f == magic[2] and 0xfd == magic[3])
+		return Codec::ZSTD;
+
+	if (0 == got)
+	{
+		if (ends_with(path, ".gz")) return Codec::GZIP;
+		if (ends_with(path, ".zst")) return Codec::ZSTD;
+	}
+	return Codec::NONE;
+}
+
+bool opencog::codec_supported(Codec codec)
+{
+	switch (codec)
+	{
+		case Codec::NONE: return true;
+#ifdef HAVE_ZLIB
+		case Codec::GZIP: return true;
+#endif
+#ifdef HAVE_ZSTD
+		case Codec::ZSTD: return true;
+#endif
+		default: return false;
+	}
+}
+
+const char* opencog::codec_name(Codec codec)
+{
+	switch (codec)
+	{
+		case Codec::GZIP: return "gzip";
+		case Codec::ZSTD: return "zstd";
+		default: return "none";
+	}
+}
+
+// Read more compressed input. Returns the number of bytes read, zero
+// at EOF, and -1 on error.
+ssize_t Decompressor::fill(char* buf, size_t len)
+{
+	while (true)
+	{
+		ssize_t got = pread(_infd, buf, len, _inoff);
+		if (0 < got) _inoff += got;
+		if (0 <= got or EINTR != errno) return got;
+	}
+}
+
+// ==============================================================
+
+Decompressor::Decompressor(int fd, Codec codec, FILE** read_end) :
+	_infd(fd),
+	_inoff(0),
+	_outfd(-1),
+	_codec(codec),
+	_stop(false)
+{
+	// A socket, and not a pipe, so that writes to a closed read end
+	// fail with EPIPE, instead of raising SIGPIPE.
+	int sv[2];
+	if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv))
+	{
+		int norr = errno;
+		throw RuntimeException(TRACE_INFO,
+			"Unable to create socket pair: %s", strerror(norr));
+	}
+
+	*read_end = fdopen(sv[0], "r");
+	_outfd = sv[1];
+	_thread = std::thread(&Decompressor::run, this);
+}
+
+Decompressor::~Decompressor()
+{
+	_stop = true;
+	shutdown(_outfd, SHUT_RDWR);
+	if (_thread.joinable()) _thread.join();
+	::close(_outfd);
+}
+
+std::string Decompressor::error(void)
+{
+	// The thread closes its end only when it is done; so, if the
+	// reader has seen EOF, the thread is done, or nearly so.
+	if (_thread.joinable()) _thread.join();
+	return _error;
+}
+
+// Write it all, or fail if the reader went away.
+bool Decompressor::put(const char* buf, size_t len)
+{
+	while (0 < len)
+	{
+		if (_stop) return false;
+		ssize_t n = send(_outfd, buf, len, MSG_NOSIGNAL);
+		if (n < 0 and EINTR == errno) continue;
+		if (n <= 0) return false;
+		buf += n;
+		len -= n;
+	}
+	return true;
+}
+
+void Decompressor::run(void)
+{
+	if (Codec::GZIP == _codec) run_gzip();
+	else if (Codec::ZSTD == _codec) run_zstd();
+
+	// Let the reader see EOF.
+	shutdown(_outfd, SHUT_WR);
+}
+
+void Decompressor::run_gzip(void)
+{
+#ifdef HAVE_ZLIB
+	std::vector<char> in(ZBUFSZ);
+	std::vector<char> out(ZBUFSZ);
+
+	z_stream zs;
+	memset(&zs, 0, sizeof(zs));
+
+	// 16 + MAX_WBITS asks for the gzip header and trailer.
+	if (Z_OK != inflateInit2(&zs, 16 + MAX_WBITS))
+	{
+		_error = "cannot initialize zlib";
+		return;
+	}
+
+	bool member_done = false;
+	while (true)
+	{
+		if (0 == zs.avail_in)
+		{
+			ssize_t got = fill(in.data(), in.size());
+			if (got < 0) { _error = strerror(errno); break; }
+			// An empty file is fine; a partial member is not.
+			if (0 == got)
+			{
+				if (not member_done and 0 < zs.total_in)
+					_error = "truncated gzip data";
+				break;
+			}
+			zs.next_in = (Bytef*) in.data();
+			zs.avail_in = got;
+		}
+
+		// Another member follows the one just finished.
+		if (member_done)
+		{
+			inflateReset(&zs);
+			member_done = false;
+		}
+
+		zs.next_out = (Bytef*) out.data();
+		zs.avail_out = out.size();
+		int rc = inflate(&zs, Z_NO_FLUSH);
+		if (Z_STREAM_END == rc)
+			member_done = true;
+		else if (Z_OK != rc and Z_BUF_ERROR != rc)
+		{
+			_error = zs.msg ? zs.msg : "corrupt gzip data";
+			break;
+		}
+
+		if (not put(out.data(), out.size() - zs.avail_out)) break;
+	}
+	inflateEnd(&zs);
+#endif
+}
+
+void Decompressor::run_zstd(void)
+{
+#ifdef HAVE_ZSTD
+	std::vector<char> in(ZSTD_DStreamInSize());
+	std::vector<char> out(ZSTD_DStreamOutSize());
+
+	ZSTD_DCtx* dctx = ZSTD_createDCtx();
+	if (nullptr == dctx)
+	{
+		_error = "cannot initialize zstd";
+		return;
+	}
+
+	// Non-zero while in the middle of a frame.
+	size_t pending = 0;
+	while (true)
+	{
+		ssize_t got = fill(in.data(), in.size());
+		if (got < 0) { _error = strerror(errno); break; }
+		if (0 == got)
+		{
+			if (0 != pending) _error = "truncated zstd data";
+			break;
+		}
+
+		ZSTD_inBuffer zin = { in.data(), (size_t) got, 0 };
+		bool ok = true;
+		while (ok and zin.pos < zin.size)
+		{
+			ZSTD_outBuffer zout = { out.data(), out.size(), 0 };
+			pending = ZSTD_decompressStream(dctx, &zout, &zin);
+			if (ZSTD_isError(pending))
+			{
+				_error = ZSTD_getErrorName(pending);
+				ok = false;
+				break;
+			}
+			ok = put(out.data(), zout.pos);
+		}
+		if (not ok) break;
+	}
+	ZSTD_freeDCtx(dctx);
+#endif
+}
+
+// ==============================================================
+
+Compressor::Compressor(int fd, Codec codec) :
+	_fd(fd),
+	_codec(codec),
+	_stream(nullptr),
+	_buf(ZBUFSZ)
+{
+#ifdef HAVE_ZLIB
+	if (Codec::GZIP == _codec)
+	{
+		z_stream* zs = new z_stream;
+		memset(zs, 0, sizeof(z_stream));
+
+		// 16 + MAX_WBITS asks for a gzip header and trailer.
+		if (Z_OK != deflateInit2(zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+		                         16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY))
+		{
+			delete zs;
+			throw RuntimeException(TRACE_INFO, "Cannot initialize zlib");
+		}
+		_stream = zs;
+	}
+#endif
+#ifdef HAVE_ZSTD
+	if (Codec::ZSTD == _codec)
+	{
+		_stream = ZSTD_createCCtx();
+		if (nullptr == _stream)
+			throw RuntimeException(TRACE_INFO, "Cannot initialize zstd");
+	}
+#endif
+	if (nullptr == _stream)
+		throw RuntimeException(TRACE_INFO,
+			"Compiled without %s support", codec_name(_codec));
+}
+
+void Compressor::put(const char* buf, size_t len)
+{
+	while (0 < len)
+	{
+		ssize_t n = ::write(_fd, buf, len);
+		if (n < 0 and EINTR == errno) continue;
+		if (n < 0)
+		{
+			int norr = errno;
+			throw RuntimeException(TRACE_INFO,
+				"Unable to write compressed file: %s", strerror(norr));
+		}
+		buf += n;
+		len -= n;
+	}
+}
+
+// Mode is zero for plain writes, one for flush, two for finish.
+#define Z_MODE_WRITE 0
+#define Z_MODE_FLUSH 1
+#define Z_MODE_FINISH 2
+
+static void run_codec(Codec codec, void* stream, const char* in,
+                      size_t len, int mode, std::vector<char>& buf,
+                      const std::function<void(const char*, size_t)>& put)
+{
+#ifdef HAVE_ZLIB
+	if (Codec::GZIP == codec)
+	{
+		z_stream* zs = (z_stream*) stream;
+		zs->next_in = (Bytef*) in;
+		zs->avail_in = len;
+		int flush = (Z_MODE_WRITE == mode) ? Z_NO_FLUSH :
+			(Z_MODE_FLUSH == mode) ? Z_SYNC_FLUSH : Z_FINISH;
+		do
+		{
+			zs->next_out = (Bytef*) buf.data();
+			zs->avail_out = buf.size();
+			deflate(zs, flush);
+			put(buf.data(), buf.size() - zs->avail_out);
+		}
+		while (0 == zs->avail_out or 0 < zs->avail_in);
+		return;
+	}
+#endif
+#ifdef HAVE_ZSTD
+	if (Codec::ZSTD == codec)
+	{
+		ZSTD_CCtx* cctx = (ZSTD_CCtx*) stream;
+		ZSTD_inBuffer zin = { in, len, 0 };
+		ZSTD_EndDirective end = (Z_MODE_WRITE == mode) ? ZSTD_e_continue :
+			(Z_MODE_FLUSH == mode) ? ZSTD_e_flush : ZSTD_e_end;
+		size_t remaining;
+		do
+		{
+			ZSTD_outBuffer zout = { buf.data(), buf.size(), 0 };
+			remaining = ZSTD_compressStream2(cctx, &zout, &zin, end);
+			if (ZSTD_isError(remaining))
+				throw RuntimeException(TRACE_INFO,
+					"zstd: %s", ZSTD_getErrorName(remaining));
+			put(buf.data(), zout.pos);
+		}
+		while (zin.pos < zin.size or
+		       (ZSTD_e_continue != end and 0 != remaining));
+		return;
+	}
+#endif
+}
+
+void Compressor::write(const std::string& str)
+{
+	run_codec(_codec, _stream, str.data(), str.size(), Z_MODE_WRITE, _buf,
+		[this](const char* b, size_t n) { put(b, n); });
+}
+
+void Compressor::flush(void)
+{
+	run_codec(_codec, _stream, nullptr, 0, Z_MODE_FLUSH, _buf,
+		[this](const char* b, size_t n) { put(b, n); });
+}
+
+Compressor::~Compressor()
+{
+	// Complete the member or frame. Nowhere to report errors to.
+	try
+	{
+		run_codec(_codec, _stream, nullptr, 0, Z_MODE_FINISH, _buf,
+			[this](const char* b, size_t n) { put(b, n); });
+	}
+	catch (...) {}
+
+#ifdef HAVE_ZLIB
+	if (Codec::GZIP == _codec)
+	{
+		deflateEnd((z_stream*) _stream);
+		delete (z_stream*) _stream;
+	}
+#endif
+#ifdef HAVE_ZSTD
+	if (Codec::ZSTD == _codec)
+		ZSTD_freeCCtx((ZSTD_CCtx*) _stream);
+#endif
+}
+
+// ====================================================================
@@ -0,0 +1,136 @@
+/*
+ * opencog/atoms/filedir/Compression.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_COMPRESSION_H
+#define _OPENCOG_COMPRESSION_H
+
+#include <stdio.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+enum class Codec
+{
+	NONE,
+	GZIP,
+	ZSTD
+};
+
+/**
+ * Figure out if the file open on `fd` is compressed, by looking at
+ * its magic number. An empty file is judged by the file name
+ * extension (.gz or .zst) instead, so that writes to a new file get
+ * compressed.
+ */
+Codec detect_codec(int fd, const std::string& path);
+
+/// True if support for the codec was compiled in.
+bool codec_supported(Codec);
+
+/// Name of the codec, for error messages.
+const char* codec_name(Codec);
+
+/**
+ * Decompressor - Decompress a file, on a thread of its own.
+ *
+ * The decompressed text is written into one end of a socket pair;
+ * the other end is handed out as a FILE*, from which lines can be
+ * read with fgets(), as if it were the uncompressed file. Thus,
+ * decompression overlaps with whatever is done with the lines.
+ *
+ * Concatenated gzip members, and concatenated zstd frames, are read
+ * one after the other, as `zcat` does.
+ */
+class Decompressor
+{
+private:
+	int _infd;
+	off_t _inoff;
+	int _outfd;
+	Codec _codec;
+	std::thread _thread;
+	std::atomic<bool> _stop;
+	std::string _error;
+
+	ssize_t fill(char*, size_t);
+	bool put(const char*, size_t);
+	void run(void);
+	void run_gzip(void);
+	void run_zstd(void);
+
+public:
+	/// Start decompressing the file open on `fd`, from the start.
+	/// The fd must stay open until the Decompressor is destroyed.
+	/// The caller must fclose() the returned read end.
+	/// @throws RuntimeException if the socket pair cannot be made.
+	Decompressor(int fd, Codec, FILE** read_end);
+	~Decompressor();
+
+	// Prevent copying
+	Decompressor(const Decompressor&) = delete;
+	Decompressor& operator=(const Decompressor&) = delete;
+
+	/// Empty, unless the compressed data was corrupt or unreadable.
+	/// Valid only after the read end has hit EOF.
+	std::string error(void);
+};
+
+/**
+ * Compressor - Append compressed text to a file.
+ *
+ * Text is compressed into a new gzip member, or zstd frame, at the
+ * end of the file; these can be concatenated freely. A flush() makes
+ * everything written so far decodable, at a small cost in size. The
+ * member or frame is completed when the Compressor is destroyed.
+ */
+class Compressor
+{
+private:
+	int _fd;
+	Codec _codec;
+	void* _stream;
+	std::vector<char> _buf;
+
+	void put(const char*, size_t);
+
+public:
+	/// @throws RuntimeException on failure.
+	Compressor(int fd, Codec);
+	~Compressor();
+
+	// Prevent copying
+	Compressor(const Compressor&) = delete;
+	Compressor& operator=(const Compressor&) = delete;
+
+	/// @throws RuntimeException on write failure.
+	void write(const std::string&);
+	void flush(void);
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_COMPRESSION_H
@@ -0,0 +1,278 @@
+/*
+ * opencog/atoms/filedir/DirCache.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/inotify.h>
+
+#include <opencog/util/exceptions.h>
+
+#include "DirCache.h"
+
+using namespace opencog;
+
+DirCache::DirCache() :
+	_epoch(0),
+	_hits(0),
+	_misses(0),
+	_invalidations(0)
+{
+	_watcher.start_dispatch(
+		[this](uint32_t mask, const std::string& dir, const std::string& name)
+		{ on_event(mask, dir, name); });
+}
+
+DirCache::~DirCache()
+{
+	_watcher.stop_watching();
+}
+
+void DirCache::clear(void)
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	_dirs.clear();
+	_stats.clear();
+	_epoch++;
+}
+
+std::string DirCache::stats(void) const
+{
+	return "hits: " + std::to_string(_hits) +
+		" misses: " + std::to_string(_misses) +
+		" invalidations: " + std::to_string(_invalidations);
+}
+
+// ==============================================================
+// Invalidation.
+
+// Caller must hold the lock.
+void DirCache::drop_dir(const std::string& dir)
+{
+	_dirs.erase(dir);
+
+	// Stat results for everything that was in it.
+	std::string pfx = dir + "/";
+	for (auto it = _stats.begin(); it != _stats.end(); )
+	{
+		if (0 == it->first.compare(0, pfx.size(), pfx))
+			it = _stats.erase(it);
+		else
+			it++;
+	}
+}
+
+void DirCache::on_event(uint32_t mask, const std::string& dir,
+                        const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	_invalidations++;
+
+	// Events were lost; nothing can be trusted.
+	if (mask & IN_Q_OVERFLOW)
+	{
+		_dirs.clear();
+		_stats.clear();
+		_epoch++;
+		return;
+	}
+
+	_gen[dir]++;
+
+	// The directory itself went away.
+	if (mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+	{
+		drop_dir(dir);
+		return;
+	}
+
+	if (name.empty()) return;
+
+	std::string full = dir + "/" + name;
+	_stats.erase(full);
+
+	// Entries came or went; the listing is stale. If the entry
+	// was itself a directory, so is everything cached below it.
+	if (mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO))
+	{
+		_dirs.erase(dir);
+		drop_dir(full);
+	}
+}
+
+// ==============================================================
+// Lookup.
+
+#define STATX_MASK (STATX_BTIME | STATX_MTIME | STATX_SIZE)
+
+void DirCache::read_dir(const std::string& path, bool need_stat,
+                        std::vector<Entry>& ents)
+{
+	DIR* dir = opendir(path.c_str());
+	if (nullptr == dir)
+	{
+		int norr = errno;
+		throw RuntimeException(TRACE_INFO,
+			"Location %s inaccessible: %s",
+			path.c_str(), strerror(norr));
+	}
+	int fd = dirfd(dir);
+
+	struct dirent* dent = readdir(dir);
+	for (; dent; dent = readdir(dir))
+	{
+		if (0 == strcmp(dent->d_name, ".")) continue;
+		if (0 == strcmp(dent->d_name, "..")) continue;
+
+		Entry ent;
+		ent.name = dent->d_name;
+		ent.dtype = dent->d_type;
+		if (need_stat and
+		    statx(fd, dent->d_name, 0, STATX_MASK, &ent.stx))
+		{
+			int norr = errno;
+			closedir(dir);
+			throw RuntimeException(TRACE_INFO,
+				"Location %s/%s error: %s",
+				path.c_str(), ent.name.c_str(), strerror(norr));
+		}
+		ents.emplace_back(std::move(ent));
+	}
+	closedir(dir);
+}
+
+static bool same_time(const struct timespec& a, const struct timespec& b)
+{
+	return a.tv_sec == b.tv_sec and a.tv_nsec == b.tv_nsec;
+}
+
+std::shared_ptr<const DirCache::Listing>
+DirCache::get_listing(const std::string& path)
+{
+	std::shared_ptr<const Listing> lst;
+	uint64_t epoch, gen;
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		auto it = _dirs.find(path);
+		if (_dirs.end() != it)
+		{
+			if (it->second->watched)
+			{
+				_hits++;
+				return it->second;
+			}
+			lst = it->second;
+		}
+		epoch = _epoch;
+		gen = _gen[path];
+	}
+
+	// Not watched; check that the directory is unchanged.
+	struct stat sb;
+	bool have_mtime = (0 == stat(path.c_str(), &sb));
+	if (lst and have_mtime and same_time(lst->mtime, sb.st_mtim))
+	{
+		_hits++;
+		return lst;
+	}
+	_misses++;
+
+	// Add the watch before reading, so that any change made during
+	// the read bumps the generation count.
+	std::shared_ptr<Listing> fresh = std::make_shared<Listing>();
+	fresh->watched = _watcher.add_dir_watch(path);
+	read_dir(path, false, fresh->entries);
+
+	// A directory modified within the mtime granularity of the
+	// filesystem might be modified again without the mtime changing.
+	// Don't trust the mtime of a directory that changed just now.
+	bool cacheable = fresh->watched;
+	if (not cacheable and have_mtime)
+	{
+		fresh->mtime = sb.st_mtim;
+		cacheable = (sb.st_mtim.tv_sec + 1 < time(nullptr));
+	}
+
+	if (cacheable)
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		if (epoch == _epoch and gen == _gen[path])
+			_dirs[path] = fresh;
+	}
+	return fresh;
+}
+
+void DirCache::get_stats(const std::string& path, bool watched,
+                         std::vector<Entry>& ents)
+{
+	// Find what we already have.
+	std::vector<bool> missing(ents.size(), false);
+	uint64_t epoch, gen;
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		for (size_t i = 0; i < ents.size(); i++)
+		{
+			auto it = _stats.find(path + "/" + ents[i].name);
+			if (_stats.end() == it)
+				missing[i] = true;
+			else
+				ents[i].stx = it->second;
+		}
+		epoch = _epoch;
+		gen = _gen[path];
+	}
+
+	// Stat the rest, without holding the lock.
+	bool any = false;
+	for (size_t i = 0; i < ents.size(); i++)
+	{
+		if (not missing[i]) continue;
+		any = true;
+		std::string full = path + "/" + ents[i].name;
+		if (statx(AT_FDCWD, full.c_str(), 0, STATX_MASK, &ents[i].stx))
+		{
+			int norr = errno;
+			throw RuntimeException(TRACE_INFO,
+				"Location %s error: %s", full.c_str(), strerror(norr));
+		}
+	}
+
+	// Writing to a file does not change the mtime of the directory,
+	// so stat results can only be kept for watched directories.
+	if (not any or not watched) return;
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (epoch != _epoch or gen != _gen[path]) return;
+	for (size_t i = 0; i < ents.size(); i++)
+		if (missing[i])
+			_stats[path + "/" + ents[i].name] = ents[i].stx;
+}
+
+void DirCache::list(const std::string& path, bool need_stat,
+                    std::vector<Entry>& ents)
+{
+	// Changes made just now may not have been seen yet; the Executor
+	// gets to the inotify events when it gets to them.
+	_watcher.dispatch_pending();
+
+	std::shared_ptr<const Listing> lst = get_listing(path);
+	ents = lst->entries;
+	if (need_stat)
+		get_stats(path, lst->watched, ents);
+}
+
+// ====================================================================
@@ -0,0 +1,127 @@
+/*
+ * opencog/atoms/filedir/DirCache.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_DIR_CACHE_H
+#define _OPENCOG_DIR_CACHE_H
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FileWatcher.h"
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * DirCache - Cache of directory listings and stat() results.
+ *
+ * Listings are keyed by directory path; stat results are keyed by
+ * the full path of the file. Every directory that is listed gets an
+ * inotify watch, and any change reported for it drops the affected
+ * entries. Each lookup first takes in whatever events are waiting,
+ * so that it sees changes made just before it; in an unchanged
+ * directory, that is one poll(), and then a hash lookup.
+ *
+ * If a watch cannot be added (the inotify watch limit is low on
+ * some systems), the listing is still cached, but is validated by
+ * comparing the directory mtime on each lookup. Stat results for
+ * files in such directories are not cached, as writing to a file
+ * does not change the mtime of the directory holding it.
+ */
+class DirCache
+{
+public:
+	struct Entry
+	{
+		std::string name;
+		unsigned char dtype;    // DT_* from <dirent.h>
+		struct statx stx;       // Valid only if stat was asked for.
+	};
+
+private:
+	struct Listing
+	{
+		bool watched;
+		struct timespec mtime;
+		std::vector<Entry> entries;
+	};
+
+	std::mutex _mtx;
+	std::unordered_map<std::string, std::shared_ptr<const Listing>> _dirs;
+	std::unordered_map<std::string, struct statx> _stats;
+
+	// Bumped on every change to a directory; used to avoid caching
+	// a result that was read while the directory was changing.
+	std::unordered_map<std::string, uint64_t> _gen;
+	uint64_t _epoch;
+
+	std::atomic<size_t> _hits;
+	std::atomic<size_t> _misses;
+	std::atomic<size_t> _invalidations;
+
+	FileWatcher _watcher;
+	void on_event(uint32_t, const std::string&, const std::string&);
+	void drop_dir(const std::string&);
+
+	std::shared_ptr<const Listing> get_listing(const std::string&);
+	void get_stats(const std::string&, bool, std::vector<Entry>&);
+
+public:
+	DirCache();
+	~DirCache();
+
+	// Prevent copying
+	DirCache(const DirCache&) = delete;
+	DirCache& operator=(const DirCache&) = delete;
+
+	/**
+	 * Get the entries of the directory at `path`, without "." and
+	 * "..". If `need_stat` is set, the `stx` field of each entry
+	 * holds the size, mtime and btime (following symlinks).
+	 *
+	 * @throws RuntimeException if the directory cannot be read, or
+	 *         an entry cannot be stat'ed.
+	 */
+	void list(const std::string& path, bool need_stat,
+	          std::vector<Entry>& ents);
+
+	/// Uncached version of the above.
+	static void read_dir(const std::string& path, bool need_stat,
+	                     std::vector<Entry>& ents);
+
+	/// Drop everything.
+	void clear(void);
+
+	/// Hit, miss and invalidation counts, for debugging.
+	std::string stats(void) const;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_DIR_CACHE_H
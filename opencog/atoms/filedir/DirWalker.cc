@@ -0,0 +1,237 @@
+/*
+ * opencog/atoms/filedir/DirWalker.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <thread>
+
+#include <opencog/util/exceptions.h>
+
+#include "DirWalker.h"
+
+using namespace opencog;
+
+// Directory reading is mostly waiting on the disk (or on the dentry
+// cache, if warm); more threads than this does not help.
+#define MAX_WALK_THREADS 16
+
+DirWalker::DirWalker(size_t nthreads) :
+	_pending(0),
+	_queued(0),
+	_cancel(false)
+{
+	if (0 == nthreads)
+		nthreads = std::thread::hardware_concurrency();
+	if (0 == nthreads) nthreads = 1;
+	if (MAX_WALK_THREADS < nthreads) nthreads = MAX_WALK_THREADS;
+
+	for (size_t i = 0; i < nthreads; i++)
+		_workers.emplace_back(std::make_unique<Worker>());
+}
+
+DirWalker::~DirWalker()
+{
+}
+
+void DirWalker::cancel(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(_idle_mtx);
+		_cancel = true;
+	}
+	_idle_cv.notify_all();
+}
+
+// ==============================================================
+
+bool DirWalker::first_visit(dev_t dev, ino_t ino)
+{
+	std::lock_guard<std::mutex> lock(_seen_mtx);
+	return _seen.insert({dev, ino}).second;
+}
+
+// Put a directory onto the deque of worker `w`.
+void DirWalker::push(size_t w, std::string&& dir)
+{
+	_pending++;
+	{
+		std::lock_guard<std::mutex> lock(_workers[w]->mtx);
+		_workers[w]->dirs.emplace_back(std::move(dir));
+	}
+
+	// Bump the count under the idle lock, so that a worker that is
+	// just about to go to sleep cannot miss the wakeup.
+	{
+		std::lock_guard<std::mutex> lock(_idle_mtx);
+		_queued++;
+	}
+	_idle_cv.notify_one();
+}
+
+// Get a directory to read: newest from our own deque, else the
+// oldest from someone else's. Oldest entries are closest to the
+// root, and so are likely to carry the most work with them.
+bool DirWalker::pop(size_t w, std::string& dir)
+{
+	{
+		Worker& own = *_workers[w];
+		std::lock_guard<std::mutex> lock(own.mtx);
+		if (not own.dirs.empty())
+		{
+			dir = std::move(own.dirs.back());
+			own.dirs.pop_back();
+			_queued--;
+			return true;
+		}
+	}
+
+	size_t nw = _workers.size();
+	for (size_t i = 1; i < nw; i++)
+	{
+		Worker& victim = *_workers[(w + i) % nw];
+		std::lock_guard<std::mutex> lock(victim.mtx);
+		if (not victim.dirs.empty())
+		{
+			dir = std::move(victim.dirs.front());
+			victim.dirs.pop_front();
+			_queued--;
+			return true;
+		}
+	}
+	return false;
+}
+
+// ==============================================================
+
+void DirWalker::read_dir(size_t w, const std::string& path,
+                         const Visitor& visit)
+{
+	DIR* dir = opendir(path.c_str());
+
+	// Unreadable subdirectories (permissions, or vanished since we
+	// saw them) are skipped, the same way that find(1) carries on.
+	if (nullptr == dir) return;
+	int fd = dirfd(dir);
+
+	struct dirent* dent = readdir(dir);
+	for (; dent and not _cancel; dent = readdir(dir))
+	{
+		if (0 == strcmp(dent->d_name, ".")) continue;
+		if (0 == strcmp(dent->d_name, "..")) continue;
+
+		unsigned char dtype = dent->d_type;
+		std::string full = path + "/" + dent->d_name;
+
+		// Links must be resolved, and directories must be stat'ed
+		// anyway, to get the (dev, inode) pair for loop detection.
+		struct stat sb;
+		bool descend = false;
+		if (DT_DIR == dtype or DT_LNK == dtype or DT_UNKNOWN == dtype)
+		{
+			if (0 == fstatat(fd, dent->d_name, &sb, 0))
+			{
+				if (S_ISDIR(sb.st_mode)) dtype = DT_DIR;
+				else if (S_ISREG(sb.st_mode)) dtype = DT_REG;
+				else if (S_ISLNK(sb.st_mode)) dtype = DT_LNK;
+				else if (S_ISFIFO(sb.st_mode)) dtype = DT_FIFO;
+				else if (S_ISSOCK(sb.st_mode)) dtype = DT_SOCK;
+				else if (S_ISCHR(sb.st_mode)) dtype = DT_CHR;
+				else if (S_ISBLK(sb.st_mode)) dtype = DT_BLK;
+
+				if (DT_DIR == dtype)
+					descend = first_visit(sb.st_dev, sb.st_ino);
+			}
+			else
+				dtype = DT_LNK;
+		}
+
+		visit(w, full, dtype);
+		if (descend)
+			push(w, std::move(full));
+	}
+	closedir(dir);
+}
+
+void DirWalker::run(size_t w, const Visitor& visit)
+{
+	std::string dir;
+	while (not _cancel)
+	{
+		if (pop(w, dir))
+		{
+			read_dir(w, dir, visit);
+
+			bool done;
+			{
+				std::lock_guard<std::mutex> lock(_idle_mtx);
+				done = (0 == --_pending);
+			}
+			if (done) _idle_cv.notify_all();
+			continue;
+		}
+
+		// Nothing to steal. Sleep until there is, or until the
+		// last directory anywhere has been read.
+		std::unique_lock<std::mutex> lock(_idle_mtx);
+		_idle_cv.wait(lock, [&]() {
+			return _cancel or 0 < _queued or 0 == _pending; });
+		if (0 == _pending) return;
+	}
+}
+
+// ==============================================================
+
+void DirWalker::walk(const std::string& root, const Visitor& visit)
+{
+	struct stat sb;
+	if (0 != stat(root.c_str(), &sb))
+	{
+		int norr = errno;
+		throw RuntimeException(TRACE_INFO,
+			"Location %s inaccessible: %s", root.c_str(), strerror(norr));
+	}
+	if (not S_ISDIR(sb.st_mode))
+		throw RuntimeException(TRACE_INFO,
+			"Location %s is not a directory", root.c_str());
+
+	_cancel = false;
+	_seen.clear();
+	first_visit(sb.st_dev, sb.st_ino);
+	push(0, std::string(root));
+
+	// The calling thread is worker zero.
+	std::vector<std::thread> helpers;
+	for (size_t i = 1; i < _workers.size(); i++)
+		helpers.emplace_back(&DirWalker::run, this, i, std::cref(visit));
+
+	run(0, visit);
+
+	for (std::thread& t : helpers)
+		t.join();
+
+	// After a cancel, there may be leftovers.
+	for (auto& wp : _workers)
+		wp->dirs.clear();
+	_pending = 0;
+	_queued = 0;
+}
+
+// ====================================================================
@@ -0,0 +1,133 @@
+/*
+ * opencog/atoms/filedir/DirWalker.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_DIR_WALKER_H
+#define _OPENCOG_DIR_WALKER_H
+
+#include <sys/types.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * DirWalker - Parallel recursive directory traversal.
+ *
+ * The walk is spread over a small pool of worker threads. Each worker
+ * owns a deque of directories waiting to be read. A worker takes work
+ * from the back of its own deque (depth-first, cache-friendly) and,
+ * when that runs dry, steals from the front of the other deques. New
+ * subdirectories go onto the deque of the worker that found them.
+ *
+ * Symbolic links are followed. Loops (and bind-mount cycles) are
+ * detected by remembering the (dev, inode) pair of every directory
+ * entered; a directory is descended into at most once.
+ *
+ * Usage pattern:
+ *   DirWalker walker;
+ *   walker.walk("/some/path",
+ *      [](size_t worker, const std::string& path, unsigned char dtype)
+ *      { ... });
+ *
+ * The visitor is called concurrently from all workers; the `worker`
+ * argument (0 .. nthreads()-1) lets callers keep per-worker state
+ * without locking. The `dtype` is one of the DT_* values from
+ * <dirent.h>, with symlinks resolved to the type of their target;
+ * dangling links are reported as DT_LNK.
+ */
+class DirWalker
+{
+public:
+	typedef std::function<void(size_t, const std::string&, unsigned char)>
+		Visitor;
+
+private:
+	struct Worker
+	{
+		std::mutex mtx;
+		std::deque<std::string> dirs;
+	};
+	std::vector<std::unique_ptr<Worker>> _workers;
+
+	// Directories queued or being read. The walk is over when
+	// this drops to zero.
+	std::atomic<size_t> _pending;
+
+	// Directories sitting in some deque, waiting to be read.
+	std::atomic<size_t> _queued;
+	std::atomic<bool> _cancel;
+
+	std::mutex _idle_mtx;
+	std::condition_variable _idle_cv;
+
+	// (dev, inode) of every directory entered so far.
+	std::mutex _seen_mtx;
+	std::set<std::pair<dev_t, ino_t>> _seen;
+
+	bool first_visit(dev_t, ino_t);
+	void push(size_t, std::string&&);
+	bool pop(size_t, std::string&);
+	void read_dir(size_t, const std::string&, const Visitor&);
+	void run(size_t, const Visitor&);
+
+public:
+	/**
+	 * @param nthreads Number of worker threads; zero means pick a
+	 *                 default based on the number of CPUs.
+	 */
+	DirWalker(size_t nthreads = 0);
+	~DirWalker();
+
+	// Prevent copying
+	DirWalker(const DirWalker&) = delete;
+	DirWalker& operator=(const DirWalker&) = delete;
+
+	size_t nthreads(void) const { return _workers.size(); }
+
+	/**
+	 * Walk the tree rooted at `root`, calling `visit` for every entry
+	 * found below it (the root itself is not reported). Blocks until
+	 * the walk completes or is cancelled.
+	 *
+	 * @throws RuntimeException if the root is not an accessible directory
+	 */
+	void walk(const std::string& root, const Visitor& visit);
+
+	/**
+	 * Abandon a walk in progress. May be called from any thread,
+	 * including from within the visitor.
+	 */
+	void cancel(void);
+	bool cancelled(void) const { return _cancel; }
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_DIR_WALKER_H
@@ -0,0 +1,317 @@
+/*
+ * opencog/atoms/filedir/FileHasher.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <opencog/util/exceptions.h>
+
+#include "FileHasher.h"
+
+using namespace opencog;
+
+// Files are hashed in chunks of this size. Must be a multiple of the
+// page size, so that chunks can be mmapped. Changing this changes the
+// fingerprint of every file larger than one chunk!
+#define HASH_CHUNK (4UL * 1024 * 1024)
+
+// Upper bound on remembered fingerprints; about 64 bytes each.
+#define MAX_CACHED (1UL << 20)
+
+#define MAX_HASH_THREADS 16
+
+FileHasher::FileHasher(size_t nthreads) :
+	_nthreads(nthreads)
+{
+	if (0 == _nthreads)
+		_nthreads = std::thread::hardware_concurrency();
+	if (0 == _nthreads) _nthreads = 1;
+	if (MAX_HASH_THREADS < _nthreads) _nthreads = MAX_HASH_THREADS;
+}
+
+void FileHasher::clear(void)
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	_cache.clear();
+}
+
+std::string FileHasher::to_hex(uint64_t h)
+{
+	static const char* digits = "0123456789abcdef";
+	std::string hex(16, '0');
+	for (int i = 15; 0 <= i; i--)
+	{
+		hex[i] = digits[h & 0xf];
+		h >>= 4;
+	}
+	return hex;
+}
+
+// ==============================================================
+// XXH64, as specified in
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+//
+// The main loop runs four independent accumulators, which keeps
+// several 64-bit multiplies in flight at once. XXH64 does not gain
+// much from explicit vector code, as SSE2/AVX2 lack a 64-bit multiply.
+
+static constexpr uint64_t P1 = 11400714785074694791ULL;
+static constexpr uint64_t P2 = 14029467366897019727ULL;
+static constexpr uint64_t P3 =  1609587929392839161ULL;
+static constexpr uint64_t P4 =  9650029242287828579ULL;
+static constexpr uint64_t P5 =  2870177450012600261ULL;
+
+static inline uint64_t rotl(uint64_t x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t read64(const uint8_t* p)
+{
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	return v;
+}
+
+static inline uint32_t read32(const uint8_t* p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap32(v);
+#endif
+	return v;
+}
+
+static inline uint64_t xround(uint64_t acc, uint64_t input)
+{
+	acc += input * P2;
+	acc = rotl(acc, 31);
+	return acc * P1;
+}
+
+static inline uint64_t xmerge(uint64_t acc, uint64_t val)
+{
+	acc ^= xround(0, val);
+	return acc * P1 + P4;
+}
+
+uint64_t FileHasher::xxh64(const void* buf, size_t len, uint64_t seed)
+{
+	const uint8_t* p = (const uint8_t*) buf;
+	const uint8_t* end = p + len;
+	uint64_t h;
+
+	if (32 <= len)
+	{
+		uint64_t v1 = seed + P1 + P2;
+		uint64_t v2 = seed + P2;
+		uint64_t v3 = seed;
+		uint64_t v4 = seed - P1;
+		const uint8_t* limit = end - 32;
+		do
+		{
+			v1 = xround(v1, read64(p));
+			v2 = xround(v2, read64(p + 8));
+			v3 = xround(v3, read64(p + 16));
+			v4 = xround(v4, read64(p + 24));
+			p += 32;
+		} while (p <= limit);
+
+		h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+		h = xmerge(h, v1);
+		h = xmerge(h, v2);
+		h = xmerge(h, v3);
+		h = xmerge(h, v4);
+	}
+	else
+		h = seed + P5;
+
+	h += (uint64_t) len;
+
+	for (; p + 8 <= end; p += 8)
+	{
+		h ^= xround(0, read64(p));
+		h = rotl(h, 27) * P1 + P4;
+	}
+	if (p + 4 <= end)
+	{
+		h ^= (uint64_t) read32(p) * P1;
+		h = rotl(h, 23) * P2 + P3;
+		p += 4;
+	}
+	for (; p < end; p++)
+	{
+		h ^= (*p) * P5;
+		h = rotl(h, 11) * P1;
+	}
+
+	h ^= h >> 33;
+	h *= P2;
+	h ^= h >> 29;
+	h *= P3;
+	h ^= h >> 32;
+	return h;
+}
+
+// ==============================================================
+
+// Hash `len` bytes at `off`. Returns zero and sets errno on failure.
+// Note that a file truncated while it is mapped will SIGBUS; this is
+// the usual hazard of mmap, shared by grep, rsync and friends.
+static bool hash_range(int fd, off_t off, size_t len, uint64_t seed,
+                       uint64_t& h)
+{
+	if (0 == len)
+	{
+		h = FileHasher::xxh64(nullptr, 0, seed);
+		return true;
+	}
+
+	void* map = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, off);
+	if (MAP_FAILED == map) return false;
+	madvise(map, len, MADV_SEQUENTIAL);
+	h = FileHasher::xxh64(map, len, seed);
+	munmap(map, len);
+	return true;
+}
+
+uint64_t FileHasher::hash_fd(int fd, off_t size, bool parallel)
+{
+	uint64_t h = 0;
+	if ((size_t) size <= HASH_CHUNK)
+	{
+		if (not hash_range(fd, 0, size, 0, h))
+		{
+			int norr = errno;
+			throw RuntimeException(TRACE_INFO,
+				"Unable to map file: %s", strerror(norr));
+		}
+		return h;
+	}
+
+	size_t nchunks = (size + HASH_CHUNK - 1) / HASH_CHUNK;
+	std::vector<uint64_t> digests(nchunks);
+	std::atomic<size_t> next(0);
+	std::atomic<int> failed(0);
+
+	auto work = [&]()
+	{
+		size_t i;
+		while ((i = next++) < nchunks and 0 == failed)
+		{
+			off_t off = i * HASH_CHUNK;
+			size_t len = std::min((size_t) (size - off), HASH_CHUNK);
+			if (not hash_range(fd, off, len, 0, digests[i]))
+				failed = errno;
+		}
+	};
+
+	size_t nthr = parallel ? std::min(_nthreads, nchunks) : 1;
+	std::vector<std::thread> helpers;
+	for (size_t i = 1; i < nthr; i++)
+		helpers.emplace_back(work);
+	work();
+	for (std::thread& t : helpers)
+		t.join();
+
+	if (failed)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to map file: %s", strerror(failed));
+
+	// Serialize the digests little-endian, so that the fingerprint
+	// is the same on every machine.
+	std::vector<uint8_t> bytes(8 * nchunks);
+	for (size_t i = 0; i < nchunks; i++)
+		for (size_t b = 0; b < 8; b++)
+			bytes[8*i + b] = (digests[i] >> (8*b)) & 0xff;
+
+	return xxh64(bytes.data(), bytes.size(), size);
+}
+
+// ==============================================================
+
+static bool same_stat(const struct stat& a, const struct stat& b)
+{
+	return a.st_size == b.st_size and
+		a.st_mtim.tv_sec == b.st_mtim.tv_sec and
+		a.st_mtim.tv_nsec == b.st_mtim.tv_nsec;
+}
+
+uint64_t FileHasher::hash_file(const std::string& path, bool parallel)
+{
+	// Non-blocking, so that a FIFO found here by mistake (or put
+	// here since the caller looked) does not hang the open().
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+	if (fd < 0)
+	{
+		int norr = errno;
+		throw RuntimeException(TRACE_INFO,
+			"Location %s inaccessible: %s", path.c_str(), strerror(norr));
+	}
+
+	struct stat sb;
+	if (fstat(fd, &sb) or not S_ISREG(sb.st_mode))
+	{
+		::close(fd);
+		throw RuntimeException(TRACE_INFO,
+			"Location %s is not a regular file", path.c_str());
+	}
+
+	std::pair<dev_t, ino_t> key(sb.st_dev, sb.st_ino);
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		auto it = _cache.find(key);
+		if (_cache.end() != it and
+		    it->second.size == sb.st_size and
+		    it->second.mtime.tv_sec == sb.st_mtim.tv_sec and
+		    it->second.mtime.tv_nsec == sb.st_mtim.tv_nsec)
+		{
+			::close(fd);
+			return it->second.hash;
+		}
+	}
+
+	uint64_t h;
+	try { h = hash_fd(fd, sb.st_size, parallel); }
+	catch (...) { ::close(fd); throw; }
+
+	// Don't remember a hash of a file that changed while being read.
+	struct stat after;
+	bool stable = (0 == fstat(fd, &after)) and same_stat(sb, after);
+	::close(fd);
+	if (not stable) return h;
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (MAX_CACHED <= _cache.size())
+		_cache.clear();
+	_cache[key] = {sb.st_mtim, sb.st_size, h};
+	return h;
+}
+
+// ====================================================================
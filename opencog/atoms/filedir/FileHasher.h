@@ -0,0 +1,103 @@
+/*
+ * opencog/atoms/filedir/FileHasher.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_FILE_HASHER_H
+#define _OPENCOG_FILE_HASHER_H
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <time.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * FileHasher - Fast content fingerprints for files.
+ *
+ * The fingerprint is a 64-bit XXH64 hash. It is meant for spotting
+ * duplicates and changes, and is NOT cryptographically secure.
+ *
+ * Files no larger than one chunk are hashed in one go, straight out
+ * of an mmap. Larger files are cut into fixed-size chunks, the chunks
+ * are hashed in parallel, and the fingerprint is the hash of the
+ * chunk hashes, seeded with the file size. Thus, fingerprints of large
+ * files are not the same as what the `xxhsum` utility prints; they are
+ * only comparable to other fingerprints made here. The fingerprint
+ * does not depend on the number of threads used.
+ *
+ * Results are remembered by (device, inode), and re-used for as long
+ * as the mtime and size of the file are unchanged.
+ */
+class FileHasher
+{
+private:
+	struct Cached
+	{
+		struct timespec mtime;
+		off_t size;
+		uint64_t hash;
+	};
+	std::mutex _mtx;
+	std::map<std::pair<dev_t, ino_t>, Cached> _cache;
+
+	size_t _nthreads;
+
+	uint64_t hash_fd(int fd, off_t size, bool parallel);
+
+public:
+	/**
+	 * @param nthreads Most threads to use for one large file; zero
+	 *                 means pick a default based on the number of CPUs.
+	 */
+	FileHasher(size_t nthreads = 0);
+
+	// Prevent copying
+	FileHasher(const FileHasher&) = delete;
+	FileHasher& operator=(const FileHasher&) = delete;
+
+	/**
+	 * Fingerprint the file at `path`. Large files are hashed using
+	 * several threads, unless `parallel` is false (useful when the
+	 * caller is already hashing many files at once).
+	 *
+	 * @throws RuntimeException if the file cannot be read, or is not
+	 *         a regular file.
+	 */
+	uint64_t hash_file(const std::string& path, bool parallel = true);
+
+	/// Drop all remembered fingerprints.
+	void clear(void);
+
+	/// The XXH64 hash of a memory block.
+	static uint64_t xxh64(const void* buf, size_t len, uint64_t seed);
+
+	/// Sixteen hex digits.
+	static std::string to_hex(uint64_t);
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_FILE_HASHER_H
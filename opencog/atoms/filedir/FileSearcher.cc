@@ -0,0 +1,237 @@
+/*
+ * opencog/atoms/filedir/FileSearcher.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <opencog/util/exceptions.h>
+
+#include "FileSearcher.h"
+
+using namespace opencog;
+
+// Files with a NUL byte in this many leading bytes count as binary.
+#define BINARY_PROBE 8192
+
+// Reported lines are cut off at this length. Minified javascript and
+// the like can have megabyte-long lines.
+#define MAX_LINE 4096
+
+// regexec offsets are a regoff_t, which is an int; a file bigger than
+// this is searched a window of whole lines at a time.
+#define REGEX_WINDOW (1UL << 30)
+
+FileSearcher::FileSearcher(const std::string& pattern, bool is_regex) :
+	_pattern(pattern),
+	_is_regex(is_regex)
+{
+	if (_pattern.empty())
+		throw RuntimeException(TRACE_INFO,
+			"FileSearcher: empty search pattern");
+
+	// Compile one up front, so that a bad pattern is reported
+	// right away, rather than silently matching nothing.
+	if (_is_regex)
+		put_regex(get_regex());
+}
+
+FileSearcher::~FileSearcher()
+{
+	for (regex_t* re : _pool)
+	{
+		regfree(re);
+		delete re;
+	}
+}
+
+regex_t* FileSearcher::get_regex(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(_pool_mtx);
+		if (not _pool.empty())
+		{
+			regex_t* re = _pool.back();
+			_pool.pop_back();
+			return re;
+		}
+	}
+
+	regex_t* re = new regex_t;
+	int rc = regcomp(re, _pattern.c_str(), REG_EXTENDED | REG_NEWLINE);
+	if (rc)
+	{
+		char msg[256];
+		regerror(rc, re, msg, sizeof(msg));
+		delete re;
+		throw RuntimeException(TRACE_INFO,
+			"FileSearcher: bad regex \"%s\": %s", _pattern.c_str(), msg);
+	}
+	return re;
+}
+
+void FileSearcher::put_regex(regex_t* re)
+{
+	std::lock_guard<std::mutex> lock(_pool_mtx);
+	_pool.push_back(re);
+}
+
+// ==============================================================
+
+static size_t count_newlines(const char* p, const char* end)
+{
+	size_t n = 0;
+	while (p < end and (p = (const char*) memchr(p, '\n', end - p)))
+	{
+		n++;
+		p++;
+	}
+	return n;
+}
+
+// Report the line holding `hit`; return where to resume searching.
+// Only one report is made per line, no matter how many hits it has.
+static const char* report(const char* buf, const char* end,
+                          const char* hit, size_t lineno,
+                          const FileSearcher::Match& cb)
+{
+	const char* bol = (const char*) memrchr(buf, '\n', hit - buf);
+	bol = bol ? bol + 1 : buf;
+	const char* eol = (const char*) memchr(hit, '\n', end - hit);
+	if (nullptr == eol) eol = end;
+
+	size_t len = eol - bol;
+	cb(lineno, bol, len < MAX_LINE ? len : MAX_LINE);
+	return eol + 1;
+}
+
+void FileSearcher::search_literal(const char* buf, size_t len,
+                                  const Match& cb) const
+{
+	const char* end = buf + len;
+	const char* p = buf;
+	const char* counted = buf;
+	size_t lineno = 1;
+
+	while (p < end)
+	{
+		const char* hit = (const char*)
+			memmem(p, end - p, _pattern.data(), _pattern.size());
+		if (nullptr == hit) break;
+
+		lineno += count_newlines(counted, hit);
+		counted = hit;
+		p = report(buf, end, hit, lineno, cb);
+	}
+}
+
+void FileSearcher::search_regex(const char* buf, size_t len,
+                                const Match& cb)
+{
+	regex_t* re = get_regex();
+
+	const char* end = buf + len;
+	const char* p = buf;
+	const char* counted = buf;
+	size_t lineno = 1;
+
+	// REG_STARTEND lets the regex run on the mmapped file directly,
+	// even though it is not NUL-terminated. With REG_NEWLINE, no match
+	// crosses a line, so cutting the file at a newline loses nothing.
+	while (p < end)
+	{
+		const char* wend = end;
+		if (REGEX_WINDOW < (size_t) (end - p))
+		{
+			wend = (const char*) memrchr(p, '\n', REGEX_WINDOW);
+			wend = wend ? wend + 1 : p + REGEX_WINDOW;
+		}
+
+		// Only a line longer than the window starts one mid-line.
+		int flags = REG_STARTEND;
+		if (p != buf and '\n' != p[-1]) flags |= REG_NOTBOL;
+
+		regmatch_t m;
+		m.rm_so = 0;
+		m.rm_eo = wend - p;
+		if (regexec(re, p, 1, &m, flags))
+		{
+			p = wend;
+			continue;
+		}
+
+		const char* hit = p + m.rm_so;
+		lineno += count_newlines(counted, hit);
+		counted = hit;
+		p = report(buf, end, hit, lineno, cb);
+	}
+
+	put_regex(re);
+}
+
+// ==============================================================
+
+bool FileSearcher::search_file(const std::string& path, const Match& cb)
+{
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) return false;
+
+	struct stat sb;
+	if (fstat(fd, &sb) or not S_ISREG(sb.st_mode))
+	{
+		::close(fd);
+		return false;
+	}
+	if (0 == sb.st_size)
+	{
+		::close(fd);
+		return true;
+	}
+
+	size_t len = sb.st_size;
+	void* map = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (MAP_FAILED == map) return false;
+	madvise(map, len, MADV_SEQUENTIAL);
+
+	const char* buf = (const char*) map;
+	bool ok = (nullptr == memchr(buf, 0, std::min(len, (size_t) BINARY_PROBE)));
+	if (ok)
+	{
+		try
+		{
+			if (_is_regex)
+				search_regex(buf, len, cb);
+			else
+				search_literal(buf, len, cb);
+		}
+		catch (...)
+		{
+			munmap(map, len);
+			throw;
+		}
+	}
+
+	munmap(map, len);
+	return ok;
+}
+
+// ====================================================================
@@ -0,0 +1,90 @@
+/*
+ * opencog/atoms/filedir/FileSearcher.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_FILE_SEARCHER_H
+#define _OPENCOG_FILE_SEARCHER_H
+
+#include <regex.h>
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * FileSearcher - grep-like search of file contents.
+ *
+ * Files are mmapped and searched in place. Literal patterns are found
+ * with memmem(), which glibc implements with vector instructions;
+ * regular patterns use POSIX extended regexes, with REG_NEWLINE, so
+ * that `^` and `$` match at line boundaries. Files that look binary
+ * (a NUL byte in the first few kilobytes) are skipped, as grep does.
+ *
+ * A single FileSearcher may be used from many threads at once.
+ */
+class FileSearcher
+{
+public:
+	/// Called for each matching line. Line numbers start at one.
+	/// The line does not include the trailing newline.
+	typedef std::function<void(size_t, const char*, size_t)> Match;
+
+private:
+	std::string _pattern;
+	bool _is_regex;
+
+	// glibc regexec() locks the compiled regex, so sharing one
+	// between threads serializes them. Instead, keep a pool, and
+	// hand out one per search.
+	std::mutex _pool_mtx;
+	std::vector<regex_t*> _pool;
+	regex_t* get_regex(void);
+	void put_regex(regex_t*);
+
+	void search_literal(const char*, size_t, const Match&) const;
+	void search_regex(const char*, size_t, const Match&);
+
+public:
+	/**
+	 * @throws RuntimeException if the pattern is empty, or is not
+	 *         a valid extended regex.
+	 */
+	FileSearcher(const std::string& pattern, bool is_regex);
+	~FileSearcher();
+
+	// Prevent copying
+	FileSearcher(const FileSearcher&) = delete;
+	FileSearcher& operator=(const FileSearcher&) = delete;
+
+	/**
+	 * Search the file at `path`, calling `cb` on each matching line.
+	 * Returns false if the file could not be read, or was skipped
+	 * as binary.
+	 */
+	bool search_file(const std::string& path, const Match& cb);
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_FILE_SEARCHER_H
@@ -27,11 +27,14 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <chrono>
+
 #include <opencog/util/exceptions.h>
 #include <opencog/util/oc_assert.h>
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/value/BoolValue.h>
 #include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atoms/value/QueueValue.h>
@@ -57,25 +60,30 @@ using namespace opencog;
 
 FileSysNode::FileSysNode(const std::string&& url)
 	: TextStreamNode(FILE_SYS_NODE, std::move(url)),
-	  _watcher()
+	  _watcher(),
+	  _hasher(std::make_shared<FileHasher>())
 {
+	addMessage("*-cache-*");
 	init(get_name());
 }
 
 FileSysNode::FileSysNode(Type t, const std::string&& url)
 	: TextStreamNode(t, std::move(url)),
-	  _watcher()
+	  _watcher(),
+	  _hasher(std::make_shared<FileHasher>())
 {
 	if (not nameserver().isA(t, FILE_SYS_NODE))
 		throw RuntimeException(TRACE_INFO,
 			"Expecting a FileSysNode, got %d %s\n",
 			t, nameserver().getTypeName(t).c_str());
 
+	addMessage("*-cache-*");
 	init(get_name());
 }
 
 FileSysNode::~FileSysNode()
 {
+	stop_walk();
 	_watcher.stop_watching();
 }
 
@@ -110,10 +118,11 @@ void FileSysNode::open(const ValuePtr& vp)
 {
 	TextStreamNode::open(vp);
 
+	stop_walk();
 	if (_cvp)
 		_cvp->close();
 
-	_cvp = createQueueValue();
+	_cvp = make_queue();
 }
 
 bool FileSysNode::connected(void) const
@@ -124,6 +133,13 @@ bool FileSysNode::connected(void) const
 ValuePtr FileSysNode::stream(void) const
 {
 	if (not connected()) return createVoidValue();
+
+	// Taken straight off the queue, results would not be counted off
+	// for *-ack-*, nor captured, nor conflated; so, if need be, go
+	// through read().
+	if (std::atomic_load(&_queue_wal) or std::atomic_load(&_capture)
+	    or _conflate)
+		return StreamNode::stream();
 	return _cvp;
 }
 
@@ -131,12 +147,14 @@ void FileSysNode::close(const ValuePtr& vp)
 {
 	// Stop watching
 	_watcher.stop_watching();
+	stop_walk();
 
 	if (_cvp)
 	{
 		_cvp->close();
 		_cvp = nullptr;
 	}
+	notify();
 }
 
 void FileSysNode::do_write(const std::string& str)
@@ -252,11 +270,11 @@ static DIR* do_opendir(const std::string& path)
 }
 
 
-static ValuePtr make_stream_dirent(struct dirent* dent,
+static ValuePtr make_stream_dirent(unsigned char dtype,
                                    const ValuePtr& locurl)
 {
 	std::string ftype = "unknown";
-	switch (dent->d_type)
+	switch (dtype)
 	{
 		case DT_BLK: ftype = "block"; break;
 		case DT_CHR: ftype = "char"; break;
@@ -272,16 +290,279 @@ static ValuePtr make_stream_dirent(struct dirent* dent,
 	return createLinkValue(vs);
 }
 
+// ==============================================================
+// Recursive walk.
+//
+// The walk runs in a background thread, so that the write() that
+// starts it returns right away, and the reader can start working on
+// results while the walk is still in progress. Results are delivered
+// in batches of at most WALK_BATCH file URLs; each batch is a
+// LinkValue that starts with the command, just like `ls`. The end of
+// the walk is marked by a batch holding nothing but the command.
+//
+// To keep memory bounded, the walk stalls whenever more than
+// WALK_MAX_QUEUED batches are waiting to be read. The QueueValue
+// does not offer a way to wait for space, so this polls.
+//
+// The same machinery is used to fingerprint and to search every file
+// in a tree; these differ only in what the visitor puts in a batch.
+// Files that cannot be read are skipped, the same way that unreadable
+// directories are.
+
+#define WALK_BATCH 256
+#define WALK_MAX_QUEUED 64
+
+void FileSysNode::stop_walk(void)
+{
+	if (_walker) _walker->cancel();
+	if (_walk_thread.joinable()) _walk_thread.join();
+	_walker = nullptr;
+}
+
+void FileSysNode::start_walk(const ValuePtr& cmd, const std::string& root,
+                             const WalkVisitor& visitor)
+{
+	stop_walk();
+
+	std::string top = root;
+	while (1 < top.size() and '/' == top.back()) top.pop_back();
+
+	// Throw now, rather than leaving the reader hanging.
+	closedir(do_opendir(top));
+
+	// The thread gets its own copies, because close() may clear
+	// the members while the walk is still running.
+	ContainerValuePtr cvp = _cvp;
+	std::shared_ptr<DirWalker> walker = std::make_shared<DirWalker>();
+	_walker = walker;
+
+	_walk_thread = std::thread([this, cmd, cvp, walker, visitor, top]()
+	{
+		// One partly-filled batch per worker, so no locking.
+		std::vector<ValueSeq> batches(walker->nthreads());
+
+		auto flush = [&](ValueSeq& batch)
+		{
+			while (WALK_MAX_QUEUED <= cvp->size() and
+			       not walker->cancelled())
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+			ValueSeq vents({cmd});
+			vents.insert(vents.end(),
+				std::make_move_iterator(batch.begin()),
+				std::make_move_iterator(batch.end()));
+			batch.clear();
+			reply(cvp, createLinkValue(std::move(vents)));
+		};
+
+		try
+		{
+			walker->walk(top,
+				[&](size_t w, const std::string& path, unsigned char dtype)
+			{
+				ValueSeq& batch = batches[w];
+				visitor(w, path, dtype, batch);
+				if (batch.size() < WALK_BATCH) return;
+
+				// Adding to a closed queue throws; that just means
+				// nobody is listening any more.
+				try { flush(batch); }
+				catch (...) { walker->cancel(); }
+			});
+
+			if (walker->cancelled()) return;
+			for (ValueSeq& batch : batches)
+				if (0 < batch.size()) flush(batch);
+			reply(cvp, createLinkValue(ValueSeq({cmd})));
+		}
+		catch (...) {}
+	});
+}
+
+static void walk_visitor(size_t, const std::string& path, unsigned char,
+                         ValueSeq& batch)
+{
+	batch.emplace_back(createStringValue(_prefix + path));
+}
+
+static auto fingerprint_visitor(const std::shared_ptr<FileHasher>& hasher)
+{
+	return [hasher](size_t, const std::string& path, unsigned char dtype,
+	                ValueSeq& batch)
+	{
+		// The walk already runs one file per thread; don't also
+		// split up big files.
+		if (DT_REG != dtype) return;
+		uint64_t h;
+		try { h = hasher->hash_file(path, false); }
+		catch (...) { return; }
+
+		ValueSeq vs({createStringValue(_prefix + path)});
+		vs.emplace_back(createStringValue(FileHasher::to_hex(h)));
+		batch.emplace_back(createLinkValue(vs));
+	};
+}
+
+// Each match is reported as (url, line-number, line).
+void FileSysNode::start_search(const ValuePtr& cmd, const std::string& root,
+                               const std::string& pattern, bool is_regex)
+{
+	std::shared_ptr<FileSearcher> searcher =
+		std::make_shared<FileSearcher>(pattern, is_regex);
+
+	start_walk(cmd, root,
+		[searcher](size_t, const std::string& path, unsigned char dtype,
+		           ValueSeq& batch)
+	{
+		if (DT_REG != dtype) return;
+		ValuePtr locurl = createStringValue(_prefix + path);
+		searcher->search_file(path,
+			[&](size_t lineno, const char* line, size_t len)
+		{
+			ValueSeq vs({locurl});
+			vs.emplace_back(createFloatValue((double) lineno));
+			vs.emplace_back(createStringValue(std::string(line, len)));
+			batch.emplace_back(createLinkValue(vs));
+		});
+	});
+}
+
+// ==============================================================
+// Listing cache.
+//
+// Agents tend to ask for the same listings over and over. Caching is
+// off by default, because it costs an inotify watch per directory
+// listed; turn it on by sending (BoolValue #t) to *-cache-*.
+
+void FileSysNode::set_cache(const ValuePtr& value)
+{
+	if (not value->is_type(BOOL_VALUE))
+		throw RuntimeException(TRACE_INFO,
+			"FileSysNode: cache expects BoolValue; got %s\n",
+			value->to_string().c_str());
+
+	const std::vector<bool>& bv = BoolValueCast(value)->value();
+	bool enable = (0 < bv.size()) and bv[0];
+
+	if (enable and nullptr == _cache)
+		_cache = std::make_unique<DirCache>();
+	else if (not enable)
+		_cache = nullptr;
+}
+
+// Override setValue to intercept the *-cache-* message.
+void FileSysNode::setValue(const Handle& key, const ValuePtr& value)
+{
+	if (PREDICATE_NODE == key->get_type())
+	{
+		static constexpr uint32_t p_cache = dispatch_hash("*-cache-*");
+
+		const std::string& pred = key->get_name();
+		if (dispatch_hash(pred.c_str()) == p_cache)
+		{
+			set_cache(value);
+			return;
+		}
+	}
+
+	// Everything else goes to the base class.
+	TextStreamNode::setValue(key, value);
+}
+
+// ==============================================================
+// Content fingerprints.
+
+// Return (url, fingerprint) for regular files, and nullptr for
+// everything else.
+ValuePtr FileSysNode::fingerprint(const std::string& url,
+                                  unsigned char dtype)
+{
+	const std::string& path = url.substr(_pfxlen);
+
+	// Symlinks and unknowns need a stat to find out what they are.
+	if (DT_LNK == dtype or DT_UNKNOWN == dtype)
+	{
+		struct stat sb;
+		if (0 == stat(path.c_str(), &sb) and S_ISREG(sb.st_mode))
+			dtype = DT_REG;
+	}
+	if (DT_REG != dtype) return nullptr;
+
+	ValueSeq vs({createStringValue(url)});
+	vs.emplace_back(createStringValue(
+		FileHasher::to_hex(_hasher->hash_file(path))));
+	return createLinkValue(vs);
+}
+
 // ==============================================================
 // Dequeue anything perceived
 
 ValuePtr FileSysNode::read(void) const
 {
-	if (nullptr == _cvp)
+	ContainerValuePtr cvp(_cvp);
+	if (nullptr == cvp)
 		throw RuntimeException(TRACE_INFO,
 			"FileSysNode not open: %s\n", to_string().c_str());
 
-	return _cvp->remove();
+	// Replayed results come first; they were read before these.
+	ValuePtr rvp(wal_replay_next());
+	if (rvp) return rvp;
+
+	// Command results are logged as they are queued, by enqueue().
+	QueueValuePtr qvp(QueueValueCast(cvp));
+	if (qvp)
+	{
+		if (0 < _timeout_ms) return wal_dequeued(wait_queue(qvp));
+		return wal_dequeued(qvp->remove());
+	}
+
+	// Watch events go straight into a set, not through enqueue();
+	// they are logged as they are read. There is no eventfd to wait
+	// on, either; with a timeout, look every so often.
+	if (0 < _timeout_ms)
+	{
+		Deadline dl(read_deadline());
+		while (0 == cvp->size() and not cvp->is_closed())
+		{
+			if (dl.expired()) return timeout_value();
+			std::this_thread::sleep_for(
+				std::chrono::milliseconds(dl.wait_ms(50)));
+		}
+		if (0 == cvp->size()) return createVoidValue();
+	}
+	return wal_take(cvp->remove());
+}
+
+// Command results are queued here, from write() and from the walk
+// thread, so that the eventfd is rung for each.
+void FileSysNode::reply(const ContainerValuePtr& cvp, ValuePtr vp) const
+{
+	QueueValuePtr qvp(QueueValueCast(cvp));
+	if (qvp)
+	{
+		enqueue(qvp, std::move(vp));
+		return;
+	}
+	cvp->add(std::move(vp));
+	notify();
+}
+
+// Ready when a result is queued, or when closed.
+bool FileSysNode::ready(void) const
+{
+	ContainerValuePtr cvp(_cvp);
+	if (nullptr == cvp or _replaying) return true;
+	clear_notify();
+	return 0 < cvp->size() or cvp->is_closed();
+}
+
+// While watching, events are added by the FileWatcher, which does
+// not ring the eventfd; SelectLink polls for those, instead.
+int FileSysNode::ready_fd(void) const
+{
+	ContainerValuePtr cvp(_cvp);
+	if (nullptr == cvp or not cvp->is_type(QUEUE_VALUE)) return -1;
+	return notify_fd();
 }
 
 // ==============================================================
@@ -303,6 +584,17 @@ static std::string get_string(const ValuePtr& vp)
 	return empty_string;
 }
 
+static size_t get_num_args(const ValuePtr& vp)
+{
+	if (vp->is_link())
+		return HandleCast(vp)->get_arity();
+
+	if (vp->is_type(LINK_VALUE))
+		return LinkValueCast(vp)->value().size();
+
+	return 0;
+}
+
 static std::string get_arg_string(const ValuePtr& vp, int arg)
 {
 	if (vp->is_link())
@@ -332,7 +624,7 @@ void FileSysNode::write(const ValuePtr& vp)
 		ValueSeq vents;
 		vents.push_back(vp);
 		vents.emplace_back(string_to_type(_cwd));
-		_cvp->add(std::move(createLinkValue(std::move(vents))));
+		reply(_cvp, createLinkValue(std::move(vents)));
 		return;
 	}
 
@@ -354,37 +646,50 @@ void FileSysNode::write(const ValuePtr& vp)
 		return;
 	}
 
+	// Recursive listing of everything below the current directory.
+	if (0 == cmd.compare("walk"))
+	{
+		start_walk(vp, _cwd.substr(_pfxlen), walk_visitor);
+		return;
+	}
+
 	// Commands without any arguments. These are applied to all
 	// files/dirs in the current working dir.
 	if (0 < cmd.size())
 	{
 		const std::string& path = _cwd.substr(_pfxlen);
-		DIR* dir = do_opendir(path.c_str());
-		int fd = dirfd(dir);
+
+		bool need_stat = true;
+		if (0 == cmd.compare("ls") or 0 == cmd.compare("special") or
+		    0 == cmd.compare("fingerprint"))
+			need_stat = false;
+		else if (cmd.compare("btime") and cmd.compare("mtime") and
+		         cmd.compare("filesize"))
+			throw RuntimeException(TRACE_INFO,
+				"Unknown command \"%s\"\n", cmd.c_str());
+
+		// Note that "." and ".." are not listed. Directory listing
+		// is a recursive process, and recursively descending into
+		// the "." directory is an infinite loop. In principle, the
+		// agent should not do this. In practice, the current agent
+		// architecture is not sophisticated enough to handle this
+		// case cleanly. This is not enough for the general case,
+		// because softlinks can create loops, and we follow
+		// softlinks. Nor is this meant to be an inescapable gaol;
+		// soft links might send us off into wild territories. For
+		// now, just relax and go with the flow.
+		std::vector<DirCache::Entry> ents;
+		if (_cache)
+			_cache->list(path, need_stat, ents);
+		else
+			DirCache::read_dir(path, need_stat, ents);
 
 		ValueSeq vents;
 		vents.push_back(vp);
 
-		struct dirent* dent = readdir(dir);
-		for (; dent; dent = readdir(dir))
+		for (const DirCache::Entry& ent : ents)
 		{
-			// Vague attempt to avoid infinite loops during recursion.
-			// Directory listing is a recursive process, and recursively
-			// descending into the "." directory is an infinite loop.
-			// In principle, the agent should not do this. In practice,
-			// the current agent architecture is not sophisticated
-			// enough to handle this case cleanly. So, for now, as a
-			// quick hack, disable the "." and ".." directories.
-			// This is not enough for the general case, because
-			// softlinks can create loops, and we follow softlinks.
-			// Nor is this meant to be an inescapable gaol; soft links
-			// might send us off into wild territories. For now, just
-			// relax and go with the flow. We'll fix problems later.
-			// XXX FIXME the problem above, later.
-			if (0 == strcmp(dent->d_name, ".")) continue;
-			if (0 == strcmp(dent->d_name, "..")) continue;
-
-			ValuePtr locurl = createStringValue(_cwd + "/" + + dent->d_name);
+			ValuePtr locurl = createStringValue(_cwd + "/" + ent.name);
 
 			// Dispatch by command
 			if (0 == cmd.compare("ls"))
@@ -395,28 +700,25 @@ void FileSysNode::write(const ValuePtr& vp)
 
 			if (0 == cmd.compare("special"))
 			{
-				vents.emplace_back(make_stream_dirent(dent, locurl));
+				vents.emplace_back(make_stream_dirent(ent.dtype, locurl));
 				continue;
 			}
 
-			// The remaining commands require performing a stat()
-			unsigned int mask = STATX_BTIME | STATX_MTIME | STATX_SIZE;
-			struct statx statxbuf;
-			int rc = statx(fd, dent->d_name, 0, mask, &statxbuf);
-			if (rc)
+			if (0 == cmd.compare("fingerprint"))
 			{
-				int norr = errno;
-				closedir(dir);
-				throw RuntimeException(TRACE_INFO,
-					"Location %s error: %s",
-					StringValueCast(locurl)->value()[0].c_str(),
-					strerror(norr));
+				// Files that can't be read, or that vanished since
+				// the listing, are left out, as in the tree walk.
+				ValuePtr fp;
+				try { fp = fingerprint(_cwd + "/" + ent.name, ent.dtype); }
+				catch (...) { continue; }
+				if (fp) vents.emplace_back(fp);
+				continue;
 			}
 
 			ValueSeq vs({locurl});
 			if (0 == cmd.compare("btime"))
 			{
-				time_t epoch = statxbuf.stx_btime.tv_sec;
+				time_t epoch = ent.stx.stx_btime.tv_sec;
 				vs.emplace_back(createStringValue(
 					ctime(&epoch)));
 				vents.emplace_back(createLinkValue(vs));
@@ -425,28 +727,19 @@ void FileSysNode::write(const ValuePtr& vp)
 
 			if (0 == cmd.compare("mtime"))
 			{
-				time_t epoch = statxbuf.stx_mtime.tv_sec;
+				time_t epoch = ent.stx.stx_mtime.tv_sec;
 				vs.emplace_back(createStringValue(
 					ctime(&epoch)));
 				vents.emplace_back(createLinkValue(vs));
 				continue;
 			}
 
-			if (0 == cmd.compare("filesize"))
-			{
-				vs.emplace_back(createFloatValue(
-					(double) statxbuf.stx_size));
-				vents.emplace_back(createLinkValue(vs));
-				continue;
-			}
-
-			// If we are here, its an unknown command
-			closedir(dir);
-			throw RuntimeException(TRACE_INFO,
-				"Unknown command \"%s\"\n", cmd.c_str());
+			// Must be filesize
+			vs.emplace_back(createFloatValue(
+				(double) ent.stx.stx_size));
+			vents.emplace_back(createLinkValue(vs));
 		}
-		closedir(dir);
-		_cvp->add(std::move(createLinkValue(std::move(vents))));
+		reply(_cvp, createLinkValue(std::move(vents)));
 		return;
 	}
 
@@ -455,6 +748,26 @@ void FileSysNode::write(const ValuePtr& vp)
 	// previously with `ls`.
 
 	cmd = get_arg_string(vp, 0);
+
+	// Search for a pattern in the contents of every file in a tree.
+	// The second argument is the pattern; the optional third is the
+	// top of the tree (defaults to the current directory).
+	if (0 == cmd.compare("search") or 0 == cmd.compare("search-regex"))
+	{
+		std::string pattern = get_arg_string(vp, 1);
+		std::string top = _cwd;
+		if (2 < get_num_args(vp))
+			top = get_arg_string(vp, 2);
+
+		if (top.compare(0, _pfxlen, _prefix))
+			throw RuntimeException(TRACE_INFO,
+				"Expecting file URL; got %s", top.c_str());
+
+		start_search(vp, top.substr(_pfxlen), pattern,
+			0 == cmd.compare("search-regex"));
+		return;
+	}
+
 	std::string fpath = get_arg_string(vp, 1);
 
 	if (fpath.compare(0, _pfxlen, _prefix))
@@ -468,7 +781,13 @@ void FileSysNode::write(const ValuePtr& vp)
 		ValueSeq vents;
 		vents.push_back(vp);
 		vents.emplace_back(createStringValue(_cwd));
-		_cvp->add(std::move(createLinkValue(std::move(vents))));
+		reply(_cvp, createLinkValue(std::move(vents)));
+		return;
+	}
+
+	if (0 == cmd.compare("walk"))
+	{
+		start_walk(vp, fpath.substr(_pfxlen), walk_visitor);
 		return;
 	}
 
@@ -487,21 +806,42 @@ void FileSysNode::write(const ValuePtr& vp)
 		{
 			if (strcmp(dent->d_name, ".")) continue;
 			ValuePtr locurl = createStringValue(fpath);
-			vents.emplace_back(make_stream_dirent(dent, locurl));
+			vents.emplace_back(make_stream_dirent(dent->d_type, locurl));
 			break;
 		}
 		closedir(dir);
-		_cvp->add(std::move(createLinkValue(std::move(vents))));
+		reply(_cvp, createLinkValue(std::move(vents)));
 		return;
 	}
 
-	// File magic. Not implemented.
-	if (0 == cmd.compare("magic"))
+	// Content fingerprint of a file, or of every file in a tree.
+	// Trees can be huge, so those are streamed, just like `walk`.
+	if (0 == cmd.compare("fingerprint"))
 	{
+		const std::string& path = fpath.substr(_pfxlen);
+		struct stat sb;
+		if (stat(path.c_str(), &sb))
+		{
+			int norr = errno;
+			throw RuntimeException(TRACE_INFO,
+				"Location %s inaccessible: %s",
+				path.c_str(), strerror(norr));
+		}
+		if (S_ISDIR(sb.st_mode))
+		{
+			start_walk(vp, path, fingerprint_visitor(_hasher));
+			return;
+		}
+
+		// Opening a FIFO, or a device, could wait forever.
+		if (not S_ISREG(sb.st_mode))
+			throw RuntimeException(TRACE_INFO,
+				"Location %s is not a regular file", path.c_str());
+
 		ValueSeq vents;
 		vents.push_back(vp);
-
-		_cvp->add(std::move(createLinkValue(std::move(vents))));
+		vents.emplace_back(fingerprint(fpath, DT_REG));
+		reply(_cvp, createLinkValue(std::move(vents)));
 		return;
 	}
 
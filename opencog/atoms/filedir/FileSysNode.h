@@ -23,8 +23,15 @@
 #ifndef _OPENCOG_FILE_SYS_NODE_H
 #define _OPENCOG_FILE_SYS_NODE_H
 
+#include <functional>
+#include <memory>
+#include <thread>
 #include <opencog/atoms/value/ContainerValue.h>
 #include <opencog/atoms/sensory/TextStreamNode.h>
+#include "DirCache.h"
+#include "DirWalker.h"
+#include "FileHasher.h"
+#include "FileSearcher.h"
 #include "FileWatcher.h"
 
 namespace opencog
@@ -49,11 +56,34 @@ protected:
 	// Directory watching support
 	mutable FileWatcher _watcher;
 
+	// Optional cache of directory listings and stat results.
+	std::unique_ptr<DirCache> _cache;
+	void set_cache(const ValuePtr&);
+
+	// Content fingerprints, remembered across calls.
+	std::shared_ptr<FileHasher> _hasher;
+	ValuePtr fingerprint(const std::string&, unsigned char);
+
+	// Recursive walks run in the background, streaming into _cvp.
+	// The visitor is given the worker number, the path and DT_* type
+	// of each entry found, and appends results, if any, to the batch.
+	typedef std::function<void(size_t, const std::string&,
+	                           unsigned char, ValueSeq&)> WalkVisitor;
+	std::thread _walk_thread;
+	std::shared_ptr<DirWalker> _walker;
+	void start_walk(const ValuePtr&, const std::string&, const WalkVisitor&);
+	void start_search(const ValuePtr&, const std::string&,
+	                  const std::string&, bool);
+	void stop_walk(void);
+
 	virtual void open(const ValuePtr&);
 	virtual bool connected(void) const;
 	virtual void close(const ValuePtr&);
 	virtual ValuePtr read(void) const;
 	virtual ValuePtr stream(void) const;
+	virtual bool ready(void) const;
+	virtual int ready_fd(void) const;
+	void reply(const ContainerValuePtr&, ValuePtr) const;
 	virtual void write(const ValuePtr&);
 	virtual void do_write(const std::string&);
 
@@ -62,6 +92,8 @@ public:
 	FileSysNode(Type, const std::string&&);
 	virtual ~FileSysNode();
 
+	virtual void setValue(const Handle& key, const ValuePtr& value);
+
 	static Handle factory(const Handle&);
 };
 
@@ -24,10 +24,12 @@
 #include <limits.h>
 #include <poll.h>
 #include <string.h>
+#include <sys/epoll.h>
 #include <sys/inotify.h>
 #include <unistd.h>
 
 #include <opencog/util/exceptions.h>
+#include <opencog/atoms/sensory/Executor.h>
 #include <opencog/atoms/value/StringValue.h>
 #include <opencog/atoms/value/ValueFactory.h>
 
@@ -39,7 +41,8 @@ FileWatcher::FileWatcher() :
 	_inotify_fd(-1),
 	_watch_fd(-1),
 	_watch_path(),
-	_event_mask(0)
+	_event_mask(0),
+	_watch_id(0)
 {
 }
 
@@ -59,6 +62,7 @@ void FileWatcher::cleanup_watch()
 	}
 	_watch_path.clear();
 	_event_mask = 0;
+	_pending_events.clear();
 }
 
 void FileWatcher::cleanup_inotify()
@@ -68,6 +72,23 @@ void FileWatcher::cleanup_inotify()
 		::close(_inotify_fd);
 		_inotify_fd = -1;
 	}
+
+	// Closing the inotify fd drops all of the watches on it.
+	_dir_watches.clear();
+}
+
+// Caller must hold the lock.
+void FileWatcher::init_inotify()
+{
+	if (_inotify_fd >= 0) return;
+
+	_inotify_fd = inotify_init1(IN_NONBLOCK);
+	if (_inotify_fd < 0)
+	{
+		int norr = errno;
+		throw RuntimeException(TRACE_INFO,
+			"Failed to initialize inotify: %s\n", strerror(norr));
+	}
 }
 
 void FileWatcher::add_watch(const std::string& path)
@@ -78,20 +99,15 @@ void FileWatcher::add_watch(const std::string& path)
 	if (_watch_fd >= 0)
 		cleanup_watch();
 
-	// Initialize inotify if not already done
-	if (_inotify_fd < 0)
-	{
-		_inotify_fd = inotify_init1(IN_NONBLOCK);
-		if (_inotify_fd < 0)
-		{
-			int norr = errno;
-			throw RuntimeException(TRACE_INFO,
-				"Failed to initialize inotify: %s\n", strerror(norr));
-		}
-	}
+	init_inotify();
 
-	// Event mask for watching files and directories
-	uint32_t mask = IN_CREATE | IN_MODIFY | IN_MOVED_TO | IN_DELETE | IN_CLOSE_WRITE;
+	// Event mask for watching files and directories. The _SELF events
+	// report that a watched file was renamed or removed out from under
+	// us, as happens when logs are rotated. A file that is still open
+	// is not freed when it is removed, so there is no IN_DELETE_SELF
+	// then; the drop in its link count comes as IN_ATTRIB instead.
+	uint32_t mask = IN_CREATE | IN_MODIFY | IN_MOVED_TO | IN_DELETE |
+		IN_CLOSE_WRITE | IN_MOVE_SELF | IN_DELETE_SELF | IN_ATTRIB;
 
 	// Add watch on the path
 	_watch_fd = inotify_add_watch(_inotify_fd, path.c_str(), mask);
@@ -115,28 +131,55 @@ void FileWatcher::remove_watch()
 	cleanup_inotify();
 }
 
+bool FileWatcher::has_pending() const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	return not _pending_events.empty();
+}
+
 std::pair<uint32_t, std::string> FileWatcher::wait_event()
 {
-	int inotify_fd_copy;
+	// Buffer for inotify events
+	// Must be large enough for at least one event plus the largest possible filename
+	char event_buf[4 * (sizeof(struct inotify_event) + NAME_MAX + 1)]
+		__attribute__((aligned(__alignof__(struct inotify_event))));
 
-	// Check if watch is active (with lock)
+	while (true)
 	{
-		std::lock_guard<std::mutex> lock(_mtx);
-		if (_inotify_fd < 0 || _watch_fd < 0)
+		int inotify_fd_copy;
+
+		// Check if watch is active (with lock). This is re-checked
+		// every time around the loop, because remove_watch() from
+		// another thread is how a waiting reader is told to quit.
 		{
-			throw RuntimeException(TRACE_INFO,
-				"FileWatcher::wait_event() called without active watch\n");
+			std::lock_guard<std::mutex> lock(_mtx);
+			if (_inotify_fd < 0 || _watch_fd < 0)
+			{
+				// Return a sentinel value indicating watch was removed
+				return std::make_pair(0, std::string());
+			}
+
+			// A single read() may return several events; those not
+			// handed out yet are kept, so that none are lost.
+			if (not _pending_events.empty())
+			{
+				std::pair<uint32_t, std::string> ev = _pending_events.front();
+				_pending_events.pop_front();
+				return ev;
+			}
+			inotify_fd_copy = _inotify_fd;
 		}
-		inotify_fd_copy = _inotify_fd;
-	}
 
-	// Buffer for inotify events
-	// Must be large enough for at least one event plus the largest possible filename
-	char event_buf[sizeof(struct inotify_event) + NAME_MAX + 1];
+		// The fd is non-blocking, so wait in poll() rather than
+		// spinning on read(). Closing the fd does not wake up poll(),
+		// so use a short timeout, and go back to check for removal.
+		struct pollfd pfd;
+		pfd.fd = inotify_fd_copy;
+		pfd.events = POLLIN;
+		int ret = poll(&pfd, 1, 100);
+		if (ret <= 0) continue;
 
-	while (true)
-	{
-		// Read without holding lock (this blocks)
+		// Read without holding lock
 		ssize_t len = ::read(inotify_fd_copy, event_buf, sizeof(event_buf));
 
 		if (len < 0)
@@ -159,16 +202,61 @@ std::pair<uint32_t, std::string> FileWatcher::wait_event()
 				"inotify read failed: %s\n", strerror(norr));
 		}
 
-		// Parse the event
-		struct inotify_event* event = (struct inotify_event*)event_buf;
+		std::lock_guard<std::mutex> lock(_mtx);
+		queue_events(event_buf, len);
+	}
+}
 
-		// Extract filename if present (for directory watches)
+// Parse the events into _pending_events. The filename is present only
+// for directory watches. Caller holds the lock.
+void FileWatcher::queue_events(const char* buf, ssize_t len)
+{
+	const struct inotify_event *event;
+	for (const char *ptr = buf; ptr < buf + len;
+	     ptr += sizeof(struct inotify_event) + event->len)
+	{
+		event = (const struct inotify_event *) ptr;
 		std::string filename;
 		if (event->len > 0)
 			filename = std::string(event->name);
+		_pending_events.emplace_back(event->mask, filename);
+	}
+}
+
+// Read whatever events the fd has, without waiting, and keep them
+// for wait_event(). A run of the same event says no more than one
+// does, so repeats are dropped; this keeps the queue short, when
+// called over and over, with no one calling wait_event().
+uint32_t FileWatcher::collect_events()
+{
+	char event_buf[4 * (sizeof(struct inotify_event) + NAME_MAX + 1)]
+		__attribute__((aligned(__alignof__(struct inotify_event))));
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (_inotify_fd < 0 || _watch_fd < 0) return 0;
+
+	while (true)
+	{
+		ssize_t len = ::read(_inotify_fd, event_buf, sizeof(event_buf));
+		if (len <= 0) break;
 
-		return std::make_pair(event->mask, filename);
+		size_t before = _pending_events.size();
+		queue_events(event_buf, len);
+
+		// Drop the new ones that repeat the one before them.
+		size_t keep = (0 < before) ? before : 1;
+		for (size_t i = keep; i < _pending_events.size(); i++)
+		{
+			if (_pending_events[i] != _pending_events[keep-1])
+				_pending_events[keep++] = std::move(_pending_events[i]);
+		}
+		_pending_events.resize(keep);
 	}
+
+	uint32_t mask = 0;
+	for (const auto& ev : _pending_events)
+		mask |= ev.first;
+	return mask;
 }
 
 bool FileWatcher::poll_and_add_events(const ContainerValuePtr& cvp, int timeout_ms)
@@ -235,22 +323,24 @@ bool FileWatcher::poll_and_add_events(const ContainerValuePtr& cvp, int timeout_
 	return true; // Events processed, continue watching
 }
 
-void FileWatcher::watch_thread_func(const ContainerValuePtr& cvp, int timeout_ms)
+// The inotify fd is watched by the shared executor; the callback runs
+// whenever there are events to read. There is no thread of our own.
+
+// Called from the callback, if reading the inotify fd fails.
+void FileWatcher::stop_on_error(void)
 {
-	// Poll and add events in a loop until told to stop
-	while (poll_and_add_events(cvp, timeout_ms))
-	{
-		// Continue watching...
-	}
-	// When poll_and_add_events returns false, exit thread
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (0 == _watch_id) return;
+	Executor::instance().unwatch(_watch_id);
+	_watch_id = 0;
 }
 
-void FileWatcher::start_watching(const std::string& path, const ContainerValuePtr& cvp, int timeout_ms)
+void FileWatcher::start_watching(const std::string& path, const ContainerValuePtr& cvp)
 {
 	{
 		std::lock_guard<std::mutex> lock(_mtx);
 		// Check if already watching
-		if (_watch_thread.joinable())
+		if (_watch_id)
 			throw RuntimeException(TRACE_INFO,
 				"FileWatcher already watching - call stop_watching() first\n");
 	}
@@ -258,29 +348,160 @@ void FileWatcher::start_watching(const std::string& path, const ContainerValuePt
 	// Setup watch (add_watch has its own lock)
 	add_watch(path);
 
-	// Start background thread
+	std::lock_guard<std::mutex> lock(_mtx);
+	_watch_id = Executor::instance().watch(_inotify_fd, EPOLLIN,
+		[this, cvp](uint32_t)
+		{
+			if (not poll_and_add_events(cvp, 0)) stop_on_error();
+		},
+		ExecOptions("inotify"));
+}
+
+void FileWatcher::stop_watching()
+{
+	uint64_t id;
 	{
 		std::lock_guard<std::mutex> lock(_mtx);
-		_watch_thread = std::thread(&FileWatcher::watch_thread_func, this, cvp, timeout_ms);
+		id = _watch_id;
+		_watch_id = 0;
 	}
+	if (0 == id) return;
+
+	// Waits for a callback in progress, without holding the lock,
+	// since the callback takes it. The fd must not be closed before
+	// this.
+	Executor::instance().unwatch(id);
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	cleanup_watch();
+	cleanup_inotify();
 }
 
-void FileWatcher::stop_watching()
+// ==============================================================
+// Multi-directory watching, with events delivered to a callback.
+
+bool FileWatcher::add_dir_watch(const std::string& path)
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	init_inotify();
+
+	// Anything that changes the listing of the directory, or the
+	// stat() of anything in it, or the directory itself.
+	uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+		IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE |
+		IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+	int wd = inotify_add_watch(_inotify_fd, path.c_str(), mask);
+	if (wd < 0) return false;
+
+	_dir_watches[wd] = path;
+	return true;
+}
+
+// Return false to signal that the thread should exit.
+static bool dispatch_events(int fd, int timeout_ms,
+                            std::mutex& mtx,
+                            std::unordered_map<int, std::string>& watches,
+                            const FileWatcher::Callback& cb)
+{
+	struct pollfd pfd;
+	pfd.fd = fd;
+	pfd.events = POLLIN;
+
+	int ret = poll(&pfd, 1, timeout_ms);
+	if (ret < 0)
+		return (errno == EINTR);
+	if (ret == 0)
+		return true;
+
+	char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	ssize_t len = read(fd, buf, sizeof(buf));
+	if (len < 0)
+		return (errno == EAGAIN || errno == EINTR);
+
+	const struct inotify_event *event;
+	for (char *ptr = buf; ptr < buf + len;
+	     ptr += sizeof(struct inotify_event) + event->len)
+	{
+		event = (const struct inotify_event *) ptr;
+
+		// Events were lost; the receiver has to assume that
+		// anything and everything might have changed.
+		if (event->mask & IN_Q_OVERFLOW)
+		{
+			cb(event->mask, std::string(), std::string());
+			continue;
+		}
+
+		std::string dir;
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			auto it = watches.find(event->wd);
+			if (watches.end() == it) continue;
+			dir = it->second;
+
+			// The kernel has dropped the watch (directory deleted
+			// or unmounted).
+			if (event->mask & IN_IGNORED)
+				watches.erase(it);
+		}
+
+		std::string name;
+		if (event->len > 0)
+			name = event->name;
+		cb(event->mask, dir, name);
+	}
+	return true;
+}
+
+void FileWatcher::start_dispatch(const Callback& cb)
 {
-	bool should_join = false;
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (_watch_id)
+		throw RuntimeException(TRACE_INFO,
+			"FileWatcher already watching - call stop_watching() first\n");
+
+	init_inotify();
+	_dispatch_cb = cb;
+
+	_watch_id = Executor::instance().watch(_inotify_fd, EPOLLIN,
+		[this, cb](uint32_t)
+		{
+			std::lock_guard<std::mutex> dlock(_dispatch_mtx);
+			int fd;
+			{
+				std::lock_guard<std::mutex> lock(_mtx);
+				if (_inotify_fd < 0) return;
+				fd = _inotify_fd;
+			}
+			if (not dispatch_events(fd, 0, _mtx, _dir_watches, cb))
+				stop_on_error();
+		},
+		ExecOptions("inotify"));
+}
 
-	// Check if thread is running and cleanup (with lock)
+void FileWatcher::dispatch_pending(void)
+{
+	std::lock_guard<std::mutex> dlock(_dispatch_mtx);
+	int fd;
+	Callback cb;
 	{
 		std::lock_guard<std::mutex> lock(_mtx);
-		if (_watch_thread.joinable())
+		if (_inotify_fd < 0 or 0 == _watch_id) return;
+		fd = _inotify_fd;
+		cb = _dispatch_cb;
+	}
+
+	// The fd is non-blocking; read until there is nothing left.
+	struct pollfd pfd;
+	pfd.fd = fd;
+	pfd.events = POLLIN;
+	while (0 < poll(&pfd, 1, 0))
+	{
+		if (not dispatch_events(fd, 0, _mtx, _dir_watches, cb))
 		{
-			should_join = true;
-			cleanup_watch();     // This will cause poll_and_add_events to return false
-			cleanup_inotify();   // Close inotify fd
+			stop_on_error();
+			return;
 		}
 	}
-
-	// Join thread without holding lock (join can block)
-	if (should_join)
-		_watch_thread.join();
 }
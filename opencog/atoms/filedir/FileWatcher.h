@@ -23,9 +23,13 @@
 #ifndef _OPENCOG_FILE_WATCHER_H
 #define _OPENCOG_FILE_WATCHER_H
 
+#include <stdint.h>
+#include <sys/types.h>
+#include <deque>
+#include <functional>
 #include <string>
-#include <thread>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <opencog/atoms/value/ContainerValue.h>
 
@@ -55,17 +59,40 @@ namespace opencog
  */
 class FileWatcher
 {
+public:
+	/// Callback for start_dispatch(). Arguments are the inotify
+	/// event mask, the watched directory, and the name of the file
+	/// within that directory (empty for events on the directory
+	/// itself, and for IN_Q_OVERFLOW).
+	typedef std::function<void(uint32_t, const std::string&,
+	                           const std::string&)> Callback;
+
 private:
 	mutable std::mutex _mtx;  // Protects all internal state
 	int _inotify_fd;
 	int _watch_fd;
 	std::string _watch_path;
 	uint32_t _event_mask;
-	std::thread _watch_thread;
+	uint64_t _watch_id;  // Executor watch, when watching in background
+
+	// Events read but not yet returned by wait_event().
+	std::deque<std::pair<uint32_t, std::string>> _pending_events;
 
+	// Additional directory watches, used with start_dispatch().
+	// Maps the inotify watch descriptor to the directory path.
+	std::unordered_map<int, std::string> _dir_watches;
+
+	// The callback given to start_dispatch(). Events are read and
+	// passed on under _dispatch_mtx, so that dispatch_pending() can
+	// wait for any that the Executor is in the middle of.
+	Callback _dispatch_cb;
+	std::mutex _dispatch_mtx;
+
+	void init_inotify();
 	void cleanup_watch();
 	void cleanup_inotify();
-	void watch_thread_func(const ContainerValuePtr& cvp, int timeout_ms);
+	void stop_on_error(void);
+	void queue_events(const char*, ssize_t);
 
 public:
 	FileWatcher();
@@ -95,10 +122,27 @@ public:
 	 *         - event_mask: The inotify event that occurred
 	 *         - filename: The name of the file (for directory watches)
 	 *                    or empty string (for file watches)
+	 *         Returns (0, "") if there is no watch, or if the watch
+	 *         was removed from another thread while waiting.
 	 * @throws RuntimeException if inotify read fails (non-EINTR error)
 	 */
 	std::pair<uint32_t, std::string> wait_event();
 
+	/**
+	 * Check for events already read, but not yet returned by
+	 * wait_event(). These do not make the fd readable again.
+	 */
+	bool has_pending() const;
+
+	/**
+	 * Read any events the fd has, without waiting, and keep them for
+	 * wait_event(). Afterwards, the fd is readable only if some new
+	 * event comes in.
+	 *
+	 * @return The inotify masks of all pending events, or'ed together.
+	 */
+	uint32_t collect_events();
+
 	/**
 	 * Check if currently watching a path.
 	 *
@@ -132,21 +176,51 @@ public:
 	bool poll_and_add_events(const ContainerValuePtr& cvp, int timeout_ms);
 
 	/**
-	 * Start watching a path in a background thread.
+	 * Start watching a path in the background, on the shared Executor.
 	 * Events will be automatically added to the container.
 	 *
 	 * @param path The file or directory path to watch
 	 * @param cvp Container to add filenames to (as StringValues)
-	 * @param timeout_ms Timeout in milliseconds for polling (default: 5000)
 	 * @throws RuntimeException if watch setup fails or already watching
 	 */
-	void start_watching(const std::string& path, const ContainerValuePtr& cvp, int timeout_ms = 5000);
+	void start_watching(const std::string& path, const ContainerValuePtr& cvp);
 
 	/**
-	 * Stop the background watching thread.
-	 * Blocks until the thread has exited.
+	 * Stop background watching.
+	 * Blocks until any event handling in progress has finished.
 	 */
 	void stop_watching();
+
+	/**
+	 * Add a watch on one more directory. Any number of directories
+	 * can be watched this way; events on all of them are delivered
+	 * to the callback given to start_dispatch(). Adding a directory
+	 * that is already watched is harmless.
+	 *
+	 * @param path The directory to watch
+	 * @return false if the watch could not be added (for example,
+	 *         because the inotify watch limit was hit)
+	 */
+	bool add_dir_watch(const std::string& path);
+
+	/**
+	 * Pass every event on the directories added with add_dir_watch()
+	 * to the callback, in the background, on the shared Executor.
+	 * Stop it with stop_watching().
+	 *
+	 * @param cb Callback to run for each event
+	 * @throws RuntimeException if already watching
+	 */
+	void start_dispatch(const Callback& cb);
+
+	/**
+	 * Pass on, right now, in this thread, every event that has
+	 * already happened, instead of waiting for the Executor to get
+	 * to them. Events on a change are queued by the time the call
+	 * that made it returns, so after this, the callback has seen
+	 * every change made before it was called.
+	 */
+	void dispatch_pending(void);
 };
 
 /** @}*/
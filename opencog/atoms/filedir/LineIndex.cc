@@ -0,0 +1,224 @@
+/*
+ * opencog/atoms/filedir/LineIndex.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <opencog/util/exceptions.h>
+
+#include "LineIndex.h"
+
+using namespace opencog;
+
+// The file is read in blocks of this size.
+#define INDEX_BLOCK (1024 * 1024)
+
+LineIndex::LineIndex(size_t stride) :
+	_stride(0 == stride ? 1 : stride),
+	_offsets({0}),
+	_scanned(0),
+	_newlines(0)
+{
+}
+
+// ==============================================================
+
+// Count the newlines in the block, recording the offset just past
+// every K'th one. Most blocks of sixteen bytes hold no recorded line
+// start, so these are dealt with by a compare, a movemask and a
+// popcount; only the block that holds the next one is looked at
+// bit by bit.
+void LineIndex::scan(const char* buf, size_t len)
+{
+	size_t next_mark = _offsets.size() * _stride;
+	size_t i = 0;
+
+#ifdef __SSE2__
+	const __m128i nl = _mm_set1_epi8('\n');
+	for (; i + 16 <= len; i += 16)
+	{
+		__m128i blk = _mm_loadu_si128((const __m128i*) (buf + i));
+		unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(blk, nl));
+		if (0 == mask) continue;
+
+		size_t cnt = __builtin_popcount(mask);
+		if (_newlines + cnt < next_mark)
+		{
+			_newlines += cnt;
+			continue;
+		}
+
+		while (mask)
+		{
+			int bit = __builtin_ctz(mask);
+			mask &= mask - 1;
+			if (++_newlines == next_mark)
+			{
+				_offsets.push_back(_scanned + i + bit + 1);
+				next_mark += _stride;
+			}
+		}
+	}
+#endif
+
+	for (; i < len; i++)
+	{
+		if ('\n' != buf[i]) continue;
+		if (++_newlines == next_mark)
+		{
+			_offsets.push_back(_scanned + i + 1);
+			next_mark += _stride;
+		}
+	}
+}
+
+void LineIndex::update(int fd)
+{
+	struct stat sb;
+	if (fstat(fd, &sb))
+	{
+		int norr = errno;
+		throw RuntimeException(TRACE_INFO,
+			"Unable to index file: %s", strerror(norr));
+	}
+
+	// Truncated; start over.
+	if (sb.st_size < _scanned)
+	{
+		_offsets = {0};
+		_scanned = 0;
+		_newlines = 0;
+	}
+
+	std::vector<char> buf(INDEX_BLOCK);
+	while (_scanned < sb.st_size)
+	{
+		ssize_t got = pread(fd, buf.data(), INDEX_BLOCK, _scanned);
+		if (got < 0 and EINTR == errno) continue;
+		if (got < 0)
+		{
+			int norr = errno;
+			throw RuntimeException(TRACE_INFO,
+				"Unable to index file: %s", strerror(norr));
+		}
+		if (0 == got) break;
+		scan(buf.data(), got);
+		_scanned += got;
+	}
+}
+
+off_t LineIndex::line_offset(int fd, size_t lineno) const
+{
+	if (lineno <= 1) return 0;
+
+	// Jump to the nearest recorded line at or before the target.
+	size_t skip = lineno - 1;
+	size_t k = skip / _stride;
+	if (_offsets.size() <= k) k = _offsets.size() - 1;
+	off_t off = _offsets[k];
+	skip -= k * _stride;
+
+	// Then walk forward over the remaining lines.
+	char buf[64 * 1024];
+	while (0 < skip)
+	{
+		ssize_t got = pread(fd, buf, sizeof(buf), off);
+		if (got < 0 and EINTR == errno) continue;
+		if (got <= 0) return off;
+
+		const char* p = buf;
+		const char* end = buf + got;
+		while (0 < skip and
+		       (p = (const char*) memchr(p, '\n', end - p)))
+		{
+			p++;
+			skip--;
+		}
+		if (0 == skip) return off + (p - buf);
+		off += got;
+	}
+	return off;
+}
+
+// ==============================================================
+// Sidecar files.
+//
+// A one-line text header, followed by the offsets, as raw binary.
+// The sidecar is not meant to be portable between machines.
+
+bool LineIndex::save(const std::string& path, const struct stat& sb) const
+{
+	std::string tmp = path + ".tmp";
+	FILE* fh = fopen(tmp.c_str(), "w");
+	if (nullptr == fh) return false;
+
+	fprintf(fh, "textfile-index 1 %lu %lu %lld %lld %ld %zu %zu %zu\n",
+		(unsigned long) sb.st_dev, (unsigned long) sb.st_ino,
+		(long long) _scanned, (long long) sb.st_mtim.tv_sec,
+		(long) sb.st_mtim.tv_nsec, _stride, _newlines, _offsets.size());
+	size_t n = fwrite(_offsets.data(), sizeof(off_t), _offsets.size(), fh);
+
+	bool ok = (n == _offsets.size()) and (0 == fclose(fh));
+	if (ok)
+		ok = (0 == rename(tmp.c_str(), path.c_str()));
+	else
+		unlink(tmp.c_str());
+	return ok;
+}
+
+bool LineIndex::load(const std::string& path, const struct stat& sb)
+{
+	FILE* fh = fopen(path.c_str(), "r");
+	if (nullptr == fh) return false;
+
+	int version = 0;
+	unsigned long dev = 0, ino = 0;
+	long long size = 0, sec = 0;
+	long nsec = 0;
+	size_t stride = 0, newlines = 0, count = 0;
+	int n = fscanf(fh, "textfile-index %d %lu %lu %lld %lld %ld %zu %zu %zu",
+		&version, &dev, &ino, &size, &sec, &nsec, &stride, &newlines, &count);
+
+	// The header ends with a newline, which fscanf leaves unread.
+	bool ok = (9 == n) and (1 == version) and ('\n' == fgetc(fh)) and
+		(sb.st_dev == (dev_t) dev) and (sb.st_ino == (ino_t) ino) and
+		(sb.st_size == size) and (sb.st_mtim.tv_sec == sec) and
+		(sb.st_mtim.tv_nsec == nsec) and (0 < stride) and (0 < count);
+
+	std::vector<off_t> offsets;
+	if (ok)
+	{
+		offsets.resize(count);
+		ok = (count == fread(offsets.data(), sizeof(off_t), count, fh));
+	}
+	fclose(fh);
+	if (not ok) return false;
+
+	_stride = stride;
+	_offsets = std::move(offsets);
+	_scanned = size;
+	_newlines = newlines;
+	return true;
+}
+
+// ====================================================================
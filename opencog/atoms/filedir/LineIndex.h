@@ -0,0 +1,91 @@
+/*
+ * opencog/atoms/filedir/LineIndex.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_LINE_INDEX_H
+#define _OPENCOG_LINE_INDEX_H
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * LineIndex - Sparse map from line numbers to byte offsets.
+ *
+ * Records the byte offset of every K'th line of a text file, so that
+ * the start of any line can be found by jumping to the nearest
+ * recorded line, and then skipping at most K-1 lines.
+ *
+ * The index is built in one pass over the file, counting newlines
+ * sixteen bytes at a time. If the file grows, only the new part is
+ * scanned; if it shrinks, the index is rebuilt.
+ *
+ * The index can be saved to, and loaded from, a sidecar file. A saved
+ * index is used only if the file has the same inode, size and mtime
+ * as when the index was saved.
+ *
+ * Line numbers start at one.
+ */
+class LineIndex
+{
+private:
+	size_t _stride;
+
+	// _offsets[i] is the byte offset of line i*_stride + 1.
+	std::vector<off_t> _offsets;
+
+	// Bytes scanned so far, and newlines seen in them.
+	off_t _scanned;
+	size_t _newlines;
+
+	void scan(const char*, size_t);
+
+public:
+	LineIndex(size_t stride = 1024);
+
+	/// Bring the index up to date with the file open on `fd`.
+	/// @throws RuntimeException if the file cannot be read.
+	void update(int fd);
+
+	/**
+	 * Return the byte offset of the start of line `lineno`. If the
+	 * file has fewer lines than that, return the file size (EOF).
+	 * The index must have been update()'d first.
+	 */
+	off_t line_offset(int fd, size_t lineno) const;
+
+	/// Bytes of the file covered by the index.
+	off_t scanned(void) const { return _scanned; }
+
+	/// Number of complete (newline-terminated) lines indexed.
+	size_t num_lines(void) const { return _newlines; }
+
+	bool load(const std::string& path, const struct stat&);
+	bool save(const std::string& path, const struct stat&) const;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_LINE_INDEX_H
@@ -0,0 +1,205 @@
+/*
+ * opencog/atoms/filedir/ParallelReader.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include <opencog/util/exceptions.h>
+
+#include "ParallelReader.h"
+
+using namespace opencog;
+
+// Nominal chunk size. Big enough to amortize the hand-off between
+// threads, small enough to keep the workers evenly loaded.
+#define PAR_CHUNK (1024 * 1024)
+
+// Most finished chunks waiting to be handed out, per worker.
+#define PAR_INFLIGHT 4
+
+ParallelReader::ParallelReader(int fd, off_t start, off_t end,
+                               size_t nthreads, bool ordered) :
+	_map(nullptr),
+	_maplen(0),
+	_start(start),
+	_end(end),
+	_nchunks(0),
+	_ordered(ordered),
+	_window(0),
+	_next_chunk(0),
+	_cancel(false),
+	_taken(0),
+	_cur_seq(0),
+	_cur_line(0),
+	_have_cur(false),
+	_low(0)
+{
+	if (_end <= _start) return;
+
+	// Map from the start of the file, so that offsets are pointers.
+	_maplen = _end;
+	void* map = mmap(nullptr, _maplen, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (MAP_FAILED == map)
+	{
+		int norr = errno;
+		throw RuntimeException(TRACE_INFO,
+			"Unable to map file: %s", strerror(norr));
+	}
+	_map = (const char*) map;
+	madvise(map, _maplen, MADV_SEQUENTIAL);
+
+	_nchunks = (_end - _start + PAR_CHUNK - 1) / PAR_CHUNK;
+	_consumed.resize(_nchunks, false);
+	_chunk_end.resize(_nchunks, _start);
+
+	if (0 == nthreads) nthreads = 1;
+	if (_nchunks < nthreads) nthreads = _nchunks;
+	_window = PAR_INFLIGHT * nthreads;
+	for (size_t i = 0; i < nthreads; i++)
+		_workers.emplace_back(&ParallelReader::work, this);
+}
+
+ParallelReader::~ParallelReader()
+{
+	cancel();
+	for (std::thread& t : _workers)
+		t.join();
+	if (_map)
+		munmap((void*) _map, _maplen);
+}
+
+void ParallelReader::cancel(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		_cancel = true;
+	}
+	_cv_ready.notify_all();
+	_cv_space.notify_all();
+}
+
+// ==============================================================
+
+// The offset of the first line starting at or after `off`.
+off_t ParallelReader::align(off_t off) const
+{
+	if (off <= _start) return _start;
+	if (_end <= off) return _end;
+
+	// If the previous byte is a newline, a line starts right here.
+	const char* p = (const char*) memchr(_map + off - 1, '\n', _end - off + 1);
+	if (nullptr == p) return _end;
+	return (p - _map) + 1;
+}
+
+void ParallelReader::work(void)
+{
+	while (true)
+	{
+		size_t seq = _next_chunk++;
+		if (_nchunks <= seq) return;
+
+		// Wait for room; don't race too far ahead of the reader.
+		{
+			std::unique_lock<std::mutex> lock(_mtx);
+			_cv_space.wait(lock, [&]() {
+				return _cancel or seq < _taken + _window; });
+			if (_cancel) return;
+		}
+
+		off_t nominal = _start + seq * PAR_CHUNK;
+		off_t begin = align(nominal);
+		off_t end = align(std::min(nominal + PAR_CHUNK, _end));
+
+		Chunk chunk;
+		chunk.end = end;
+		const char* p = _map + begin;
+		const char* stop = _map + end;
+		while (p < stop)
+		{
+			const char* nl = (const char*) memchr(p, '\n', stop - p);
+			const char* eol = nl ? nl + 1 : stop;
+			chunk.lines.emplace_back(p, eol - p);
+			p = eol;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_mtx);
+			_done.emplace(seq, std::move(chunk));
+		}
+		_cv_ready.notify_all();
+	}
+}
+
+// ==============================================================
+
+// Caller must hold the lock.
+void ParallelReader::finish_cur(void)
+{
+	if (not _have_cur) return;
+	_have_cur = false;
+	_consumed[_cur_seq] = true;
+	_chunk_end[_cur_seq] = _cur.end;
+	while (_low < _nchunks and _consumed[_low]) _low++;
+}
+
+bool ParallelReader::next(std::string& line)
+{
+	std::unique_lock<std::mutex> lock(_mtx);
+	while (true)
+	{
+		if (_cancel) return false;
+
+		if (_have_cur and _cur_line < _cur.lines.size())
+		{
+			line = std::move(_cur.lines[_cur_line++]);
+			return true;
+		}
+		finish_cur();
+
+		if (_nchunks <= _taken) return false;
+
+		// In order: wait for the very next chunk. Out of order:
+		// take whatever is done.
+		_cv_ready.wait(lock, [&]() {
+			if (_cancel) return true;
+			if (_ordered) return _done.end() != _done.find(_taken);
+			return not _done.empty();
+		});
+		if (_cancel) return false;
+
+		auto it = _ordered ? _done.find(_taken) : _done.begin();
+		_cur_seq = it->first;
+		_cur = std::move(it->second);
+		_done.erase(it);
+		_cur_line = 0;
+		_have_cur = true;
+		_taken++;
+		_cv_space.notify_all();
+	}
+}
+
+off_t ParallelReader::resume_offset(void)
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (0 == _low) return _start;
+	if (_nchunks <= _low) return _end;
+	return _chunk_end[_low - 1];
+}
+
+// ====================================================================
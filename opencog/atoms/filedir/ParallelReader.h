@@ -0,0 +1,145 @@
+/*
+ * opencog/atoms/filedir/ParallelReader.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_PARALLEL_READER_H
+#define _OPENCOG_PARALLEL_READER_H
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * ParallelReader - Split a text file into lines, using many threads.
+ *
+ * The byte range [start, end) of the file is mmapped, and cut into
+ * chunks of about a megabyte. Each worker thread takes the next chunk,
+ * and splits it into lines. A line belongs to the chunk in which it
+ * starts; thus, a worker skips the partial line at the start of its
+ * chunk, and reads past the end of its chunk to finish the last line.
+ *
+ * The lines are handed out, one at a time, by next(). In ordered mode,
+ * chunks are handed out in file order, using the chunk number as a
+ * sequence number; in unordered mode, they are handed out as soon as
+ * they are done. Lines within a chunk are always in file order.
+ *
+ * To bound memory use, workers stall when too many finished chunks
+ * are waiting to be handed out.
+ *
+ * As with any mmap, truncating the file while it is being read will
+ * SIGBUS.
+ */
+class ParallelReader
+{
+private:
+	struct Chunk
+	{
+		off_t end;     // Line-aligned end of the chunk.
+		std::vector<std::string> lines;
+	};
+
+	const char* _map;
+	size_t _maplen;
+	off_t _start;
+	off_t _end;
+	size_t _nchunks;
+	bool _ordered;
+
+	// Most chunks done but not yet handed out. Fixed before the
+	// workers start, so that they need not look at _workers.
+	size_t _window;
+
+	std::vector<std::thread> _workers;
+	std::atomic<size_t> _next_chunk;
+
+	std::mutex _mtx;
+	std::condition_variable _cv_ready;
+	std::condition_variable _cv_space;
+	bool _cancel;
+
+	// Finished chunks, by chunk number, not yet handed out.
+	std::map<size_t, Chunk> _done;
+
+	// Number of chunks handed out so far.
+	size_t _taken;
+
+	// The chunk being handed out, line by line.
+	size_t _cur_seq;
+	Chunk _cur;
+	size_t _cur_line;
+	bool _have_cur;
+
+	// Chunks fully handed out; all those below _low are.
+	std::vector<bool> _consumed;
+	std::vector<off_t> _chunk_end;
+	size_t _low;
+
+	off_t align(off_t) const;
+	void work(void);
+	void finish_cur(void);
+
+public:
+	/**
+	 * Start reading the byte range [start, end) of the file open
+	 * on `fd`, using `nthreads` worker threads.
+	 *
+	 * @throws RuntimeException if the file cannot be mapped.
+	 */
+	ParallelReader(int fd, off_t start, off_t end,
+	               size_t nthreads, bool ordered);
+	~ParallelReader();
+
+	// Prevent copying
+	ParallelReader(const ParallelReader&) = delete;
+	ParallelReader& operator=(const ParallelReader&) = delete;
+
+	/**
+	 * Get the next line, including the trailing newline, if any.
+	 * Blocks until one is ready. Returns false at the end of the
+	 * range, or after cancel().
+	 */
+	bool next(std::string&);
+
+	/// Make all waiting and future calls to next() return false.
+	void cancel(void);
+
+	/// End of the byte range being read.
+	off_t end_offset(void) const { return _end; }
+
+	/**
+	 * An offset from which reading can resume, without skipping any
+	 * line not yet handed out. In unordered mode, some lines after
+	 * this offset may already have been handed out.
+	 */
+	off_t resume_offset(void);
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_PARALLEL_READER_H
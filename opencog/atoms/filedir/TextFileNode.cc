@@ -22,15 +22,24 @@
 
 #include <errno.h>
 #include <string.h> // for strerror()
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
 
 #include <opencog/util/exceptions.h>
 #include <opencog/util/oc_assert.h>
+#include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atoms/value/BoolValue.h>
+#include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atoms/value/StringValue.h>
 #include <opencog/atoms/value/ValueFactory.h>
 
 #include <opencog/sensory/types/atom_types.h>
+#include "FileHasher.h"
 #include "TextFileNode.h"
 
 using namespace opencog;
@@ -39,25 +48,45 @@ TextFileNode::TextFileNode(Type t, const std::string&& url) :
 	TextStreamNode(t, std::move(url)),
 	_fh(nullptr),
 	_tail_mode(false),
-	_watcher()
+	_watcher(),
+	_rotated(false),
+	_par_threads(0),
+	_par_ordered(true),
+	_par_done(false),
+	_codec(Codec::NONE),
+	_zfh(nullptr)
 {
 	OC_ASSERT(nameserver().isA(_type, TEXT_FILE_NODE),
 		"Bad TextFileNode constructor!");
+	addMessage("*-checkpoint-*");
+	addMessage("*-index-*");
+	addMessage("*-seek-*");
+	addMessage("*-parallel-*");
 }
 
 TextFileNode::TextFileNode(const std::string&& url) :
 	TextStreamNode(TEXT_FILE_NODE, std::move(url)),
 	_fh(nullptr),
 	_tail_mode(false),
-	_watcher()
+	_watcher(),
+	_rotated(false),
+	_par_threads(0),
+	_par_ordered(true),
+	_par_done(false),
+	_codec(Codec::NONE),
+	_zfh(nullptr)
 {
+	addMessage("*-checkpoint-*");
+	addMessage("*-index-*");
+	addMessage("*-seek-*");
+	addMessage("*-parallel-*");
 }
 
 TextFileNode::~TextFileNode()
 {
+	stop_parallel();
 	_watcher.remove_watch();
-	if (_fh)
-		fclose(_fh);
+	close_fh();
 }
 
 /// Attempt to open the URL for writing.
@@ -79,12 +108,20 @@ TextFileNode::~TextFileNode()
 /// parameters, via the (Predicate "*-some-parameter-*) message.
 /// Such parameters could control flushing, appending vs clobbering,
 /// tail mode, and so on. XXX TODO.
+///
+/// If checkpointing was enabled (with the *-checkpoint-* message)
+/// then reading resumes from the last checkpointed offset, provided
+/// that the file is still the same file.
+///
+/// Files compressed with gzip or zstd are detected by magic number,
+/// or, if empty, by a .gz or .zst extension.
 
 void TextFileNode::open(const ValuePtr& vty)
 {
 	TextStreamNode::open(vty);
 
-	_fh = nullptr;
+	stop_parallel();
+	close_fh();
 	const std::string& url = get_name();
 
 	if (0 != url.compare(0, 8, "file:///"))
@@ -109,6 +146,19 @@ void TextFileNode::open(const ValuePtr& vty)
 			url.c_str(), ers);
 	}
 
+	_rotated = false;
+	_par_done = false;
+
+	_codec = detect_codec(fileno(_fh), pathstr);
+	if (Codec::NONE != _codec)
+		open_compressed();
+	else
+		restore_checkpoint();
+
+	// Any index in memory may be for an older version of the file.
+	if (_index)
+		_index = std::make_unique<LineIndex>();
+
 	// Setup inotify for tail mode
 	if (_tail_mode)
 	{
@@ -129,18 +179,77 @@ void TextFileNode::close(const ValuePtr&)
 {
 	std::lock_guard<std::mutex> lock(_mtx);
 	_watcher.remove_watch();
-	if (_fh)
-		fclose(_fh);
-	_fh = nullptr;
+	save_checkpoint();
+	stop_parallel();
+	close_fh();
 	_tail_mode = false;
 }
 
 void TextFileNode::barrier(AtomSpace* ignore)
 {
-	if (_fh)
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (nullptr == _fh) return;
+
+	if (_deflater)
+		_deflater->flush();
+	else
 		fflush(_fh);
+	if (not _ckpt_path.empty() and not save_checkpoint())
+	{
+		int norr = errno;
+		throw RuntimeException(TRACE_INFO,
+			"Unable to write checkpoint \"%s\": %s\n",
+			_ckpt_path.c_str(), strerror(norr));
+	}
 }
 
+// ==============================================================
+// Compressed files.
+
+// Swap the freshly opened file for the output of a decompressor.
+void TextFileNode::open_compressed(void)
+{
+	if (not codec_supported(_codec))
+	{
+		fclose(_fh);
+		_fh = nullptr;
+		throw RuntimeException(TRACE_INFO,
+			"Unable to open URL \"%s\"\nCompiled without %s support\n",
+			_name.c_str(), codec_name(_codec));
+	}
+
+	_zfh = _fh;
+	_fh = nullptr;
+	FILE* rd = nullptr;
+	try
+	{
+		_inflater = std::make_unique<Decompressor>(fileno(_zfh), _codec, &rd);
+	}
+	catch (...)
+	{
+		fclose(_zfh);
+		_zfh = nullptr;
+		throw;
+	}
+	_fh = rd;
+}
+
+// Caller must hold the lock, if there is any chance of a race.
+// Finishes off any compressed output, and stops any decompressor.
+void TextFileNode::close_fh(void) const
+{
+	_deflater = nullptr;
+	if (_fh)
+		fclose(_fh);
+	_fh = nullptr;
+	_inflater = nullptr;
+	if (_zfh)
+		fclose(_zfh);
+	_zfh = nullptr;
+}
+
+// ==============================================================
+
 bool TextFileNode::connected(void) const
 {
 	return (nullptr != _fh);
@@ -175,17 +284,476 @@ void TextFileNode::follow(const ValuePtr& value)
 	}
 }
 
+// ==============================================================
+// Checkpointing of the read offset.
+//
+// The checkpoint is a one-line sidecar file, holding the device and
+// inode of the file being read, the offset, the file size, and a
+// fingerprint of the first few kilobytes of the file. On resume,
+// the offset is used only if the file is still the same file: same
+// inode, not shrunk, and with the same leading bytes. The last check
+// catches copy-truncate log rotation, which keeps the inode, but
+// replaces the contents. If anything does not match, reading starts
+// over from the beginning.
+
+#define CKPT_HEAD 4096
+
+static uint64_t head_hash(int fd, off_t upto)
+{
+	char buf[CKPT_HEAD];
+	size_t want = std::min((off_t) CKPT_HEAD, upto);
+	ssize_t got = pread(fd, buf, want, 0);
+	if (got < 0) got = 0;
+	return FileHasher::xxh64(buf, got, 0);
+}
+
+void TextFileNode::set_checkpoint(const ValuePtr& value)
+{
+	if (value->is_type(BOOL_VALUE))
+	{
+		const std::vector<bool>& bv = BoolValueCast(value)->value();
+		if (0 < bv.size() and bv[0])
+			_ckpt_path = get_name().substr(7) + ".offset";
+		else
+			_ckpt_path.clear();
+		return;
+	}
+
+	if (value->is_type(STRING_VALUE))
+	{
+		_ckpt_path = StringValueCast(value)->value()[0];
+		return;
+	}
+
+	if (value->is_type(NODE))
+	{
+		_ckpt_path = HandleCast(value)->get_name();
+		return;
+	}
+
+	throw RuntimeException(TRACE_INFO,
+		"TextFileNode: checkpoint expects BoolValue, StringValue or Node;"
+		" got %s\n", value->to_string().c_str());
+}
+
+// Caller must hold the lock. Returns false, with errno set, if the
+// checkpoint could not be written.
+bool TextFileNode::save_checkpoint(void) const
+{
+	if (_ckpt_path.empty() or nullptr == _fh) return true;
+
+	// There is no meaningful offset in a decompressed stream.
+	if (_inflater) return true;
+
+	int fd = fileno(_fh);
+	struct stat sb;
+	off_t off = _par ? _par->resume_offset() : ftello(_fh);
+	if (off < 0 or fstat(fd, &sb)) return false;
+
+	// Write-then-rename, so that a crash never leaves a torn file.
+	std::string tmp = _ckpt_path + ".tmp";
+	FILE* ck = fopen(tmp.c_str(), "w");
+	if (nullptr == ck) return false;
+
+	fprintf(ck, "textfile-offset 1 %lu %lu %lld %lld %016llx\n",
+		(unsigned long) sb.st_dev, (unsigned long) sb.st_ino,
+		(long long) off, (long long) sb.st_size,
+		(unsigned long long) head_hash(fd, off));
+
+	bool ok = (0 == fflush(ck)) and (0 == fsync(fileno(ck)));
+	ok = (0 == fclose(ck)) and ok;
+	if (ok)
+		ok = (0 == rename(tmp.c_str(), _ckpt_path.c_str()));
+	return ok;
+}
+
+void TextFileNode::restore_checkpoint(void)
+{
+	if (_ckpt_path.empty()) return;
+
+	// No checkpoint yet; this is the first run.
+	FILE* ck = fopen(_ckpt_path.c_str(), "r");
+	if (nullptr == ck) return;
+
+	int version = 0;
+	unsigned long dev = 0, ino = 0;
+	long long off = 0, size = 0;
+	unsigned long long hash = 0;
+	int n = fscanf(ck, "textfile-offset %d %lu %lu %lld %lld %llx",
+		&version, &dev, &ino, &off, &size, &hash);
+	fclose(ck);
+	if (6 != n or 1 != version) return;
+
+	int fd = fileno(_fh);
+	struct stat sb;
+	if (fstat(fd, &sb)) return;
+
+	// A different file: it was rotated while we were away.
+	if (sb.st_dev != (dev_t) dev or sb.st_ino != (ino_t) ino) return;
+
+	// Shrunk, or same size but different contents: it was truncated
+	// (and possibly rewritten) while we were away.
+	if (sb.st_size < size or sb.st_size < off) return;
+	if (head_hash(fd, off) != hash) return;
+
+	fseeko(_fh, off, SEEK_SET);
+}
+
+
+// ==============================================================
+// Seeking.
+//
+// The *-index-* message turns on the line index: (BoolValue #t) keeps
+// it in memory only, while a StringValue names a sidecar file to keep
+// it in. Either way, the index is built when first needed, by seeking
+// to a line number. The *-seek-* message takes either a line number,
+// as a NumberNode or FloatValue, or a (unit, number) pair, with unit
+// being "line" or "byte". Lines are numbered starting with one.
+
+void TextFileNode::set_index(const ValuePtr& value)
+{
+	if (value->is_type(BOOL_VALUE))
+	{
+		const std::vector<bool>& bv = BoolValueCast(value)->value();
+		_index_path.clear();
+		if (0 < bv.size() and bv[0])
+		{
+			if (nullptr == _index)
+				_index = std::make_unique<LineIndex>();
+		}
+		else
+			_index = nullptr;
+		return;
+	}
+
+	std::string path;
+	if (value->is_type(STRING_VALUE))
+		path = StringValueCast(value)->value()[0];
+	else if (value->is_type(NODE))
+		path = HandleCast(value)->get_name();
+	else
+		throw RuntimeException(TRACE_INFO,
+			"TextFileNode: index expects BoolValue, StringValue or Node;"
+			" got %s\n", value->to_string().c_str());
+
+	if (path != _index_path)
+		_index = nullptr;
+	_index_path = path;
+	if (nullptr == _index)
+		_index = std::make_unique<LineIndex>();
+}
+
+// Caller must hold the lock.
+void TextFileNode::update_index(void)
+{
+	if (nullptr == _index)
+		_index = std::make_unique<LineIndex>();
+
+	fflush(_fh);
+	int fd = fileno(_fh);
+	struct stat sb;
+	if (fstat(fd, &sb))
+	{
+		int norr = errno;
+		throw RuntimeException(TRACE_INFO,
+			"Unable to index \"%s\": %s\n", _name.c_str(), strerror(norr));
+	}
+
+	// A fresh index; perhaps an earlier run saved one.
+	if (0 == _index->scanned() and not _index_path.empty())
+		_index->load(_index_path, sb);
+
+	off_t before = _index->scanned();
+	_index->update(fd);
+
+	// Saving is an optimization; if it fails, just scan next time.
+	if (not _index_path.empty() and before != _index->scanned() and
+	    0 == fstat(fd, &sb) and sb.st_size == _index->scanned())
+		_index->save(_index_path, sb);
+}
+
+void TextFileNode::seek(const ValuePtr& value)
+{
+	// Decode the unit and the position.
+	bool by_line = true;
+	double pos;
+	ValueSeq args;
+	if (value->is_type(LINK_VALUE))
+		args = LinkValueCast(value)->value();
+	else if (value->is_link())
+		for (const Handle& h : HandleCast(value)->getOutgoingSet())
+			args.push_back(h);
+
+	if (2 == args.size())
+	{
+		std::string unit;
+		if (args[0]->is_type(NODE))
+			unit = HandleCast(args[0])->get_name();
+		else if (args[0]->is_type(STRING_VALUE))
+			unit = StringValueCast(args[0])->value()[0];
+
+		if (0 == unit.compare("byte"))
+			by_line = false;
+		else if (unit.compare("line"))
+			throw RuntimeException(TRACE_INFO,
+				"TextFileNode: unknown seek unit \"%s\"\n", unit.c_str());
+		pos = get_number(args[1]);
+	}
+	else
+		pos = get_number(value);
+
+	if (pos < 0)
+		throw RuntimeException(TRACE_INFO,
+			"TextFileNode: cannot seek to negative position %f\n", pos);
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (nullptr == _fh)
+		throw RuntimeException(TRACE_INFO,
+			"TextFile not open: URI \"%s\"\n", _name.c_str());
+	if (_inflater)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot seek in compressed file: URI \"%s\"\n", _name.c_str());
+
+	off_t off = (off_t) pos;
+	if (by_line)
+	{
+		update_index();
+		off = _index->line_offset(fileno(_fh), (size_t) pos);
+	}
+
+	// Any parallel read starts over, from the new position.
+	stop_parallel();
+	_par_done = false;
+
+	clearerr(_fh);
+	if (fseeko(_fh, off, SEEK_SET))
+	{
+		int norr = errno;
+		throw RuntimeException(TRACE_INFO,
+			"Unable to seek \"%s\": %s\n", _name.c_str(), strerror(norr));
+	}
+}
+
+// ==============================================================
+// Parallel reading.
+//
+// The *-parallel-* message takes the number of threads, as a
+// NumberNode or FloatValue, or a (number, order) pair, with order
+// being "ordered" (the default) or "unordered". (BoolValue #t) uses
+// one thread per CPU. Zero threads, or (BoolValue #f), turns it off.
+// The threads are started on the next read, and cover the file from
+// the current position up to its size at that time.
+
+void TextFileNode::set_parallel(const ValuePtr& value)
+{
+	size_t nthreads = 0;
+	bool ordered = true;
+
+	ValueSeq args;
+	if (value->is_type(LINK_VALUE))
+		args = LinkValueCast(value)->value();
+	else if (value->is_link())
+		for (const Handle& h : HandleCast(value)->getOutgoingSet())
+			args.push_back(h);
+
+	if (value->is_type(BOOL_VALUE))
+	{
+		const std::vector<bool>& bv = BoolValueCast(value)->value();
+		if (0 < bv.size() and bv[0])
+			nthreads = std::thread::hardware_concurrency();
+	}
+	else if (2 == args.size())
+	{
+		std::string order;
+		if (args[1]->is_type(NODE))
+			order = HandleCast(args[1])->get_name();
+		else if (args[1]->is_type(STRING_VALUE))
+			order = StringValueCast(args[1])->value()[0];
+
+		if (0 == order.compare("unordered"))
+			ordered = false;
+		else if (order.compare("ordered"))
+			throw RuntimeException(TRACE_INFO,
+				"TextFileNode: unknown parallel order \"%s\"\n",
+				order.c_str());
+		nthreads = (size_t) std::max(0.0, get_number(args[0]));
+	}
+	else
+		nthreads = (size_t) std::max(0.0, get_number(value));
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (nthreads != _par_threads or ordered != _par_ordered)
+	{
+		stop_parallel();
+		_par_done = false;
+	}
+	_par_threads = nthreads;
+	_par_ordered = ordered;
+}
+
+// Caller must hold the lock. Readers blocked in the parallel reader
+// are woken up; the last one out destroys it.
+void TextFileNode::stop_parallel(void) const
+{
+	if (nullptr == _par) return;
+
+	// Pick up, sequentially, where the threads left off.
+	if (_fh)
+	{
+		clearerr(_fh);
+		fseeko(_fh, _par->resume_offset(), SEEK_SET);
+	}
+	_par->cancel();
+	_par = nullptr;
+}
+
+// Override setValue to intercept the TextFileNode-specific messages.
+void TextFileNode::setValue(const Handle& key, const ValuePtr& value)
+{
+	if (PREDICATE_NODE == key->get_type())
+	{
+		static constexpr uint32_t p_checkpoint =
+			dispatch_hash("*-checkpoint-*");
+		static constexpr uint32_t p_index =
+			dispatch_hash("*-index-*");
+		static constexpr uint32_t p_seek =
+			dispatch_hash("*-seek-*");
+		static constexpr uint32_t p_parallel =
+			dispatch_hash("*-parallel-*");
+
+		const std::string& pred = key->get_name();
+		switch (dispatch_hash(pred.c_str()))
+		{
+			case p_checkpoint:
+				set_checkpoint(value);
+				return;
+			case p_index:
+				set_index(value);
+				return;
+			case p_seek:
+				seek(value);
+				return;
+			case p_parallel:
+				set_parallel(value);
+				return;
+			default:
+				break;
+		}
+	}
+
+	// Everything else goes to the base class.
+	TextStreamNode::setValue(key, value);
+}
+
+// ==============================================================
+// Log rotation and truncation, while following.
+
+// If the file got shorter than where we are, it was truncated;
+// start over at the beginning.
+void TextFileNode::rewind_if_truncated(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (nullptr == _fh) return;
+
+	struct stat sb;
+	off_t off = ftello(_fh);
+	if (0 == fstat(fileno(_fh), &sb) and sb.st_size < off)
+		fseeko(_fh, 0, SEEK_SET);
+}
+
+// A file that was removed while open; it is still there, with no
+// name left, until it is closed.
+bool TextFileNode::unlinked(FILE* fh)
+{
+	struct stat sb;
+	return 0 == fstat(fileno(fh), &sb) and 0 == sb.st_nlink;
+}
+
+// Called after the rest of a renamed or deleted file has been read.
+// Switch over to whatever file now lives at the original path. If
+// there isn't one yet, watch the directory until it shows up.
+// Returns true if a new file was opened.
+bool TextFileNode::reopen(void) const
+{
+	std::string path = get_name().substr(7);
+
+	struct stat sb;
+	if (stat(path.c_str(), &sb))
+	{
+		std::string dir = path.substr(0, path.rfind('/'));
+		if (dir.empty()) dir = "/";
+		if (_watcher.watched_path() != dir)
+			_watcher.add_watch(dir);
+		return false;
+	}
+
+	FILE* fh = fopen(path.c_str(), "a+");
+	if (nullptr == fh) return false;
+
+	_watcher.add_watch(path);
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (nullptr == _fh)
+	{
+		// Closed while we were busy.
+		fclose(fh);
+		return false;
+	}
+	fclose(_fh);
+	_fh = fh;
+	_rotated = false;
+	if (_index)
+		_index = std::make_unique<LineIndex>();
+	return true;
+}
+
+// ==============================================================
+
 // This will read one line from the text file, and return that line.
 // This is a line-oriented, buffered interface.
-// In tail mode, waits for new data using inotify when EOF is reached.
-std::string TextFileNode::do_read(void) const
+// In tail mode, waits for new data using inotify when EOF is reached;
+// when run asynchronously, no thread is held up while waiting. The
+// wait ends with ReadTimeout, if a read timeout was set.
+AsyncTask<std::string> TextFileNode::async_do_read(void) const
 {
 	static const std::string empty_string;
+	Deadline dl(read_deadline());
 
 	// Check if file is open (with lock)
+	std::shared_ptr<ParallelReader> par;
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		if (nullptr == _fh) co_return empty_string;
+
+		// Start the threads on the first read in parallel mode.
+		if (0 < _par_threads and not _par_done and nullptr == _par and
+		    nullptr == _inflater)
+		{
+			fflush(_fh);
+			struct stat sb;
+			off_t off = ftello(_fh);
+			if (0 <= off and 0 == fstat(fileno(_fh), &sb))
+				_par = std::make_shared<ParallelReader>(fileno(_fh),
+					off, sb.st_size, _par_threads, _par_ordered);
+		}
+		par = _par;
+	}
+
+	// Hand out the lines found by the threads. When they are all
+	// gone, carry on reading one line at a time, from where the
+	// threads stopped.
+	if (par)
 	{
+		std::string line;
+		if (par->next(line)) co_return line;
+
 		std::lock_guard<std::mutex> lock(_mtx);
-		if (nullptr == _fh) return empty_string;
+		if (_par == par)
+		{
+			stop_parallel();
+			_par_done = true;
+		}
+		if (nullptr == _fh) co_return empty_string;
 	}
 
 #define BUFSZ 4096
@@ -202,10 +770,10 @@ std::string TextFileNode::do_read(void) const
 			std::lock_guard<std::mutex> lock(_mtx);
 
 			// Check if closed while we were waiting
-			if (nullptr == _fh) return empty_string;
+			if (nullptr == _fh) co_return empty_string;
 
 			fh_copy = _fh;
-			tail_mode_copy = _tail_mode;
+			tail_mode_copy = _tail_mode and nullptr == _inflater;
 		}
 
 		// No lock; fgets is thread-safe for different files.
@@ -224,26 +792,56 @@ std::string TextFileNode::do_read(void) const
 			// as EOF. So this needs fixing. I guess!?
 			// Also what about CRLF? I dunno. Ignore, I guess.
 			str.resize(strlen(buff));
-			return str;
+			co_return str;
 		}
 
 		// Hit EOF
 		if (!tail_mode_copy)
 		{
 			// Normal mode: close and end stream
-			std::lock_guard<std::mutex> lock(_mtx);
-			if (_fh)  // Check again in case another thread closed it
+			std::string err;
 			{
-				fclose(_fh);
-				_fh = nullptr;
+				std::lock_guard<std::mutex> lock(_mtx);
+				if (_fh)  // Check again in case another thread closed it
+				{
+					if (_inflater) err = _inflater->error();
+					save_checkpoint();
+					close_fh();
+				}
 			}
-			return empty_string;
+			if (not err.empty())
+				throw RuntimeException(TRACE_INFO,
+					"Unable to decompress \"%s\": %s\n",
+					_name.c_str(), err.c_str());
+			co_return empty_string;
 		}
 
 		// Tail mode: wait for file modification
 		clearerr(fh_copy);  // Clear EOF indicator
 
-		// Wait for inotify event (WITHOUT holding lock - this blocks!)
+		// Removed, while we still hold it open; the kernel keeps the
+		// inode, and never sends IN_DELETE_SELF.
+		if (not _rotated and unlinked(fh_copy))
+			_rotated = true;
+
+		// The old file has been drained; move on to the new one.
+		if (_rotated)
+		{
+			if (reopen()) continue;
+		}
+		else
+			rewind_if_truncated();
+
+		// Wait for the inotify fd to become readable. On a timeout,
+		// go around again, to see if the file was closed meanwhile.
+		int wfd = _watcher.get_fd();
+		if (0 <= wfd and not _watcher.has_pending())
+		{
+			if (dl.expired()) throw ReadTimeout();
+			if (0 == co_await fd_ready(wfd, EPOLLIN, dl)) continue;
+		}
+
+		// Pick up the inotify event (WITHOUT holding lock)
 		std::pair<uint32_t, std::string> event;
 		try
 		{
@@ -253,11 +851,7 @@ std::string TextFileNode::do_read(void) const
 		{
 			// Error - try to close and return
 			std::lock_guard<std::mutex> lock(_mtx);
-			if (_fh)
-			{
-				fclose(_fh);
-				_fh = nullptr;
-			}
+			close_fh();
 			_watcher.remove_watch();
 			throw;
 		}
@@ -266,13 +860,60 @@ std::string TextFileNode::do_read(void) const
 		if (event.first == 0 && event.second.empty())
 		{
 			// Watch was closed - return empty to unblock
-			return empty_string;
+			co_return empty_string;
 		}
 
+		// File was renamed or deleted, e.g. by logrotate. Keep
+		// reading it until EOF; whoever was writing it might not
+		// have noticed yet.
+		if (event.first & (IN_MOVE_SELF | IN_DELETE_SELF))
+			_rotated = true;
+
 		// File was modified - loop back and try reading again
 	}
 }
 
+// Ready unless following a file, at its end, with nothing new. This
+// is called from other threads than the reader; it must not move the
+// stream, and must not take the inotify events from the reader.
+bool TextFileNode::ready(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (nullptr == _fh or _par) return true;
+	if (not _tail_mode or _inflater or _rotated) return true;
+
+#ifdef _GNU_SOURCE
+	if (_fh->_IO_read_ptr < _fh->_IO_read_end) return true;
+#endif
+
+	// Take the events first, then look at the size; anything written
+	// after the look makes the inotify fd readable again.
+	uint32_t mask = _watcher.collect_events();
+
+	// Renamed or deleted, by logrotate or the like; the reader will
+	// move on to the new file. A removed file that is still open
+	// shows up below, with no links left.
+	if (mask & (IN_MOVE_SELF | IN_DELETE_SELF)) return true;
+
+	struct stat sb;
+	off_t off = ftello(_fh);
+	if (0 > off or 0 != fstat(fileno(_fh), &sb)) return true;
+	if (0 == sb.st_nlink) return true;
+	return off != sb.st_size;
+}
+
+int TextFileNode::ready_fd(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (not _tail_mode or _inflater) return -1;
+	return _watcher.get_fd();
+}
+
+std::string TextFileNode::do_read(void) const
+{
+	return sync_wait(async_do_read());
+}
+
 // ==============================================================
 // Write stuff to a file.
 
@@ -282,6 +923,16 @@ void TextFileNode::do_write(const std::string& str)
 		throw RuntimeException(TRACE_INFO,
 			"TextFile not open: URI \"%s\"\n", _name.c_str());
 
+	// Compressed output is flushed at the barrier, or at close;
+	// flushing after every line would wreck the compression ratio.
+	if (Codec::NONE != _codec)
+	{
+		if (nullptr == _deflater)
+			_deflater = std::make_unique<Compressor>(fileno(_zfh), _codec);
+		_deflater->write(str);
+		return;
+	}
+
 	fprintf(_fh, "%s", str.c_str());
 
 	// flush, for now. This helps make the demos less confusing.
@@ -24,9 +24,13 @@
 #define _OPENCOG_TEXT_FILE_NODE_H
 
 #include <stdio.h>
+#include <memory>
 #include <mutex>
 #include <opencog/atoms/sensory/TextStreamNode.h>
+#include "Compression.h"
 #include "FileWatcher.h"
+#include "LineIndex.h"
+#include "ParallelReader.h"
 
 namespace opencog
 {
@@ -44,11 +48,37 @@ namespace opencog
  * blocking read) in one thread is to call close() from a different
  * thread.
  *
+ * The read position can be checkpointed to a small sidecar file, so
+ * that a restarted process picks up where the last one left off,
+ * instead of reprocessing the whole file. In follow mode, truncation
+ * and logrotate-style renames and removals are detected; after
+ * either, the rest of the old file is read, and then the new file at
+ * the same path is opened and followed.
+ *
+ * Reading can be started at any line or byte offset, with the seek
+ * message. Seeking by line uses a sparse index of line offsets, built
+ * on first use, and optionally kept in a sidecar file, so that later
+ * runs need not scan the file again.
+ *
+ * Large files can be read with several threads at once, with the
+ * parallel message. The part of the file present when reading starts
+ * is split into line-aligned chunks, which the threads read and cut
+ * into lines. Lines come out in file order, or, if asked for, in
+ * whatever order the chunks get done. After that, reading carries on
+ * one line at a time, as usual; so following still works.
+ *
+ * Files compressed with gzip or zstd are recognized by their magic
+ * number, and decompressed on the fly, by a thread of its own; text
+ * written to them is compressed, and appended. Seeking, parallel
+ * reading, checkpointing and following are not available for
+ * compressed files.
+ *
+ * Lines are returned with their trailing newline (or CRLF), unless
+ * the *-normalize-* message asks for them to be trimmed.
+ *
  * This is experimental.
  * Unsolved issues:
- * -- Fails to trim newline at end of line.
  * -- Fails to handle lines longer than 4096
- * -- Fails to trim CRLF, if it's a DOS file.
  */
 class TextFileNode
 	: public TextStreamNode
@@ -59,6 +89,42 @@ protected:
 	mutable bool _tail_mode;
 	mutable FileWatcher _watcher;
 
+	// Checkpointing of the read offset. Empty if not checkpointing.
+	std::string _ckpt_path;
+	void set_checkpoint(const ValuePtr&);
+	bool save_checkpoint(void) const;
+	void restore_checkpoint(void);
+
+	// Set when the followed file was renamed or deleted.
+	mutable bool _rotated;
+	bool reopen(void) const;
+	void rewind_if_truncated(void) const;
+	static bool unlinked(FILE*);
+
+	// Sparse line index, for seeking by line number.
+	mutable std::unique_ptr<LineIndex> _index;
+	std::string _index_path;
+	void set_index(const ValuePtr&);
+	void update_index(void);
+	void seek(const ValuePtr&);
+
+	// Parallel reading. No threads if _par_threads is zero.
+	size_t _par_threads;
+	bool _par_ordered;
+	mutable std::shared_ptr<ParallelReader> _par;
+	mutable bool _par_done;
+	void set_parallel(const ValuePtr&);
+	void stop_parallel(void) const;
+
+	// Compressed files. If compressed, _fh is the decompressed side,
+	// and _zfh is the file itself.
+	Codec _codec;
+	mutable FILE* _zfh;
+	mutable std::unique_ptr<Decompressor> _inflater;
+	mutable std::unique_ptr<Compressor> _deflater;
+	void open_compressed(void);
+	void close_fh(void) const;
+
 	virtual void do_write(const std::string&);
 
 	virtual void open(const ValuePtr&);
@@ -68,12 +134,17 @@ protected:
 	virtual void barrier(AtomSpace* = nullptr);
 	virtual void follow(const ValuePtr&);
 	virtual std::string do_read(void) const;
+	virtual AsyncTask<std::string> async_do_read(void) const;
+	virtual bool ready(void) const;
+	virtual int ready_fd(void) const;
 
 public:
 	TextFileNode(const std::string&&);
 	TextFileNode(Type t, const std::string&&);
 	virtual ~TextFileNode();
 
+	virtual void setValue(const Handle& key, const ValuePtr& value);
+
 	static Handle factory(const Handle&);
 };
 
@@ -279,6 +279,26 @@ int IRC::message_loop()
 	return 0;
 }
 
+// Handle whatever has arrived on the socket, with a single recv().
+// For use with an external event loop, when the socket is readable.
+// Returns non-zero when the connection is gone.
+int IRC::message_step()
+{
+	char buffer[1024];
+	int ret_len;
+
+	if (not connected)
+		return 1;
+
+	ret_len=recv(irc_socket, buffer, 1023, 0);
+	if (ret_len==SOCKET_ERROR || !ret_len)
+		return 1;
+
+	buffer[ret_len]='\0';
+	split_to_replies(buffer);
+	return 0;
+}
+
 void IRC::split_to_replies(char* data)
 {
 	char* p;
@@ -78,6 +78,8 @@ public:
 	int raw(const char* data);
 	void hook_irc_command(const char* cmd_name, int (*function_ptr)(const char*, irc_reply_data*, void*));
 	int message_loop();
+	int message_step();
+	int get_socket(void) const { return irc_socket; }
 	int is_op(const char* channel, const char* nick);
 	int is_voice(const char* channel, const char* nick);
 	const char* current_nick(void);
@@ -35,13 +35,14 @@
 
 #include <errno.h>
 #include <string.h> // for strerror()
-#include <unistd.h> // for sleep()
+#include <sys/epoll.h>
 
 using namespace opencog;
 
 IRChatNode::IRChatNode(Type t, const std::string&& str) :
 	TextStreamNode(t, std::move(str)),
-	_conn(nullptr)
+	_conn(nullptr),
+	_watch(0)
 {
 	OC_ASSERT(nameserver().isA(_type, I_R_CHAT_NODE),
 		"Bad IRChatNode constructor!");
@@ -49,7 +50,8 @@ IRChatNode::IRChatNode(Type t, const std::string&& str) :
 
 IRChatNode::IRChatNode(const std::string&& str) :
 	TextStreamNode(I_R_CHAT_NODE, std::move(str)),
-	_conn(nullptr)
+	_conn(nullptr),
+	_watch(0)
 {
 }
 
@@ -121,7 +123,7 @@ void IRChatNode::open(const ValuePtr& vurl)
 		_port = atoi(_uri.substr(col+1, sls-col-1).c_str());
 	}
 
-	_qvp = createQueueValue();
+	_qvp = make_queue();
 
 	_conn = new IRC;
 	_conn->context = this;
@@ -170,8 +172,9 @@ void IRChatNode::open(const ValuePtr& vurl)
 	// 706 - end of reply to HELP command
 	// MODE - read-write modes
 
-	// Run I/O loop in it's own thread.
-	_loop = new std::thread(&IRChatNode::looper, this);
+	// Log in on a thread of our own; open() does not wait for it.
+	std::lock_guard<std::mutex> lock(_mtx);
+	_login_thread = std::thread(&IRChatNode::login, this);
 }
 
 void IRChatNode::close(const ValuePtr& ignore)
@@ -179,21 +182,40 @@ void IRChatNode::close(const ValuePtr& ignore)
 	printf("Called IRChatNode::close\n");
 
 	if (nullptr == _conn) return;
-	_cancel = true;
 
-	// We can send a quit, but then we never actually
-	// wait for the quit reply. So .. whatever.
+	uint64_t watch;
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		_cancel = true;
+		watch = _watch;
+		_watch = 0;
+	}
+	_login_cv.notify_all();
+
+	// This waits for a callback that is running right now; after
+	// it, no new login is started.
+	if (watch) Executor::instance().unwatch(watch);
+
+	// A login waiting to retry wakes up; one that is connecting
+	// is waited for.
+	std::thread login;
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		login = std::move(_login_thread);
+	}
+	if (login.joinable()) login.join();
+
+	// Nothing else is touching the connection now. We can send a
+	// quit, but then we never actually wait for the quit reply.
+	// So .. whatever.
 	_conn->quit("Adios");
 	_conn->disconnect();
 
-	_loop->join();
-	delete _loop;
-	_loop = nullptr;
-
 	delete _conn;
 	_conn = nullptr;
 
 	_qvp = nullptr;
+	notify();
 }
 
 bool IRChatNode::connected(void) const
@@ -203,39 +225,72 @@ bool IRChatNode::connected(void) const
 
 // ==================================================================
 
-// Infinite loop.
-// XXX Needs major redesign. Works for now.
-void IRChatNode::looper(void)
+// Connecting to the server can block for a long time, in DNS, or in
+// the TCP connect, so logging in runs on a thread of its own, rather
+// than tying up a worker of the shared executor. After that, there is
+// no thread: the socket is watched, and incoming messages are handled
+// whenever it is readable. When the IRC network burps and closes our
+// connection, log in again, a bit later.
+//
+// _mtx guards _watch, _login_thread and _cancel, so that close()
+// either sees what was set up here, or else this sees that close()
+// was called.
+
+#define IRC_RETRY_DELAY std::chrono::seconds(20)
+
+void IRChatNode::login(void)
 {
 	// Defaults
 	const char* user = "botski";
 	const char* name = "Atomese Sensory Node";
 	const char* pass = "";
 
-	// Loop forever. When the IRC network burps and closes our
-	// connection, just log in again.
-	while (true)
+	std::unique_lock<std::mutex> lock(_mtx);
+	while (not _cancel)
 	{
+		lock.unlock();
 		printf("Joining network=%s port=%d nick=%s user=%s\n",
 			_host.c_str(), _port, _nick.c_str(), user);
 
 		int rc = _conn->start(_host.c_str(), _port, _nick.c_str(),
 		                      user, name, pass);
-		if (rc)
-			throw RuntimeException(TRACE_INFO,
-				"Unable to connect (%d) to URL \"%s\"\n", rc, _uri.c_str());
-
-		rc = _conn->message_loop();
+		lock.lock();
 		if (_cancel) return;
 
-		if (rc) perror("IRChatNode Error: Socket error");
+		if (0 == rc)
+		{
+			_watch = Executor::instance().watch(_conn->get_socket(),
+				EPOLLIN, [this](uint32_t) { on_readable(); },
+				ExecOptions("irc"));
+			return;
+		}
 
-		// For now, assume we got kicked and want to spawn again.
-		_conn->disconnect();
-		sleep(20);
+		printf("IRChatNode: Unable to connect (%d) to URL \"%s\"; "
+			"will retry\n", rc, _uri.c_str());
+		_login_cv.wait_for(lock, IRC_RETRY_DELAY,
+			[this]() { return _cancel; });
 	}
 }
 
+void IRChatNode::on_readable(void)
+{
+	int rc = _conn->message_step();
+	if (0 == rc) return;
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (_cancel) return;
+
+	perror("IRChatNode Error: Socket error");
+
+	// For now, assume we got kicked and want to spawn again. The
+	// last login thread is done; it ended by setting up this watch.
+	Executor::instance().unwatch(_watch);
+	_watch = 0;
+	_conn->disconnect();
+	if (_login_thread.joinable()) _login_thread.join();
+	_login_thread = std::thread(&IRChatNode::login, this);
+}
+
 // ==================================================================
 // thunks
 
@@ -337,7 +392,7 @@ printf(">>> IRC msg from %s to %s =%s\n", ird->nick, ird->target, params);
 		msg.push_back(createStringValue(start));
 
 	ValuePtr svp(createLinkValue(msg));
-	_qvp->add(std::move(svp));
+	enqueue(_qvp, std::move(svp));
 	return 0;
 }
 
@@ -358,15 +413,22 @@ ValuePtr IRChatNode::read(void) const
 {
 	if (nullptr == _conn) return createVoidValue();
 
+	// Replayed items come first; they were read before these.
+	ValuePtr rvp(wal_replay_next());
+	if (rvp) return rvp;
+
 	// XXX When is it ever closed ???
 	if (_qvp->is_closed() and 0 == _qvp->size())
 		return createVoidValue();
 
+	// With a read timeout, give up after a while.
+	if (0 < _timeout_ms) return wal_dequeued(wait_queue(_qvp));
+
 	// Read one at a time.
 	// This will hang, until there's something to read.
 	try
 	{
-		return _qvp->remove();
+		return wal_dequeued(_qvp->remove());
 	}
 	catch (typename concurrent_queue<ValuePtr>::Canceled& e)
 	{}
@@ -375,10 +437,38 @@ ValuePtr IRChatNode::read(void) const
 	throw RuntimeException(TRACE_INFO, "Unexpected close");
 }
 
+// Chat lines are queued by on_readable(); nothing here to co_await.
+AsyncTask<ValuePtr> IRChatNode::async_read(void) const
+{
+	co_return read();
+}
+
+// Ready when a chat line is queued, or when closed. The eventfd is
+// rung by got_privmsg() for every line queued.
+bool IRChatNode::ready(void) const
+{
+	if (nullptr == _conn) return true;
+	QueueValuePtr qvp(_qvp);
+	if (nullptr == qvp or _replaying) return true;
+	clear_notify();
+	return 0 < qvp->size() or qvp->is_closed();
+}
+
+int IRChatNode::ready_fd(void) const
+{
+	return notify_fd();
+}
+
 ValuePtr IRChatNode::stream(void) const
 {
 	if (nullptr == _conn) return createVoidValue();
 
+	// Taken straight off the queue, items would not be counted off
+	// for *-ack-*, nor captured, nor conflated; so, if need be, go
+	// through read().
+	if (std::atomic_load(&_queue_wal) or std::atomic_load(&_capture)
+	    or _conflate)
+		return StreamNode::stream();
 	return _qvp;
 }
 
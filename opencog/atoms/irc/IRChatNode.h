@@ -23,9 +23,11 @@
 #ifndef _OPENCOG_I_R_CHAT_NODE_H
 #define _OPENCOG_I_R_CHAT_NODE_H
 
-#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #include <opencog/atoms/value/QueueValue.h>
+#include <opencog/atoms/sensory/Executor.h>
 #include <opencog/atoms/sensory/TextStreamNode.h>
 
 class IRC;
@@ -47,9 +49,13 @@ class IRChatNode
 {
 private:
 	IRC* _conn;
-	std::thread* _loop;
-	std::atomic<bool> _cancel;
-	void looper(void);
+	std::mutex _mtx;
+	uint64_t _watch;
+	std::thread _login_thread;
+	std::condition_variable _login_cv;
+	bool _cancel;
+	void login(void);
+	void on_readable(void);
 
 	static int xend_of_motd(const char*, irc_reply_data*, void*);
 	static int xgot_privmsg(const char*, irc_reply_data*, void*);
@@ -77,7 +83,10 @@ protected:
 	// virtual void write(const ValuePtr&); inherited from StreamNode
 	virtual bool connected(void) const;
 	virtual ValuePtr read(void) const;
+	virtual AsyncTask<ValuePtr> async_read(void) const;
 	virtual ValuePtr stream(void) const;
+	virtual bool ready(void) const;
+	virtual int ready_fd(void) const;
 
 public:
 	IRChatNode(const std::string&&);
@@ -26,6 +26,7 @@
 #include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atoms/value/StringValue.h>
 #include <opencog/atoms/value/VoidValue.h>
+#include <opencog/atoms/sensory/JsonParser.h>
 
 #include <opencog/sensory/types/atom_types.h>
 #include "OllamaNode.h"
@@ -36,7 +37,6 @@ using namespace opencog;
 
 OllamaNode::OllamaNode(Type t, const std::string&& str) :
 	TextStreamNode(t, std::move(str)),
-	_loop(nullptr),
 	_port(11434)
 {
 	OC_ASSERT(nameserver().isA(_type, OLLAMA_NODE),
@@ -46,7 +46,6 @@ OllamaNode::OllamaNode(Type t, const std::string&& str) :
 
 OllamaNode::OllamaNode(const std::string&& str) :
 	TextStreamNode(OLLAMA_NODE, std::move(str)),
-	_loop(nullptr),
 	_port(11434)
 {
 	addMessage("*-embedding-*");
@@ -160,200 +159,29 @@ void OllamaNode::open(const ValuePtr& vurl)
 			"Ollama at %s:%d returned status %d\n",
 			_host.c_str(), _port, res->status);
 
-	_qvp = createQueueValue();
+	_qvp = make_queue();
 	_req_queue = createQueueValue();
-
-	// Start background thread to process requests.
-	_loop = new std::thread(&OllamaNode::looper, this);
+	_loop = std::thread(&OllamaNode::looper, this);
 }
 
 void OllamaNode::close(const ValuePtr&)
 {
-	if (nullptr == _loop) return;
+	if (nullptr == _req_queue) return;
 	_cancel = true;
 
-	// Close the request queue to unblock the looper.
+	// Requests not yet started are skipped; wait for the one that
+	// is in progress, if any.
 	_req_queue->close();
-
-	_loop->join();
-	delete _loop;
-	_loop = nullptr;
+	if (_loop.joinable()) _loop.join();
+	_req_queue = nullptr;
 
 	_qvp = nullptr;
-	_req_queue = nullptr;
+	notify();
 }
 
 bool OllamaNode::connected(void) const
 {
-	return (nullptr != _loop);
-}
-
-// ====================================================================
-// JSON utility functions.
-// These are simple and specific to the Ollama API formats.
-// No need for a general-purpose JSON library.
-
-// Escape a string for JSON embedding.
-static std::string json_escape(const std::string& s)
-{
-	std::string result;
-	result.reserve(s.size() + 16);
-	for (char c : s)
-	{
-		switch (c)
-		{
-			case '"':  result += "\\\""; break;
-			case '\\': result += "\\\\"; break;
-			case '\n': result += "\\n"; break;
-			case '\r': result += "\\r"; break;
-			case '\t': result += "\\t"; break;
-			default:   result += c; break;
-		}
-	}
-	return result;
-}
-
-// Decode a JSON \uXXXX escape sequence (and surrogate pairs for
-// characters above U+FFFF) into UTF-8. `pos` should point at the
-// first hex digit after the 'u'. On return, `pos` is advanced past
-// the consumed hex digits (and past the low surrogate, if any).
-static inline void json_decode_uXXXX(const std::string& json,
-                                     size_t& pos, std::string& result)
-{
-	if (pos + 4 > json.size()) return;
-	uint32_t cp = std::stoul(json.substr(pos, 4), nullptr, 16);
-	pos += 4;
-
-	// Handle UTF-16 surrogate pairs for U+10000 and above.
-	if (0xD800 <= cp and cp <= 0xDBFF and
-	    pos + 6 <= json.size() and
-	    json[pos] == '\\' and json[pos + 1] == 'u')
-	{
-		uint32_t lo = std::stoul(json.substr(pos + 2, 4), nullptr, 16);
-		if (0xDC00 <= lo and lo <= 0xDFFF)
-		{
-			cp = 0x10000 + (cp - 0xD800) * 0x400 + (lo - 0xDC00);
-			pos += 6;
-		}
-	}
-
-	// Encode code point as UTF-8.
-	if (cp < 0x80)
-		result += (char) cp;
-	else if (cp < 0x800)
-	{
-		result += (char)(0xC0 | (cp >> 6));
-		result += (char)(0x80 | (cp & 0x3F));
-	}
-	else if (cp < 0x10000)
-	{
-		result += (char)(0xE0 | (cp >> 12));
-		result += (char)(0x80 | ((cp >> 6) & 0x3F));
-		result += (char)(0x80 | (cp & 0x3F));
-	}
-	else
-	{
-		result += (char)(0xF0 | (cp >> 18));
-		result += (char)(0x80 | ((cp >> 12) & 0x3F));
-		result += (char)(0x80 | ((cp >> 6) & 0x3F));
-		result += (char)(0x80 | (cp & 0x3F));
-	}
-}
-
-// Extract a string value for a given key from a JSON object string.
-// Looks for "key":"value" and returns value (with JSON escapes decoded).
-// Returns empty string if key not found.
-static std::string json_get_string(const std::string& json,
-                                   const std::string& key)
-{
-	std::string needle = "\"" + key + "\"";
-	size_t pos = json.find(needle);
-	if (std::string::npos == pos) return "";
-
-	// Skip past the key and colon
-	pos += needle.size();
-	while (pos < json.size() and (json[pos] == ' ' or json[pos] == ':'))
-		pos++;
-
-	if (pos >= json.size() or json[pos] != '"') return "";
-	pos++; // skip opening quote
-
-	std::string result;
-	while (pos < json.size() and json[pos] != '"')
-	{
-		if (json[pos] == '\\' and pos + 1 < json.size())
-		{
-			pos++;
-			switch (json[pos])
-			{
-				case '"':  result += '"'; pos++; break;
-				case '\\': result += '\\'; pos++; break;
-				case 'n':  result += '\n'; pos++; break;
-				case 'r':  result += '\r'; pos++; break;
-				case 't':  result += '\t'; pos++; break;
-				case 'u':
-					// \uXXXX unicode escape; pos is advanced
-					// past all consumed hex digits by the callee.
-					pos++;
-					json_decode_uXXXX(json, pos, result);
-					break;
-				default:   result += json[pos]; pos++; break;
-			}
-		}
-		else
-		{
-			result += json[pos];
-			pos++;
-		}
-	}
-	return result;
-}
-
-// Extract an array of floats from the "embeddings" key in a JSON response.
-// The Ollama /api/embed response has the form:
-//   {"model":"...","embeddings":[[0.123,-0.456,...]]}
-// We extract the first (inner) array of floats.
-static std::vector<float> json_get_float_array(const std::string& json)
-{
-	std::vector<float> result;
-
-	// Find the "embeddings" key.
-	size_t pos = json.find("\"embeddings\"");
-	if (std::string::npos == pos) return result;
-
-	// Skip to the first '[' (the outer array).
-	pos = json.find('[', pos);
-	if (std::string::npos == pos) return result;
-
-	// Skip to the second '[' (the inner array for the first embedding).
-	pos = json.find('[', pos + 1);
-	if (std::string::npos == pos) return result;
-	pos++; // skip '['
-
-	// Parse comma-separated floats until ']'.
-	while (pos < json.size())
-	{
-		// Skip whitespace.
-		while (pos < json.size() and
-		       (json[pos] == ' ' or json[pos] == '\n' or
-		        json[pos] == '\r' or json[pos] == '\t'))
-			pos++;
-
-		if (pos >= json.size() or json[pos] == ']') break;
-
-		// Parse one float.
-		size_t end = 0;
-		float val = std::stof(json.substr(pos), &end);
-		result.push_back(val);
-		pos += end;
-
-		// Skip comma.
-		while (pos < json.size() and
-		       (json[pos] == ' ' or json[pos] == ','))
-			pos++;
-	}
-
-	return result;
+	return (nullptr != _req_queue);
 }
 
 // ====================================================================
@@ -362,8 +190,8 @@ static std::vector<float> json_get_float_array(const std::string& json)
 std::string OllamaNode::do_generate(const std::string& prompt)
 {
 	std::string body =
-		"{\"model\":\"" + json_escape(_model) + "\","
-		"\"prompt\":\"" + json_escape(prompt) + "\","
+		"{\"model\":\"" + JsonParser::escape(_model) + "\","
+		"\"prompt\":\"" + JsonParser::escape(prompt) + "\","
 		"\"stream\":false}";
 
 	httplib::Client cli(_host, _port);
@@ -377,13 +205,16 @@ std::string OllamaNode::do_generate(const std::string& prompt)
 	if (200 != res->status)
 		return "[OllamaNode error: HTTP " + std::to_string(res->status) + "]";
 
-	return json_get_string(res->body, "response");
+	JsonParser jp;
+	if (not jp.parse(res->body))
+		return "[OllamaNode error: bad JSON: " + jp.error() + "]";
+	return std::string(jp.root()["response"].as_string());
 }
 
 std::string OllamaNode::do_chat(const std::string& json_messages)
 {
 	std::string body =
-		"{\"model\":\"" + json_escape(_model) + "\","
+		"{\"model\":\"" + JsonParser::escape(_model) + "\","
 		"\"messages\":" + json_messages + ","
 		"\"stream\":false}";
 
@@ -399,15 +230,17 @@ std::string OllamaNode::do_chat(const std::string& json_messages)
 		return "[OllamaNode error: HTTP " + std::to_string(res->status) + "]";
 
 	// The chat response has {"message":{"role":"assistant","content":"..."}}
-	// We need to find "content" inside the "message" object.
-	return json_get_string(res->body, "content");
+	JsonParser jp;
+	if (not jp.parse(res->body))
+		return "[OllamaNode error: bad JSON: " + jp.error() + "]";
+	return std::string(jp.root()["message"]["content"].as_string());
 }
 
 std::vector<float> OllamaNode::do_embed(const std::string& text)
 {
 	std::string body =
-		"{\"model\":\"" + json_escape(_model) + "\","
-		"\"input\":\"" + json_escape(text) + "\"}";
+		"{\"model\":\"" + JsonParser::escape(_model) + "\","
+		"\"input\":\"" + JsonParser::escape(text) + "\"}";
 
 	httplib::Client cli(_host, _port);
 	cli.set_read_timeout(60);
@@ -422,7 +255,21 @@ std::vector<float> OllamaNode::do_embed(const std::string& text)
 		throw RuntimeException(TRACE_INFO,
 			"OllamaNode: embedding HTTP error %d\n", res->status);
 
-	std::vector<float> vec = json_get_float_array(res->body);
+	// The response has the form
+	//   {"model":"...","embeddings":[[0.123,-0.456,...]]}
+	// Take the first (inner) array.
+	JsonParser jp;
+	if (not jp.parse(res->body))
+		throw RuntimeException(TRACE_INFO,
+			"OllamaNode: bad JSON in embedding: %s\n", jp.error().c_str());
+
+	JsonParser::Ref emb = jp.root()["embeddings"].at(0);
+	std::vector<float> vec;
+	vec.reserve(emb.size());
+	JsonParser::Ref el = emb.at(0);
+	for (size_t i = 0; i < emb.size(); i++, el = el.next())
+		vec.push_back(el.as_number());
+
 	if (vec.empty())
 		throw RuntimeException(TRACE_INFO,
 			"OllamaNode: empty embedding returned\n");
@@ -431,8 +278,13 @@ std::vector<float> OllamaNode::do_embed(const std::string& text)
 }
 
 // ====================================================================
-// Background thread. Pulls requests from _req_queue, sends to Ollama,
-// pushes responses onto _qvp.
+// Requests are run in the looper thread, one at a time. Each one is
+// sent to Ollama, and the response pushed onto _qvp.
+
+void OllamaNode::submit(ValuePtr req)
+{
+	_req_queue->add(std::move(req));
+}
 
 void OllamaNode::looper(void)
 {
@@ -447,45 +299,47 @@ void OllamaNode::looper(void)
 		{
 			break;
 		}
+		if (req) process(req);
+	}
+}
+
+void OllamaNode::process(const ValuePtr& req)
+{
+	if (_cancel) return;
 
-		if (_cancel) break;
-		if (nullptr == req) continue;
+	// A StringValue with one element means /api/generate.
+	// A StringValue with two elements means /api/chat
+	//   where element[0] is "chat" and element[1] is the JSON messages.
+	if (not req->is_type(STRING_VALUE)) return;
 
-		// A StringValue with one element means /api/generate.
-		// A StringValue with two elements means /api/chat
-		//   where element[0] is "chat" and element[1] is the JSON messages.
-		if (req->is_type(STRING_VALUE))
-		{
-			StringValuePtr svp(StringValueCast(req));
-			const std::vector<std::string>& strs = svp->value();
-
-			std::string response;
-			if (strs.size() >= 2 and strs[0] == "chat")
-				response = do_chat(strs[1]);
-			else if (not strs.empty())
-				response = do_generate(strs[0]);
-			else
-				continue;
+	StringValuePtr svp(StringValueCast(req));
+	const std::vector<std::string>& strs = svp->value();
 
-			// Replace newlines with spaces. LLM responses are
-			// typically multi-line, but most consumers (e.g. IRC)
-			// expect single-line strings.
-			std::replace(response.begin(), response.end(), '\n', ' ');
-			std::replace(response.begin(), response.end(), '\r', ' ');
+	std::string response;
+	if (strs.size() >= 2 and strs[0] == "chat")
+		response = do_chat(strs[1]);
+	else if (not strs.empty())
+		response = do_generate(strs[0]);
+	else
+		return;
 
-			if (not _cancel and _qvp)
-				_qvp->add(createStringValue(std::move(response)));
-		}
-	}
+	// Replace newlines with spaces. LLM responses are
+	// typically multi-line, but most consumers (e.g. IRC)
+	// expect single-line strings.
+	std::replace(response.begin(), response.end(), '\n', ' ');
+	std::replace(response.begin(), response.end(), '\r', ' ');
+
+	if (not _cancel and _qvp)
+		enqueue(_qvp, createStringValue(std::move(response)));
 }
 
 // ====================================================================
-// Write methods. These push requests onto the request queue.
+// Write methods. These submit requests to the looper.
 
 // write_one handles different Atomese value types.
 void OllamaNode::write_one(const ValuePtr& command_data)
 {
-	if (nullptr == _loop)
+	if (nullptr == _req_queue)
 		throw RuntimeException(TRACE_INFO,
 			"OllamaNode not connected; call open first.\n");
 
@@ -497,7 +351,7 @@ void OllamaNode::write_one(const ValuePtr& command_data)
 		for (const std::string& str : strs)
 		{
 			ValuePtr req = createStringValue(str);
-			_req_queue->add(std::move(req));
+			submit(std::move(req));
 		}
 		return;
 	}
@@ -507,7 +361,7 @@ void OllamaNode::write_one(const ValuePtr& command_data)
 	{
 		std::string prompt = HandleCast(command_data)->get_name();
 		ValuePtr req = createStringValue(std::move(prompt));
-		_req_queue->add(std::move(req));
+		submit(std::move(req));
 		return;
 	}
 
@@ -545,8 +399,8 @@ void OllamaNode::write_one(const ValuePtr& command_data)
 			if (role.empty() or content.empty()) continue;
 
 			if (not first) json += ",";
-			json += "{\"role\":\"" + json_escape(role) +
-			        "\",\"content\":\"" + json_escape(content) + "\"}";
+			json += "{\"role\":\"" + JsonParser::escape(role) +
+			        "\",\"content\":\"" + JsonParser::escape(content) + "\"}";
 			first = false;
 		}
 		json += "]";
@@ -554,7 +408,7 @@ void OllamaNode::write_one(const ValuePtr& command_data)
 		// Tag this as a chat request.
 		ValuePtr req = createStringValue(
 			std::vector<std::string>({"chat", json}));
-		_req_queue->add(std::move(req));
+		submit(std::move(req));
 		return;
 	}
 
@@ -577,7 +431,7 @@ void OllamaNode::write_one(const ValuePtr& command_data)
 				prompt += h->get_name();
 			}
 			ValuePtr req = createStringValue(std::move(prompt));
-			_req_queue->add(std::move(req));
+			submit(std::move(req));
 			return;
 		}
 	}
@@ -590,12 +444,12 @@ void OllamaNode::write_one(const ValuePtr& command_data)
 // do_write is called by TextStreamNode::do_write(ValuePtr) for plain strings.
 void OllamaNode::do_write(const std::string& prompt)
 {
-	if (nullptr == _loop)
+	if (nullptr == _req_queue)
 		throw RuntimeException(TRACE_INFO,
 			"OllamaNode not connected; call open first.\n");
 
 	ValuePtr req = createStringValue(prompt);
-	_req_queue->add(std::move(req));
+	submit(std::move(req));
 }
 
 // ====================================================================
@@ -603,14 +457,20 @@ void OllamaNode::do_write(const std::string& prompt)
 
 ValuePtr OllamaNode::read(void) const
 {
-	if (nullptr == _loop) return createVoidValue();
+	if (nullptr == _req_queue) return createVoidValue();
+
+	// Replayed items come first; they were read before these.
+	ValuePtr rvp(wal_replay_next());
+	if (rvp) return rvp;
 
 	if (_qvp->is_closed() and 0 == _qvp->size())
 		return createVoidValue();
 
+	if (0 < _timeout_ms) return wal_dequeued(wait_queue(_qvp));
+
 	try
 	{
-		return _qvp->remove();
+		return wal_dequeued(_qvp->remove());
 	}
 	catch (typename concurrent_queue<ValuePtr>::Canceled& e)
 	{}
@@ -618,10 +478,37 @@ ValuePtr OllamaNode::read(void) const
 	return createVoidValue();
 }
 
-ValuePtr OllamaNode::stream(void) const
+// Replies are queued by the looper, not read from an fd.
+AsyncTask<ValuePtr> OllamaNode::async_read(void) const
+{
+	co_return read();
+}
+
+// Ready once a reply has come back.
+bool OllamaNode::ready(void) const
+{
+	if (nullptr == _req_queue) return true;
+	QueueValuePtr qvp(_qvp);
+	if (nullptr == qvp or _replaying) return true;
+	clear_notify();
+	return 0 < qvp->size() or qvp->is_closed();
+}
+
+int OllamaNode::ready_fd(void) const
 {
-	if (nullptr == _loop) return createVoidValue();
+	return notify_fd();
+}
 
+ValuePtr OllamaNode::stream(void) const
+{
+	if (nullptr == _req_queue) return createVoidValue();
+
+	// Taken straight off the queue, items would not be counted off
+	// for *-ack-*, nor captured, nor conflated; so, if need be, go
+	// through read().
+	if (std::atomic_load(&_queue_wal) or std::atomic_load(&_capture)
+	    or _conflate)
+		return StreamNode::stream();
 	return _qvp;
 }
 
@@ -640,7 +527,7 @@ void OllamaNode::setValue(const Handle& key, const ValuePtr& value)
 		const std::string& pred = key->get_name();
 		if (dispatch_hash(pred.c_str()) == p_embedding)
 		{
-			if (nullptr == _loop)
+			if (nullptr == _req_queue)
 				throw RuntimeException(TRACE_INFO,
 					"OllamaNode not connected; call open first.\n");
 
@@ -668,7 +555,7 @@ void OllamaNode::setValue(const Handle& key, const ValuePtr& value)
 	}
 
 	// Everything else goes to the base class.
-	SensoryNode::setValue(key, value);
+	TextStreamNode::setValue(key, value);
 }
 
 // ====================================================================
@@ -52,7 +52,12 @@ class OllamaNode
 	: public TextStreamNode
 {
 private:
-	std::thread* _loop;
+	// Requests run one at a time, in order, on a thread of our own.
+	// Each one blocks until the model is done, which can be minutes;
+	// on the shared executor, that would tie up one of its workers.
+	// The request queue is null when not open.
+	QueueValuePtr _req_queue;
+	std::thread _loop;
 	std::atomic<bool> _cancel;
 
 	// Ollama connection details, parsed from URL.
@@ -60,10 +65,9 @@ private:
 	int _port;
 	std::string _model;
 
-	// Request queue: write() pushes requests, looper() pops them.
-	QueueValuePtr _req_queue;
-
+	void submit(ValuePtr);
 	void looper(void);
+	void process(const ValuePtr&);
 	std::string do_generate(const std::string& prompt);
 	std::string do_chat(const std::string& json_messages);
 	std::vector<float> do_embed(const std::string& text);
@@ -77,7 +81,10 @@ protected:
 	virtual void do_write(const std::string&);
 	virtual bool connected(void) const;
 	virtual ValuePtr read(void) const;
+	virtual AsyncTask<ValuePtr> async_read(void) const;
 	virtual ValuePtr stream(void) const;
+	virtual bool ready(void) const;
+	virtual int ready_fd(void) const;
 
 public:
 	OllamaNode(const std::string&&);
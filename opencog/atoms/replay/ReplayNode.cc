@@ -0,0 +1,231 @@
+/*
+ * opencog/atoms/replay/ReplayNode.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <opencog/util/exceptions.h>
+#include <opencog/util/oc_assert.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/VoidValue.h>
+
+#include <opencog/sensory/types/atom_types.h>
+#include "ReplayNode.h"
+
+using namespace opencog;
+
+ReplayNode::ReplayNode(Type t, const std::string&& str) :
+	TextStreamNode(t, std::move(str)),
+	_next_us(0),
+	_speed(1.0),
+	_base_us(0),
+	_based(false),
+	_played(0)
+{
+	OC_ASSERT(nameserver().isA(_type, REPLAY_NODE),
+		"Bad ReplayNode constructor!");
+	addMessage("*-speed-*");
+}
+
+ReplayNode::ReplayNode(const std::string&& str) :
+	TextStreamNode(REPLAY_NODE, std::move(str)),
+	_next_us(0),
+	_speed(1.0),
+	_base_us(0),
+	_based(false),
+	_played(0)
+{
+	addMessage("*-speed-*");
+}
+
+ReplayNode::~ReplayNode()
+{
+	close(nullptr);
+}
+
+// ==================================================================
+
+/// The URL is that of the capture file; only local files, for now:
+/// file:///path/to/capture
+void ReplayNode::open(const ValuePtr& ignore)
+{
+	const std::string& url = get_name();
+	if (0 != url.compare(0, 8, "file:///"))
+		throw RuntimeException(TRACE_INFO,
+			"Unsupported URL \"%s\"\n", url.c_str());
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	_path = url.substr(7);
+	_reader = std::make_unique<CaptureReader>(_path);
+	_next = _reader->next(_next_us);
+	_based = false;
+	_played = 0;
+	_cv.notify_all();
+}
+
+void ReplayNode::close(const ValuePtr& ignore)
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	_reader.reset();
+	_next = nullptr;
+	_cv.notify_all();
+}
+
+bool ReplayNode::connected(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	return nullptr != _reader;
+}
+
+void ReplayNode::do_write(const std::string& str)
+{
+	throw RuntimeException(TRACE_INFO,
+		"ReplayNode is read-only; cannot write \"%s\"\n", str.c_str());
+}
+
+// ==================================================================
+
+// When the next item is due. The first item after the clock is
+// (re)started is due at once; the rest follow at the recorded gaps,
+// divided by the speed. Called with the lock held.
+std::chrono::steady_clock::time_point ReplayNode::due(void) const
+{
+	if (0.0 == _speed) return std::chrono::steady_clock::time_point();
+
+	if (not _based)
+	{
+		_base = std::chrono::steady_clock::now();
+		_base_us = _next_us;
+		_based = true;
+	}
+	double us = (_next_us - _base_us) / _speed;
+	return _base + std::chrono::microseconds((int64_t) us);
+}
+
+// Wait for the next item's time, or for the read timeout, whichever
+// comes first. A reader that falls behind gets the late items at
+// once, until it catches up.
+ValuePtr ReplayNode::read(void) const
+{
+	ValuePtr rvp(wal_replay_next());
+	if (rvp) return rvp;
+
+	Deadline dl(read_deadline());
+	std::unique_lock<std::mutex> lock(_mtx);
+	while (true)
+	{
+		if (nullptr == _next) return createVoidValue();
+
+		auto when = due();
+		auto now = std::chrono::steady_clock::now();
+		if (when <= now) break;
+		if (dl.expired()) return timeout_value();
+
+		int left = std::chrono::duration_cast<std::chrono::milliseconds>(
+			when - now).count() + 1;
+		int ms = dl.wait_ms(left);
+		if (ms < left)
+			_cv.wait_for(lock, std::chrono::milliseconds(ms));
+		else
+			_cv.wait_until(lock, when);
+	}
+
+	ValuePtr vp(_next);
+	_next = _reader->next(_next_us);
+	_played++;
+	lock.unlock();
+
+	return wal_take(vp);
+}
+
+// Nothing to co_await; the wait is for a time, not an fd.
+AsyncTask<ValuePtr> ReplayNode::async_read(void) const
+{
+	co_return read();
+}
+
+// Items are whatever was recorded, not necessarily strings.
+ValuePtr ReplayNode::stream(void) const
+{
+	return StreamNode::stream();
+}
+
+bool ReplayNode::ready(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (nullptr == _next) return true;
+	return due() <= std::chrono::steady_clock::now();
+}
+
+// ==================================================================
+
+// The *-speed-* message takes a multiple of the recorded pace; zero
+// is as fast as possible. The new pace starts from the next item.
+void ReplayNode::set_speed(const ValuePtr& value)
+{
+	double speed = get_number(value);
+	if (speed < 0.0)
+		throw RuntimeException(TRACE_INFO,
+			"Expecting a speed of zero or more; got %s\n",
+			value->to_string().c_str());
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	_speed = speed;
+	_based = false;
+	_cv.notify_all();
+}
+
+void ReplayNode::setValue(const Handle& key, const ValuePtr& value)
+{
+	if (PREDICATE_NODE == key->get_type())
+	{
+		static constexpr uint32_t p_speed =
+			dispatch_hash("*-speed-*");
+
+		if (p_speed == dispatch_hash(key->get_name().c_str()))
+		{
+			set_speed(value);
+			return;
+		}
+	}
+
+	TextStreamNode::setValue(key, value);
+}
+
+std::string ReplayNode::monitor(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (nullptr == _reader) return "Not open\n";
+
+	std::string rpt = "Replaying: " + _path + "\n";
+	rpt += "   Played: " + std::to_string(_played) + " items";
+	rpt += nullptr == _next ? ", to the end\n" : "\n";
+	rpt += "   Speed: " +
+		(0.0 == _speed ? std::string("as fast as possible") :
+		 std::to_string(_speed) + " times the recorded pace") + "\n";
+	return rpt;
+}
+
+// ==============================================================
+
+// Adds factory when library is loaded.
+DEFINE_NODE_FACTORY(ReplayNode, REPLAY_NODE);
+
+// ====================================================================
+
+void opencog_sensory_replay_init(void)
+{
+	// Force shared lib ctors to run
+};
@@ -0,0 +1,107 @@
+/*
+ * opencog/atoms/replay/ReplayNode.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_REPLAY_NODE_H
+#define _OPENCOG_REPLAY_NODE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <opencog/atoms/sensory/StreamCapture.h>
+#include <opencog/atoms/sensory/TextStreamNode.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * ReplayNodes play back a capture file, made with the *-capture-*
+ * message on some other node, through the usual *-read-* and
+ * *-stream-* methods. A pipeline built for a live source, an IRC
+ * channel or a socket, can then be run, and timed, on the same input,
+ * again and again, without the source.
+ *
+ * The URL is that of the capture file: `file:///tmp/irc.cap`. Items
+ * come back as they were recorded; the *-open-* argument is ignored.
+ *
+ * By default, items come at the pace they were recorded at, with the
+ * first one at once. The *-speed-* message changes that: 2 is twice
+ * as fast, 0.5 half as fast, and 0 as fast as they can be read.
+ * A *-timeout-* applies while waiting for the next item's time.
+ *
+ * Writing is not supported.
+ */
+class ReplayNode
+	: public TextStreamNode
+{
+protected:
+	mutable std::mutex _mtx;
+	mutable std::condition_variable _cv;
+	mutable std::unique_ptr<CaptureReader> _reader;
+	std::string _path;
+
+	// The next item, read ahead so that its time is known.
+	mutable ValuePtr _next;
+	mutable uint64_t _next_us;
+
+	// Pacing: the item at _base_us in the capture is due at _base.
+	// Rebased when the speed changes.
+	double _speed;
+	mutable std::chrono::steady_clock::time_point _base;
+	mutable uint64_t _base_us;
+	mutable bool _based;
+	mutable size_t _played;
+
+	void set_speed(const ValuePtr&);
+	std::chrono::steady_clock::time_point due(void) const;
+
+	virtual void open(const ValuePtr&);
+	virtual void close(const ValuePtr&);
+	virtual bool connected(void) const;
+	virtual ValuePtr read(void) const;
+	virtual AsyncTask<ValuePtr> async_read(void) const;
+	virtual ValuePtr stream(void) const;
+	virtual bool ready(void) const;
+
+	virtual void do_write(const std::string&);
+
+public:
+	ReplayNode(const std::string&&);
+	ReplayNode(Type t, const std::string&&);
+	virtual ~ReplayNode();
+
+	virtual void setValue(const Handle& key, const ValuePtr& value);
+	virtual std::string monitor(void) const;
+
+	static Handle factory(const Handle&);
+};
+
+NODE_PTR_DECL(ReplayNode)
+#define createReplayNode CREATE_DECL(ReplayNode)
+
+/** @}*/
+} // namespace opencog
+
+extern "C" {
+void opencog_sensory_replay_init(void);
+};
+
+#endif // _OPENCOG_REPLAY_NODE_H
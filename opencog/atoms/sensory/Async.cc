@@ -0,0 +1,124 @@
+/*
+ * opencog/atoms/sensory/Async.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/epoll.h>
+
+#include <opencog/util/exceptions.h>
+
+#include "Async.h"
+
+using namespace opencog;
+
+// How long fd_ready() waits before returning zero, so that the caller
+// can check whether it should still be waiting at all.
+#define FD_WAIT_MS 250
+
+static thread_local bool tl_blocking = false;
+
+bool async_detail::blocking(void)
+{
+	return tl_blocking;
+}
+
+async_detail::BlockingScope::BlockingScope(void) :
+	saved(tl_blocking)
+{
+	tl_blocking = true;
+}
+
+async_detail::BlockingScope::~BlockingScope()
+{
+	tl_blocking = saved;
+}
+
+// ==============================================================
+
+Deadline::Deadline(std::chrono::milliseconds ms) :
+	_when(std::chrono::steady_clock::now() + ms), _never(false)
+{
+}
+
+bool Deadline::expired(void) const
+{
+	return not _never and _when <= std::chrono::steady_clock::now();
+}
+
+int Deadline::wait_ms(int cap) const
+{
+	if (_never) return cap;
+	auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+		_when - std::chrono::steady_clock::now()).count();
+	if (left <= 0) return 0;
+	if (cap < left) return cap;
+	return (int) left;
+}
+
+// ==============================================================
+
+FdAwaitable::FdAwaitable(int fd, uint32_t events, const Deadline& dl,
+                         const ExecOptions& opts) :
+	_fd(fd), _events(events), _revents(0),
+	_wait_ms(dl.wait_ms(FD_WAIT_MS)), _opts(opts)
+{
+}
+
+// Under sync_wait(), wait right here. The poll and epoll event bits
+// have the same values, for the events used here.
+bool FdAwaitable::await_ready(void)
+{
+	if (not tl_blocking) return false;
+
+	struct pollfd pfd;
+	pfd.fd = _fd;
+	pfd.events = (short) _events;
+	while (true)
+	{
+		int rc = poll(&pfd, 1, _wait_ms);
+		if (0 < rc) { _revents = pfd.revents; return true; }
+		if (0 == rc) { _revents = 0; return true; }
+		if (EINTR == errno) continue;
+		_revents = EPOLLERR;
+		return true;
+	}
+}
+
+// Suspend, and have the Executor resume us. Nothing here may touch
+// `this` after wait_fd() returns: by then, the coroutine may already
+// have been resumed, on another thread, and be long gone.
+bool FdAwaitable::await_suspend(std::coroutine_handle<> h)
+{
+	uint32_t* revents = &_revents;
+	try
+	{
+		Executor::instance().wait_fd(_fd, _events,
+			std::chrono::milliseconds(_wait_ms),
+			[revents, h](uint32_t ev) { *revents = ev; h.resume(); },
+			_opts);
+	}
+	catch (const RuntimeException&)
+	{
+		// Not something epoll can wait on; say it is ready, and let
+		// the caller's read or write find out what's what.
+		_revents = _events;
+		return false;
+	}
+	return true;
+}
+
+// ====================================================================
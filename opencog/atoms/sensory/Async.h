@@ -0,0 +1,319 @@
+/*
+ * opencog/atoms/sensory/Async.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_ASYNC_H
+#define _OPENCOG_ASYNC_H
+
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/sensory/Executor.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Coroutines for stream I/O.
+ *
+ * A reader or writer is written once, as a coroutine returning an
+ * AsyncTask, and suspends with `co_await fd_ready(fd, EPOLLIN)` where
+ * it would otherwise block. It can then be driven two ways:
+ *
+ * -- co_await'ed from another coroutine. While it waits, no thread is
+ *    tied up; it is resumed by the Executor, on one of its workers,
+ *    when the fd is ready. Many pipelines can be in flight this way
+ *    on a handful of threads.
+ *
+ * -- sync_wait()'ed from ordinary code; this is how the synchronous
+ *    read() and write() methods work. In this case, fd_ready() just
+ *    polls, in the calling thread, as the old blocking code did; the
+ *    Executor is not involved, and so sync_wait() is safe to call
+ *    from anywhere, including from an Executor task.
+ *
+ * fd_ready() returns the ready events, or zero after a timeout of a
+ * quarter second. Callers loop, re-checking their state each time; this
+ * is how a wait notices that the fd was closed by another thread.
+ * Given a Deadline, fd_ready() returns no later than that, and readers
+ * throw ReadTimeout once it has passed.
+ *
+ * AsyncTasks are lazy: nothing runs until they are awaited. Exceptions
+ * thrown in the coroutine are re-thrown to the awaiter.
+ */
+
+template<typename T> class AsyncTask;
+
+namespace async_detail
+{
+	// What the promises of all AsyncTasks have in common.
+	struct PromiseBase
+	{
+		std::coroutine_handle<> continuation;
+		std::exception_ptr exception;
+
+		std::suspend_always initial_suspend() noexcept { return {}; }
+
+		// When done, resume whoever was awaiting us.
+		struct FinalAwaiter
+		{
+			bool await_ready() noexcept { return false; }
+			template<typename P>
+			std::coroutine_handle<> await_suspend(
+				std::coroutine_handle<P> h) noexcept
+			{
+				std::coroutine_handle<> c = h.promise().continuation;
+				return c ? c : std::noop_coroutine();
+			}
+			void await_resume() noexcept {}
+		};
+		FinalAwaiter final_suspend() noexcept { return {}; }
+
+		void unhandled_exception() { exception = std::current_exception(); }
+	};
+
+	template<typename T>
+	struct Promise : PromiseBase
+	{
+		std::optional<T> value;
+		AsyncTask<T> get_return_object();
+		void return_value(T v) { value = std::move(v); }
+		T result()
+		{
+			if (exception) std::rethrow_exception(exception);
+			return std::move(*value);
+		}
+	};
+
+	template<>
+	struct Promise<void> : PromiseBase
+	{
+		AsyncTask<void> get_return_object();
+		void return_void() {}
+		void result()
+		{
+			if (exception) std::rethrow_exception(exception);
+		}
+	};
+
+	/// True while this thread is inside sync_wait().
+	bool blocking(void);
+
+	struct BlockingScope
+	{
+		bool saved;
+		BlockingScope(void);
+		~BlockingScope();
+	};
+}
+
+template<typename T>
+class AsyncTask
+{
+public:
+	typedef async_detail::Promise<T> promise_type;
+
+private:
+	std::coroutine_handle<promise_type> _h;
+
+public:
+	explicit AsyncTask(std::coroutine_handle<promise_type> h) : _h(h) {}
+	AsyncTask(AsyncTask&& o) noexcept : _h(std::exchange(o._h, nullptr)) {}
+	AsyncTask(const AsyncTask&) = delete;
+	AsyncTask& operator=(const AsyncTask&) = delete;
+	~AsyncTask() { if (_h) _h.destroy(); }
+
+	bool await_ready() const noexcept { return false; }
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) noexcept
+	{
+		_h.promise().continuation = c;
+		return _h;
+	}
+	T await_resume() { return _h.promise().result(); }
+};
+
+namespace async_detail
+{
+	template<typename T>
+	AsyncTask<T> Promise<T>::get_return_object()
+	{
+		return AsyncTask<T>(
+			std::coroutine_handle<Promise<T>>::from_promise(*this));
+	}
+
+	inline AsyncTask<void> Promise<void>::get_return_object()
+	{
+		return AsyncTask<void>(
+			std::coroutine_handle<Promise<void>>::from_promise(*this));
+	}
+
+	// Runs an AsyncTask to the end, and lets the waiting thread know.
+	struct Latch
+	{
+		std::mutex mtx;
+		std::condition_variable cv;
+		bool done = false;
+	};
+
+	struct SyncTask
+	{
+		struct promise_type
+		{
+			Latch* latch = nullptr;
+			SyncTask get_return_object()
+			{
+				return SyncTask{
+					std::coroutine_handle<promise_type>::from_promise(*this)};
+			}
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			struct Signal
+			{
+				bool await_ready() noexcept { return false; }
+				void await_suspend(
+					std::coroutine_handle<promise_type> h) noexcept
+				{
+					Latch* l = h.promise().latch;
+					std::lock_guard<std::mutex> lock(l->mtx);
+					l->done = true;
+					l->cv.notify_all();
+				}
+				void await_resume() noexcept {}
+			};
+			Signal final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception() { std::terminate(); }
+		};
+		std::coroutine_handle<promise_type> h;
+	};
+
+	template<typename T>
+	SyncTask run_task(AsyncTask<T>& task, std::optional<T>& out,
+	                  std::exception_ptr& exc)
+	{
+		try { out.emplace(co_await task); }
+		catch (...) { exc = std::current_exception(); }
+	}
+
+	inline SyncTask run_task(AsyncTask<void>& task, std::exception_ptr& exc)
+	{
+		try { co_await task; }
+		catch (...) { exc = std::current_exception(); }
+	}
+
+	inline void run_and_wait(SyncTask st)
+	{
+		Latch latch;
+		st.h.promise().latch = &latch;
+		{
+			BlockingScope scope;
+			st.h.resume();
+		}
+		std::unique_lock<std::mutex> lock(latch.mtx);
+		latch.cv.wait(lock, [&]() { return latch.done; });
+		lock.unlock();
+		st.h.destroy();
+	}
+}
+
+/// Run the task to completion, in this thread, and return its result.
+template<typename T>
+T sync_wait(AsyncTask<T>&& task)
+{
+	std::optional<T> out;
+	std::exception_ptr exc;
+	async_detail::run_and_wait(async_detail::run_task(task, out, exc));
+	if (exc) std::rethrow_exception(exc);
+	return std::move(*out);
+}
+
+inline void sync_wait(AsyncTask<void>&& task)
+{
+	std::exception_ptr exc;
+	async_detail::run_and_wait(async_detail::run_task(task, exc));
+	if (exc) std::rethrow_exception(exc);
+}
+
+/// When a read should give up. The default Deadline never passes.
+class Deadline
+{
+	std::chrono::steady_clock::time_point _when;
+	bool _never;
+
+public:
+	Deadline(void) : _never(true) {}
+	explicit Deadline(std::chrono::milliseconds);
+
+	bool expired(void) const;
+
+	/// How long to wait for now: the time left, but at most `cap`.
+	int wait_ms(int cap) const;
+};
+
+/// Thrown by readers when their Deadline has passed. It is silent, so
+/// that, if it gets out, it ends loops without complaint, just like
+/// end-of-file does.
+class ReadTimeout : public SilentException
+{
+};
+
+/**
+ * Awaitable: suspend until the fd is ready for the given epoll events,
+ * or until the timeout. The result is the ready events, or zero on
+ * timeout.
+ */
+class FdAwaitable
+{
+	int _fd;
+	uint32_t _events;
+	uint32_t _revents;
+	int _wait_ms;
+	ExecOptions _opts;
+
+public:
+	FdAwaitable(int fd, uint32_t events, const Deadline&,
+	            const ExecOptions& opts);
+
+	bool await_ready(void);
+	bool await_suspend(std::coroutine_handle<>);
+	uint32_t await_resume(void) const { return _revents; }
+};
+
+inline FdAwaitable fd_ready(int fd, uint32_t events,
+                            const ExecOptions& opts = ExecOptions())
+{
+	return FdAwaitable(fd, events, Deadline(), opts);
+}
+
+inline FdAwaitable fd_ready(int fd, uint32_t events, const Deadline& dl,
+                            const ExecOptions& opts = ExecOptions())
+{
+	return FdAwaitable(fd, events, dl, opts);
+}
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_ASYNC_H
@@ -0,0 +1,165 @@
+/*
+ * opencog/atoms/sensory/BroadcastRing.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <thread>
+
+#include <opencog/util/exceptions.h>
+
+#include "BroadcastRing.h"
+
+using namespace opencog;
+
+BroadcastRing::BroadcastRing(size_t capacity, Policy policy,
+                             Producer&& producer) :
+	_slots(capacity),
+	_policy(policy),
+	_head(0),
+	_closed(false),
+	_producer(std::move(producer))
+{
+	if (0 == capacity)
+		throw RuntimeException(TRACE_INFO,
+			"A broadcast ring needs room for at least one item\n");
+}
+
+BroadcastRing::~BroadcastRing()
+{
+}
+
+BroadcastRing::Policy
+BroadcastRing::policy_from_name(const std::string& name)
+{
+	if (0 == name.compare("block")) return BLOCK;
+	if (0 == name.compare("drop")) return DROP;
+	throw RuntimeException(TRACE_INFO,
+		"Unknown policy \"%s\"; expecting \"block\" or \"drop\"\n",
+		name.c_str());
+}
+
+// ==============================================================
+
+BroadcastRing::CursorPtr BroadcastRing::subscribe(void)
+{
+	CursorPtr cur(std::make_shared<Cursor>());
+	std::lock_guard<std::mutex> lock(_mtx);
+	cur->next = _head;
+	_cursors.push_back(cur);
+	return cur;
+}
+
+// The producer may be waiting for this one to catch up.
+void BroadcastRing::unsubscribe(const CursorPtr& cur)
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	auto it = std::find(_cursors.begin(), _cursors.end(), cur);
+	if (_cursors.end() != it) _cursors.erase(it);
+	_cv_space.notify_all();
+}
+
+// The number of the next item the slowest reader wants.
+// The caller must hold the lock.
+uint64_t BroadcastRing::slowest(void) const
+{
+	uint64_t low = _head;
+	for (const CursorPtr& cur : _cursors)
+		low = std::min(low, cur->next);
+	return low;
+}
+
+// ==============================================================
+
+bool BroadcastRing::publish(const ValuePtr& vp)
+{
+	std::unique_lock<std::mutex> lock(_mtx);
+	if (BLOCK == _policy)
+		_cv_space.wait(lock, [&] {
+			return _closed or _cursors.empty() or
+				_head - slowest() < _slots.size(); });
+
+	if (_closed or _cursors.empty()) return false;
+
+	// Under DROP, this may overwrite an item that a slow reader has
+	// not got to yet; next() notices, and moves that reader along.
+	_slots[_head % _slots.size()] = vp;
+	_head++;
+	_cv_data.notify_all();
+	return true;
+}
+
+ValuePtr BroadcastRing::next(Cursor& cur)
+{
+	std::call_once(_started, [this]() {
+		if (_producer)
+			std::thread(std::move(_producer), shared_from_this()).detach();
+	});
+
+	std::unique_lock<std::mutex> lock(_mtx);
+	_cv_data.wait(lock, [&] { return _closed or cur.next < _head; });
+	if (cur.next == _head) return nullptr;
+
+	size_t cap = _slots.size();
+	if (_head - cur.next > cap)
+	{
+		cur.dropped += _head - cap - cur.next;
+		cur.next = _head - cap;
+	}
+
+	ValuePtr vp(_slots[cur.next % cap]);
+	cur.next++;
+	cur.taken++;
+	if (BLOCK == _policy) _cv_space.notify_all();
+	return vp;
+}
+
+void BroadcastRing::close(void)
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	_closed = true;
+	_cv_data.notify_all();
+	_cv_space.notify_all();
+}
+
+bool BroadcastRing::is_closed(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	return _closed;
+}
+
+// ==============================================================
+
+std::string BroadcastRing::to_string(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	std::string rpt = "Tee ring: " + std::to_string(_slots.size()) +
+		" items, " + (BLOCK == _policy ? "block" : "drop") +
+		(_closed ? ", closed\n" : "\n");
+	rpt += "   Published: " + std::to_string(_head) +
+		"   Readers: " + std::to_string(_cursors.size()) + "\n";
+	for (size_t i = 0; i < _cursors.size(); i++)
+	{
+		const Cursor& cur = *_cursors[i];
+		rpt += "   Reader " + std::to_string(i) +
+			": taken " + std::to_string(cur.taken) +
+			", dropped " + std::to_string(cur.dropped) +
+			", behind " + std::to_string(
+				std::min<uint64_t>(_head - cur.next, _slots.size())) + "\n";
+	}
+	return rpt;
+}
+
+/* ===================== END OF FILE ===================== */
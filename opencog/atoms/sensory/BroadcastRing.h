@@ -0,0 +1,122 @@
+/*
+ * opencog/atoms/sensory/BroadcastRing.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_BROADCAST_RING_H
+#define _OPENCOG_BROADCAST_RING_H
+
+#include <stdint.h>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * BroadcastRing - One producer, many readers, each of which sees
+ * every item.
+ *
+ * Items go into a fixed-size ring, and are numbered as they come.
+ * Each reader has a Cursor, the number of the next item it wants;
+ * reading an item moves the cursor, and does not remove the item, so
+ * that the other readers still get it. The readers all get the very
+ * same Value; nothing is copied.
+ *
+ * When the ring is full, that is, when the slowest reader is a whole
+ * ring behind, the producer either waits for that reader (BLOCK), or
+ * goes ahead and overwrites the oldest item (DROP). In the second
+ * case, the reader that was behind skips ahead to the oldest item
+ * still in the ring, and counts the ones it missed.
+ *
+ * Readers start with the next item published after they subscribe.
+ * The producer is a function that is run in a thread of its own, the
+ * first time any reader asks for an item; so readers that subscribe
+ * before then all see the stream from its start. It should publish()
+ * until that returns false, and then close() the ring.
+ */
+class BroadcastRing : public std::enable_shared_from_this<BroadcastRing>
+{
+public:
+	enum Policy { BLOCK, DROP };
+
+	struct Cursor
+	{
+		uint64_t next = 0;
+		uint64_t taken = 0;
+		uint64_t dropped = 0;
+	};
+	typedef std::shared_ptr<Cursor> CursorPtr;
+
+	typedef std::function<void(std::shared_ptr<BroadcastRing>)> Producer;
+
+private:
+	std::vector<ValuePtr> _slots;
+	Policy _policy;
+
+	mutable std::mutex _mtx;
+	std::condition_variable _cv_data;   // Readers wait for items
+	std::condition_variable _cv_space;  // Producer waits for room
+	uint64_t _head;                     // Number of the next item
+	std::vector<CursorPtr> _cursors;
+	bool _closed;
+
+	Producer _producer;
+	std::once_flag _started;
+
+	uint64_t slowest(void) const;
+
+public:
+	BroadcastRing(size_t capacity, Policy, Producer&&);
+	~BroadcastRing();
+
+	BroadcastRing(const BroadcastRing&) = delete;
+	BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+	static Policy policy_from_name(const std::string&);
+
+	CursorPtr subscribe(void);
+	void unsubscribe(const CursorPtr&);
+
+	/// Add an item. Returns false, and does not add it, if the ring
+	/// is closed, or if there are no readers left.
+	bool publish(const ValuePtr&);
+
+	/// The next item for this cursor, waiting for it if need be;
+	/// nullptr once the ring is closed and the cursor has read all
+	/// that was in it.
+	ValuePtr next(Cursor&);
+
+	void close(void);
+	bool is_closed(void) const;
+
+	size_t capacity(void) const { return _slots.size(); }
+
+	/// A line or two for *-monitor-* reports.
+	std::string to_string(void) const;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_BROADCAST_RING_H
@@ -0,0 +1,577 @@
+/*
+ * opencog/atoms/sensory/Executor.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <opencog/util/exceptions.h>
+
+#include "Executor.h"
+
+using namespace opencog;
+
+// Upper limit on the pool size, whatever is asked for.
+#define EXEC_MAX_THREADS 256
+
+// A strand runs this many tasks in a row, then goes to the back of
+// the line, so that a busy strand cannot hog a worker.
+#define STRAND_BATCH 64
+
+static std::atomic<size_t> s_config_threads(0);
+static std::atomic<bool> s_started(false);
+
+// The worker the current thread is, if any; submit() from a worker
+// goes onto its own deque.
+static thread_local Executor* tl_exec = nullptr;
+static thread_local size_t tl_worker = 0;
+static thread_local char tl_name[16];
+
+static void report(const char* what)
+{
+	fprintf(stderr, "Executor: task threw: %s\n", what);
+}
+
+// ==============================================================
+
+void Executor::configure(size_t nthreads)
+{
+	if (s_started)
+		throw RuntimeException(TRACE_INFO,
+			"Executor already started; configure it before first use\n");
+	s_config_threads = nthreads;
+}
+
+// The executor is never destroyed. Worker threads may be in the middle
+// of a task when the process exits; tearing the pool down from a static
+// destructor would mean waiting on them, in an unknown order relative
+// to whatever the tasks refer to.
+Executor& Executor::instance(void)
+{
+	static Executor* exec = []()
+	{
+		size_t n = s_config_threads;
+		const char* env = getenv("SENSORY_EXECUTOR_THREADS");
+		if (0 == n and env) n = atoi(env);
+		if (0 == n) n = std::thread::hardware_concurrency();
+		if (0 == n) n = 2;
+		if (EXEC_MAX_THREADS < n) n = EXEC_MAX_THREADS;
+		s_started = true;
+		return new Executor(n);
+	}();
+	return *exec;
+}
+
+Executor::Executor(size_t nthreads) :
+	_pending(0),
+	_next(0),
+	_next_id(1),
+	_executed(0),
+	_stolen(0)
+{
+	_epfd = epoll_create1(EPOLL_CLOEXEC);
+	if (_epfd < 0)
+		throw RuntimeException(TRACE_INFO,
+			"Executor: epoll_create1 failed: %s\n", strerror(errno));
+
+	_evfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (_evfd < 0)
+		throw RuntimeException(TRACE_INFO,
+			"Executor: eventfd failed: %s\n", strerror(errno));
+
+	// Id zero is the wakeup fd; handler ids start at one.
+	struct epoll_event ev;
+	ev.events = EPOLLIN;
+	ev.data.u64 = 0;
+	epoll_ctl(_epfd, EPOLL_CTL_ADD, _evfd, &ev);
+
+	for (size_t i = 0; i < nthreads; i++)
+		_workers.emplace_back(new Worker);
+	for (size_t i = 0; i < nthreads; i++)
+		_threads.emplace_back(&Executor::worker_loop, this, i);
+
+	_reactor = std::thread(&Executor::reactor_loop, this);
+	pthread_setname_np(_reactor.native_handle(), "sensory-reactor");
+}
+
+// ==============================================================
+// The pool.
+
+void Executor::submit(Task task, const Options& opts)
+{
+	size_t w = (this == tl_exec) ? tl_worker : _next++ % _workers.size();
+	{
+		std::lock_guard<std::mutex> lock(_workers[w]->mtx);
+		_workers[w]->queue.push_back({std::move(task), opts});
+	}
+	_pending++;
+
+	// Taking the lock, even briefly, means that a worker that has just
+	// found nothing to do is either not yet checking _pending, or is
+	// already waiting, and so cannot miss the wakeup.
+	{ std::lock_guard<std::mutex> lock(_sleep_mtx); }
+	_wake.notify_one();
+}
+
+// Newest task from our own deque; else the oldest from someone else's.
+bool Executor::take(size_t w, Item& item)
+{
+	{
+		Worker& own = *_workers[w];
+		std::lock_guard<std::mutex> lock(own.mtx);
+		if (not own.queue.empty())
+		{
+			item = std::move(own.queue.back());
+			own.queue.pop_back();
+			return true;
+		}
+	}
+
+	size_t n = _workers.size();
+	for (size_t k = 1; k < n; k++)
+	{
+		Worker& other = *_workers[(w + k) % n];
+		std::lock_guard<std::mutex> lock(other.mtx);
+		if (not other.queue.empty())
+		{
+			item = std::move(other.queue.front());
+			other.queue.pop_front();
+			_stolen++;
+			return true;
+		}
+	}
+	return false;
+}
+
+void Executor::run(Item& item)
+{
+	const Options& opts = item.opts;
+
+	if (opts.name)
+	{
+		char name[16];
+		strncpy(name, opts.name, 15);
+		name[15] = 0;
+		pthread_setname_np(pthread_self(), name);
+	}
+
+	cpu_set_t saved;
+	bool pinned = false;
+	if (0 <= opts.cpu and opts.cpu < CPU_SETSIZE and
+	    0 == pthread_getaffinity_np(pthread_self(), sizeof(saved), &saved))
+	{
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(opts.cpu, &cpus);
+		pinned = (0 == pthread_setaffinity_np(pthread_self(),
+			sizeof(cpus), &cpus));
+	}
+
+	try
+	{
+		item.task();
+	}
+	catch (const std::exception& ex)
+	{
+		report(ex.what());
+	}
+	catch (...)
+	{
+		report("unknown exception");
+	}
+	_executed++;
+
+	if (pinned)
+		pthread_setaffinity_np(pthread_self(), sizeof(saved), &saved);
+	if (opts.name)
+		pthread_setname_np(pthread_self(), tl_name);
+}
+
+void Executor::worker_loop(size_t w)
+{
+	tl_exec = this;
+	tl_worker = w;
+	snprintf(tl_name, sizeof(tl_name), "sensory-w%zu", w);
+	pthread_setname_np(pthread_self(), tl_name);
+
+	while (true)
+	{
+		Item item;
+		if (take(w, item))
+		{
+			_pending--;
+			run(item);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(_sleep_mtx);
+		_wake.wait(lock, [this]() { return 0 < _pending; });
+	}
+}
+
+// ==============================================================
+// The reactor. Watched fds are registered one-shot, so that the
+// callback for an fd is never run twice at once; finish() re-arms it.
+
+void Executor::wake_reactor(void)
+{
+	uint64_t one = 1;
+	ssize_t rc = ::write(_evfd, &one, sizeof(one));
+	(void) rc;
+}
+
+uint64_t Executor::watch(int fd, uint32_t events, FdCallback cb,
+                         const Options& opts)
+{
+	HandlerPtr h = std::make_shared<Handler>();
+	h->fd = fd;
+	h->events = events;
+	h->on_fd = std::move(cb);
+	h->opts = opts;
+
+	uint64_t id;
+	{
+		std::lock_guard<std::mutex> lock(_rmtx);
+		id = _next_id++;
+		_handlers[id] = h;
+	}
+
+	struct epoll_event ev;
+	ev.events = events | EPOLLONESHOT;
+	ev.data.u64 = id;
+	if (epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &ev))
+	{
+		int norr = errno;
+		remove(id);
+		throw RuntimeException(TRACE_INFO,
+			"Executor: cannot watch fd %d: %s\n", fd, strerror(norr));
+	}
+	return id;
+}
+
+uint64_t Executor::wait_fd(int fd, uint32_t events,
+                           std::chrono::milliseconds timeout,
+                           FdCallback cb, const Options& opts)
+{
+	// With a private dup, removing it from epoll never touches anyone
+	// else's registration, even if the caller's fd number is closed
+	// and reused in the meantime.
+	int dfd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+	if (dfd < 0)
+		throw RuntimeException(TRACE_INFO,
+			"Executor: cannot dup fd %d: %s\n", fd, strerror(errno));
+
+	HandlerPtr h = std::make_shared<Handler>();
+	h->fd = dfd;
+	h->events = events;
+	h->once = true;
+	h->when = std::chrono::steady_clock::now() + timeout;
+	h->on_fd = std::move(cb);
+	h->opts = opts;
+
+	uint64_t id;
+	{
+		std::lock_guard<std::mutex> lock(_rmtx);
+		id = _next_id++;
+		_handlers[id] = h;
+		_timers.insert({h->when, id});
+	}
+
+	struct epoll_event ev;
+	ev.events = events | EPOLLONESHOT;
+	ev.data.u64 = id;
+	if (epoll_ctl(_epfd, EPOLL_CTL_ADD, dfd, &ev))
+	{
+		int norr = errno;
+		remove(id);
+		::close(dfd);
+		throw RuntimeException(TRACE_INFO,
+			"Executor: cannot wait on fd %d: %s\n", fd, strerror(norr));
+	}
+	wake_reactor();
+	return id;
+}
+
+uint64_t Executor::schedule(std::chrono::milliseconds delay, Task task,
+                            const Options& opts)
+{
+	HandlerPtr h = std::make_shared<Handler>();
+	h->when = std::chrono::steady_clock::now() + delay;
+	h->on_timer = std::move(task);
+	h->opts = opts;
+
+	uint64_t id;
+	{
+		std::lock_guard<std::mutex> lock(_rmtx);
+		id = _next_id++;
+		_handlers[id] = h;
+		_timers.insert({h->when, id});
+	}
+	wake_reactor();
+	return id;
+}
+
+Executor::HandlerPtr Executor::remove(uint64_t id)
+{
+	std::lock_guard<std::mutex> lock(_rmtx);
+	auto it = _handlers.find(id);
+	if (_handlers.end() == it) return nullptr;
+
+	HandlerPtr h = it->second;
+	_handlers.erase(it);
+	if (h->on_timer or h->once) _timers.erase({h->when, id});
+	return h;
+}
+
+void Executor::unwatch(uint64_t id)
+{
+	HandlerPtr h = remove(id);
+	if (nullptr == h) return;
+
+	std::unique_lock<std::mutex> lock(h->mtx);
+	if (not h->dead)
+	{
+		epoll_ctl(_epfd, EPOLL_CTL_DEL, h->fd, nullptr);
+		if (h->once) ::close(h->fd);
+	}
+	h->dead = true;
+	if (h->runner == std::this_thread::get_id()) return;
+	h->done.wait(lock, [&]() { return not h->running; });
+}
+
+bool Executor::cancel(uint64_t id)
+{
+	HandlerPtr h = remove(id);
+	if (nullptr == h) return false;
+
+	std::unique_lock<std::mutex> lock(h->mtx);
+	if (h->dead) return false;
+	if (not h->running)
+	{
+		h->dead = true;
+		return true;
+	}
+	if (h->runner == std::this_thread::get_id()) return false;
+	h->done.wait(lock, [&]() { return not h->running; });
+	return false;
+}
+
+// The callback has returned. Timers are done; fds are re-armed,
+// unless unwatch() was called in the meantime. Re-arming while still
+// holding the lock means the next callback cannot start before this
+// one is marked as finished.
+void Executor::finish(const HandlerPtr& h, uint64_t id)
+{
+	std::lock_guard<std::mutex> lock(h->mtx);
+	h->running = false;
+	h->runner = std::thread::id();
+	if (h->on_timer)
+		h->dead = true;
+	else if (not h->dead)
+	{
+		struct epoll_event ev;
+		ev.events = h->events | EPOLLONESHOT;
+		ev.data.u64 = id;
+		epoll_ctl(_epfd, EPOLL_CTL_MOD, h->fd, &ev);
+	}
+	h->done.notify_all();
+}
+
+void Executor::fire(uint64_t id, uint32_t events)
+{
+	HandlerPtr h;
+	{
+		std::lock_guard<std::mutex> lock(_rmtx);
+		auto it = _handlers.find(id);
+		if (_handlers.end() == it) return;
+		h = it->second;
+	}
+
+	submit([this, h, id, events]()
+	{
+		{
+			std::lock_guard<std::mutex> lock(h->mtx);
+			if (h->dead) return;
+			h->running = true;
+			h->runner = std::this_thread::get_id();
+
+			// One-shot waits are done with the fd before the callback
+			// runs; the callback may well close the original.
+			if (h->once)
+			{
+				h->dead = true;
+				epoll_ctl(_epfd, EPOLL_CTL_DEL, h->fd, nullptr);
+				::close(h->fd);
+			}
+		}
+
+		try
+		{
+			if (h->on_timer) h->on_timer();
+			else h->on_fd(events);
+		}
+		catch (const std::exception& ex)
+		{
+			report(ex.what());
+		}
+		catch (...)
+		{
+			report("unknown exception");
+		}
+
+		finish(h, id);
+		if (h->on_timer or h->once) remove(id);
+	}, h->opts);
+}
+
+void Executor::reactor_loop(void)
+{
+	struct epoll_event evs[64];
+	while (true)
+	{
+		int timeout = -1;
+		{
+			std::lock_guard<std::mutex> lock(_rmtx);
+			if (not _timers.empty())
+			{
+				auto left = _timers.begin()->first -
+					std::chrono::steady_clock::now();
+				auto ms = std::chrono::ceil<std::chrono::milliseconds>(left);
+				timeout = (ms.count() < 0) ? 0 : (int) ms.count();
+			}
+		}
+
+		int n = epoll_wait(_epfd, evs, 64, timeout);
+		for (int i = 0; i < n; i++)
+		{
+			uint64_t id = evs[i].data.u64;
+			if (0 == id)
+			{
+				uint64_t cnt;
+				ssize_t rc = ::read(_evfd, &cnt, sizeof(cnt));
+				(void) rc;
+				continue;
+			}
+			fire(id, evs[i].events);
+		}
+
+		std::vector<uint64_t> due;
+		{
+			TimePoint now = std::chrono::steady_clock::now();
+			std::lock_guard<std::mutex> lock(_rmtx);
+			while (not _timers.empty() and _timers.begin()->first <= now)
+			{
+				due.push_back(_timers.begin()->second);
+				_timers.erase(_timers.begin());
+			}
+		}
+		for (uint64_t id : due)
+			fire(id, 0);
+	}
+}
+
+std::string Executor::stats(void) const
+{
+	size_t nwatch = 0;
+	size_t ntimer = 0;
+	{
+		std::lock_guard<std::mutex> lock(_rmtx);
+		ntimer = _timers.size();
+		nwatch = _handlers.size() - ntimer;
+	}
+	return "Executor threads: " + std::to_string(_threads.size()) +
+		"\nExecutor queued: " + std::to_string(_pending.load()) +
+		"\nExecutor executed: " + std::to_string(_executed) +
+		"\nExecutor stolen: " + std::to_string(_stolen) +
+		"\nExecutor watches: " + std::to_string(nwatch) +
+		"\nExecutor timers: " + std::to_string(ntimer) + "\n";
+}
+
+// ==============================================================
+
+Strand::Strand(const Executor::Options& opts) :
+	_running(false),
+	_opts(opts)
+{
+}
+
+Strand::~Strand()
+{
+	drain();
+}
+
+void Strand::post(Executor::Task task)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		_queue.push_back(std::move(task));
+		if (_running) return;
+		_running = true;
+	}
+	Executor::instance().submit([this]() { run(); }, _opts);
+}
+
+void Strand::run(void)
+{
+	for (size_t n = 0; ; n++)
+	{
+		Executor::Task task;
+		{
+			std::lock_guard<std::mutex> lock(_mtx);
+			if (_queue.empty())
+			{
+				_running = false;
+				_idle.notify_all();
+				return;
+			}
+			if (STRAND_BATCH <= n) break;
+			task = std::move(_queue.front());
+			_queue.pop_front();
+		}
+
+		try
+		{
+			task();
+		}
+		catch (const std::exception& ex)
+		{
+			report(ex.what());
+		}
+		catch (...)
+		{
+			report("unknown exception");
+		}
+	}
+
+	// More to do; let other work in first.
+	Executor::instance().submit([this]() { run(); }, _opts);
+}
+
+void Strand::drain(void)
+{
+	std::unique_lock<std::mutex> lock(_mtx);
+	_idle.wait(lock, [this]() { return not _running; });
+}
+
+// ====================================================================
@@ -0,0 +1,243 @@
+/*
+ * opencog/atoms/sensory/Executor.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_EXECUTOR_H
+#define _OPENCOG_EXECUTOR_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// How to run a task on the Executor.
+struct ExecOptions
+{
+	/// Thread name while the task runs; at most 15 chars are used.
+	/// Must be a string constant, or otherwise outlive the task.
+	const char* name;
+	/// CPU to pin the task to, or -1 for any.
+	int cpu;
+
+	ExecOptions(const char* n = nullptr, int c = -1) : name(n), cpu(c) {}
+};
+
+/**
+ * Executor - Process-wide thread pool for background work in nodes.
+ *
+ * Nodes that wait on sockets, inotify, or request queues used to each
+ * run a thread of their own, which sits idle almost all of the time.
+ * Instead, they hand their work to the executor, as short tasks:
+ *
+ * -- submit() runs a task on one of a fixed number of worker threads.
+ *    Each worker has its own deque; a worker takes its own newest task
+ *    first, and when it runs dry, steals the oldest task of another.
+ *
+ * -- watch() runs a callback whenever a file descriptor becomes ready.
+ *    One reactor thread waits, in epoll, on all watched descriptors;
+ *    the callbacks run on the workers. A callback is never run twice
+ *    at the same time; the fd is re-armed after it returns.
+ *
+ * -- schedule() runs a task after a delay. Timers are kept by the
+ *    reactor thread, too.
+ *
+ * -- wait_fd() runs a callback once, when a file descriptor becomes
+ *    ready, or after a timeout, whichever is first. This is what the
+ *    coroutines in Async.h suspend on.
+ *
+ * unwatch() and cancel() wait for a callback that is already running
+ * to finish (unless called from that callback), so that, once they
+ * return, the owner can go away safely.
+ *
+ * The pool size is the hardware concurrency, unless configure() is
+ * called before first use, or SENSORY_EXECUTOR_THREADS is set in the
+ * environment. Tasks may be given a thread name (visible in top -H and
+ * in gdb) and a CPU to run on; both hold only for the task.
+ *
+ * Tasks should not block for long; those that do (e.g. HTTP requests)
+ * tie up a worker for the duration, and with a small pool, can starve
+ * every other node. Work like that belongs on a thread of its own, as
+ * with the OllamaNode requests. Tasks must not throw; exceptions are
+ * caught and printed.
+ */
+class Executor
+{
+public:
+	typedef std::function<void(void)> Task;
+
+	/// Callback for watch(); the argument is the epoll event mask.
+	typedef std::function<void(uint32_t)> FdCallback;
+
+	typedef ExecOptions Options;
+
+private:
+	struct Item
+	{
+		Task task;
+		Options opts;
+	};
+
+	struct Worker
+	{
+		std::mutex mtx;
+		std::deque<Item> queue;
+	};
+
+	typedef std::chrono::steady_clock::time_point TimePoint;
+
+	// A watched fd, or a timer. Keeps track of whether the callback
+	// is running, so that unwatch() and cancel() can wait for it.
+	struct Handler
+	{
+		std::mutex mtx;
+		std::condition_variable done;
+		bool running = false;
+		bool dead = false;
+		bool once = false;
+		std::thread::id runner;
+
+		int fd = -1;
+		uint32_t events = 0;
+		TimePoint when;
+		FdCallback on_fd;
+		Task on_timer;
+		Options opts;
+	};
+	typedef std::shared_ptr<Handler> HandlerPtr;
+
+	std::vector<std::unique_ptr<Worker>> _workers;
+	std::vector<std::thread> _threads;
+	std::atomic<int64_t> _pending;
+	std::atomic<size_t> _next;
+	std::mutex _sleep_mtx;
+	std::condition_variable _wake;
+
+	// Reactor state
+	int _epfd;
+	int _evfd;
+	std::thread _reactor;
+	mutable std::mutex _rmtx;
+	uint64_t _next_id;
+	std::map<uint64_t, HandlerPtr> _handlers;
+	std::set<std::pair<TimePoint, uint64_t>> _timers;
+
+	std::atomic<size_t> _executed;
+	std::atomic<size_t> _stolen;
+
+	Executor(size_t);
+	void worker_loop(size_t);
+	bool take(size_t, Item&);
+	void run(Item&);
+	void reactor_loop(void);
+	void fire(uint64_t, uint32_t);
+	void wake_reactor(void);
+	HandlerPtr remove(uint64_t);
+	void finish(const HandlerPtr&, uint64_t);
+
+public:
+	// Never destroyed; see instance().
+	Executor(const Executor&) = delete;
+	Executor& operator=(const Executor&) = delete;
+
+	/// The shared executor. Started on first use.
+	static Executor& instance(void);
+
+	/// Set the number of worker threads. Must be called before the
+	/// first call to instance(); throws otherwise.
+	static void configure(size_t nthreads);
+
+	size_t nthreads(void) const { return _threads.size(); }
+
+	void submit(Task, const Options& = Options());
+
+	/// Run the callback each time the fd is ready for the given epoll
+	/// events. Returns an id for unwatch(). The fd must stay open until
+	/// unwatch() returns.
+	uint64_t watch(int fd, uint32_t events, FdCallback,
+	               const Options& = Options());
+	void unwatch(uint64_t);
+
+	/// Run the callback once, when the fd is ready, or with a zero
+	/// event mask if the timeout passes first. The fd is dup'ed, so it
+	/// may be closed while the wait is pending; the wait then runs
+	/// into the timeout, or ends early if the close (or a shutdown())
+	/// makes the other end report EOF or an error. Throws if the fd
+	/// cannot be waited on, e.g. a plain file, which is always ready.
+	uint64_t wait_fd(int fd, uint32_t events, std::chrono::milliseconds,
+	                 FdCallback, const Options& = Options());
+
+	/// Run the task once, after the delay. Returns an id for cancel().
+	uint64_t schedule(std::chrono::milliseconds, Task,
+	                  const Options& = Options());
+
+	/// Returns false if the timer had already fired (or was never
+	/// set); true if this call stopped it from firing.
+	bool cancel(uint64_t);
+
+	std::string stats(void) const;
+};
+
+/**
+ * Strand - Runs tasks on the executor one at a time, in order.
+ *
+ * For work that must be serialized, such as a queue of requests to a
+ * server, without tying up a thread while the queue is empty.
+ * drain() waits for everything posted so far to finish; the
+ * destructor drains.
+ */
+class Strand
+{
+	std::mutex _mtx;
+	std::condition_variable _idle;
+	std::deque<Executor::Task> _queue;
+	bool _running;
+	Executor::Options _opts;
+
+	void run(void);
+
+public:
+	Strand(const Executor::Options& = Executor::Options());
+	~Strand();
+
+	Strand(const Strand&) = delete;
+	Strand& operator=(const Strand&) = delete;
+
+	void post(Executor::Task);
+
+	/// Must not be called from a task on this strand.
+	void drain(void);
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_EXECUTOR_H
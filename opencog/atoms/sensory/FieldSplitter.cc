@@ -0,0 +1,159 @@
+/*
+ * opencog/atoms/sensory/FieldSplitter.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string.h>
+
+#include <charconv>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "FieldSplitter.h"
+
+using namespace opencog;
+
+FieldSplitter::FieldSplitter(char delim, bool quoting, bool numeric) :
+	_delim(delim),
+	_quoting(quoting),
+	_numeric(numeric)
+{
+}
+
+// ==============================================================
+
+// Offset of the next delimiter at or after `from`, or `len` if none.
+size_t FieldSplitter::find_delim(const char* p, size_t len, size_t from) const
+{
+	size_t i = from;
+
+#ifdef __SSE2__
+	const __m128i dl = _mm_set1_epi8(_delim);
+	for (; i + 16 <= len; i += 16)
+	{
+		__m128i blk = _mm_loadu_si128((const __m128i*) (p + i));
+		unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(blk, dl));
+		if (mask) return i + __builtin_ctz(mask);
+	}
+#endif
+
+	for (; i < len; i++)
+		if (_delim == p[i]) return i;
+	return len;
+}
+
+// Copy out the quoted field starting at `from`, which must be a
+// quote. Anything between the closing quote and the next delimiter
+// is kept as-is. Returns the offset of that delimiter, or `len`.
+size_t FieldSplitter::unquote(const char* p, size_t len, size_t from,
+                              std::string& field) const
+{
+	size_t i = from + 1;
+	while (i < len)
+	{
+		const char* q = (const char*) memchr(p + i, '"', len - i);
+		if (nullptr == q)
+		{
+			// Unterminated; take the rest of the line.
+			field.append(p + i, len - i);
+			return len;
+		}
+		size_t j = q - p;
+		field.append(p + i, j - i);
+
+		// A doubled quote is a literal quote.
+		if (j + 1 < len and '"' == p[j + 1])
+		{
+			field.push_back('"');
+			i = j + 2;
+			continue;
+		}
+
+		size_t d = find_delim(p, len, j + 1);
+		field.append(p + j + 1, d - j - 1);
+		return d;
+	}
+	return len;
+}
+
+// Call `fn(ptr, len)` for each field of the line. Unquoted fields
+// are passed in place, without copying.
+template<typename F>
+void FieldSplitter::each_field(const std::string& line, const F& fn) const
+{
+	const char* p = line.data();
+	size_t len = line.size();
+	if (0 < len and '\n' == p[len-1]) len--;
+	if (0 < len and '\r' == p[len-1]) len--;
+
+	size_t start = 0;
+	std::string buf;
+	while (true)
+	{
+		size_t d;
+		if (_quoting and start < len and '"' == p[start])
+		{
+			buf.clear();
+			d = unquote(p, len, start, buf);
+			fn(buf.data(), buf.size());
+		}
+		else
+		{
+			d = find_delim(p, len, start);
+			fn(p + start, d - start);
+		}
+		if (len <= d) return;
+		start = d + 1;
+	}
+}
+
+void FieldSplitter::split(const std::string& line,
+                          std::vector<std::string>& fields) const
+{
+	each_field(line, [&](const char* f, size_t n) {
+		fields.emplace_back(f, n);
+	});
+}
+
+void FieldSplitter::split(const std::string& line,
+                          std::vector<double>& nums) const
+{
+	each_field(line, [&](const char* b, size_t n) {
+		const char* e = b + n;
+		while (b < e and (' ' == *b or '\t' == *b)) b++;
+		while (b < e and (' ' == e[-1] or '\t' == e[-1])) e--;
+		if (b < e and '+' == *b) b++;
+
+		double x = NAN;
+		std::from_chars_result rc = std::from_chars(b, e, x);
+		if (rc.ec != std::errc() or rc.ptr != e or b == e) x = NAN;
+		nums.push_back(x);
+	});
+}
+
+std::string FieldSplitter::to_string(void) const
+{
+	std::string rpt = "Field delimiter: ";
+	if ('\t' == _delim) rpt += "\\t";
+	else rpt += _delim;
+	rpt += _quoting ? "\nQuoting: yes\n" : "\nQuoting: no\n";
+	rpt += _numeric ? "Numeric: yes\n" : "Numeric: no\n";
+	return rpt;
+}
+
+// ====================================================================
@@ -0,0 +1,76 @@
+/*
+ * opencog/atoms/sensory/FieldSplitter.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_FIELD_SPLITTER_H
+#define _OPENCOG_FIELD_SPLITTER_H
+
+#include <string>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * FieldSplitter - Split delimiter-separated records into fields.
+ *
+ * Handles CSV, TSV and the like. The trailing newline (or CRLF) is
+ * dropped, and the rest split at each delimiter. Delimiters are
+ * found sixteen bytes at a time.
+ *
+ * If quoting is on, a field that starts with a double-quote runs to
+ * the matching closing quote, and may contain delimiters; a doubled
+ * quote inside it stands for one quote. Quotes anywhere else are
+ * ordinary characters. Quoted fields cannot span lines.
+ *
+ * In numeric mode, each field is parsed as a floating point number;
+ * fields that are not numbers become NaN.
+ */
+class FieldSplitter
+{
+private:
+	char _delim;
+	bool _quoting;
+	bool _numeric;
+
+	size_t find_delim(const char*, size_t len, size_t from) const;
+	size_t unquote(const char*, size_t len, size_t from,
+	               std::string&) const;
+
+	template<typename F>
+	void each_field(const std::string&, const F&) const;
+
+public:
+	FieldSplitter(char delim, bool quoting, bool numeric);
+
+	bool numeric(void) const { return _numeric; }
+
+	/// Split the line into fields.
+	void split(const std::string&, std::vector<std::string>&) const;
+
+	/// Split the line into fields, and parse each as a number.
+	void split(const std::string&, std::vector<double>&) const;
+
+	std::string to_string(void) const;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_FIELD_SPLITTER_H
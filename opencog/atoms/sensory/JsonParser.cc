@@ -0,0 +1,417 @@
+/*
+ * opencog/atoms/sensory/JsonParser.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string.h>
+
+#include <charconv>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "JsonParser.h"
+
+using namespace opencog;
+
+// Deeper nesting than this is rejected, rather than risking the stack.
+#define JSON_MAX_DEPTH 1024
+
+JsonParser::JsonParser(void) :
+	_start(nullptr),
+	_p(nullptr),
+	_end(nullptr),
+	_depth(0)
+{
+}
+
+bool JsonParser::fail(const char* msg)
+{
+	if (_error.empty())
+		_error = std::string(msg) + " at offset " +
+			std::to_string(_p - _start);
+	return false;
+}
+
+bool JsonParser::parse(const char* buf, size_t len)
+{
+	_tape.clear();
+	_strings.clear();
+	_error.clear();
+	_start = buf;
+	_p = buf;
+	_end = buf + len;
+	_depth = 0;
+
+	if (not parse_value())
+	{
+		_tape.clear();
+		return false;
+	}
+
+	skip_ws();
+	if (_p != _end)
+	{
+		_tape.clear();
+		return fail("Trailing garbage");
+	}
+	return true;
+}
+
+JsonParser::Ref JsonParser::root(void) const
+{
+	if (_tape.empty()) return Ref();
+	return Ref(this, 0);
+}
+
+// ==============================================================
+
+void JsonParser::skip_ws(void)
+{
+	while (_p < _end and
+	       (' ' == *_p or '\n' == *_p or '\r' == *_p or '\t' == *_p))
+		_p++;
+}
+
+bool JsonParser::parse_value(void)
+{
+	skip_ws();
+	if (_p >= _end) return fail("Unexpected end of input");
+
+	switch (*_p)
+	{
+		case '{': return parse_object();
+		case '[': return parse_array();
+		case '"': return parse_string();
+		case 't': return parse_literal("true", 4, TRUE);
+		case 'f': return parse_literal("false", 5, FALSE);
+		case 'n': return parse_literal("null", 4, NUL);
+		default: return parse_number();
+	}
+}
+
+bool JsonParser::parse_literal(const char* lit, size_t len, Kind kind)
+{
+	if ((size_t) (_end - _p) < len or memcmp(_p, lit, len))
+		return fail("Bad literal");
+	_p += len;
+
+	uint32_t idx = _tape.size();
+	_tape.push_back({kind, idx + 1, 0, 0, 0, 0.0});
+	return true;
+}
+
+bool JsonParser::parse_number(void)
+{
+	const char* b = _p;
+	if (b < _end and '-' != *b and ('0' > *b or *b > '9'))
+		return fail("Unexpected character");
+
+	double x = 0.0;
+	std::from_chars_result rc = std::from_chars(b, _end, x);
+	if (rc.ec != std::errc() and rc.ec != std::errc::result_out_of_range)
+		return fail("Bad number");
+	_p = rc.ptr;
+
+	uint32_t idx = _tape.size();
+	_tape.push_back({NUMBER, idx + 1, 0, 0, 0, x});
+	return true;
+}
+
+// Append the UTF-8 encoding of the \uXXXX escape that `_p` points
+// into (just past the 'u'), including a following low surrogate.
+static const char* decode_u(const char* p, const char* end, std::string& out)
+{
+	auto hex4 = [&](const char* q, uint32_t& cp) {
+		if (end - q < 4) return false;
+		std::from_chars_result rc = std::from_chars(q, q + 4, cp, 16);
+		return rc.ec == std::errc() and rc.ptr == q + 4;
+	};
+
+	uint32_t cp;
+	if (not hex4(p, cp)) return nullptr;
+	p += 4;
+
+	// UTF-16 surrogate pairs, for U+10000 and above.
+	uint32_t lo;
+	if (0xD800 <= cp and cp <= 0xDBFF and 6 <= end - p and
+	    '\\' == p[0] and 'u' == p[1] and hex4(p + 2, lo) and
+	    0xDC00 <= lo and lo <= 0xDFFF)
+	{
+		cp = 0x10000 + (cp - 0xD800) * 0x400 + (lo - 0xDC00);
+		p += 6;
+	}
+
+	if (cp < 0x80)
+		out += (char) cp;
+	else if (cp < 0x800)
+	{
+		out += (char) (0xC0 | (cp >> 6));
+		out += (char) (0x80 | (cp & 0x3F));
+	}
+	else if (cp < 0x10000)
+	{
+		out += (char) (0xE0 | (cp >> 12));
+		out += (char) (0x80 | ((cp >> 6) & 0x3F));
+		out += (char) (0x80 | (cp & 0x3F));
+	}
+	else
+	{
+		out += (char) (0xF0 | (cp >> 18));
+		out += (char) (0x80 | ((cp >> 12) & 0x3F));
+		out += (char) (0x80 | ((cp >> 6) & 0x3F));
+		out += (char) (0x80 | (cp & 0x3F));
+	}
+	return p;
+}
+
+// Offset of the next quote, backslash or control character.
+static size_t find_special(const char* p, size_t len)
+{
+	size_t i = 0;
+
+#ifdef __SSE2__
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i bslash = _mm_set1_epi8('\\');
+	const __m128i ctrl = _mm_set1_epi8(0x1F);
+	for (; i + 16 <= len; i += 16)
+	{
+		__m128i blk = _mm_loadu_si128((const __m128i*) (p + i));
+		__m128i hit = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(blk, quote),
+			             _mm_cmpeq_epi8(blk, bslash)),
+			// Unsigned blk <= 0x1F
+			_mm_cmpeq_epi8(_mm_max_epu8(blk, ctrl), ctrl));
+		unsigned int mask = _mm_movemask_epi8(hit);
+		if (mask) return i + __builtin_ctz(mask);
+	}
+#endif
+
+	for (; i < len; i++)
+	{
+		unsigned char c = p[i];
+		if ('"' == c or '\\' == c or c < 0x20) return i;
+	}
+	return len;
+}
+
+bool JsonParser::parse_string(void)
+{
+	_p++;  // Opening quote
+	size_t off = _strings.size();
+
+	while (true)
+	{
+		size_t n = find_special(_p, _end - _p);
+		_strings.append(_p, n);
+		_p += n;
+		if (_p >= _end) return fail("Unterminated string");
+
+		char c = *_p;
+		if ('"' == c) break;
+		if ('\\' != c) return fail("Control character in string");
+
+		if (_end - _p < 2) return fail("Unterminated string");
+		_p += 2;
+		switch (_p[-1])
+		{
+			case '"':  _strings += '"'; break;
+			case '\\': _strings += '\\'; break;
+			case '/':  _strings += '/'; break;
+			case 'b':  _strings += '\b'; break;
+			case 'f':  _strings += '\f'; break;
+			case 'n':  _strings += '\n'; break;
+			case 'r':  _strings += '\r'; break;
+			case 't':  _strings += '\t'; break;
+			case 'u':
+				_p = decode_u(_p, _end, _strings);
+				if (nullptr == _p)
+				{
+					_p = _end;
+					return fail("Bad \\u escape");
+				}
+				break;
+			default: return fail("Bad escape");
+		}
+	}
+	_p++;  // Closing quote
+
+	uint32_t idx = _tape.size();
+	_tape.push_back({STRING, idx + 1, 0, (uint32_t) off,
+		(uint32_t) (_strings.size() - off), 0.0});
+	return true;
+}
+
+bool JsonParser::parse_array(void)
+{
+	if (JSON_MAX_DEPTH < ++_depth) return fail("Nested too deeply");
+	_p++;
+
+	uint32_t idx = _tape.size();
+	_tape.push_back({ARRAY, 0, 0, 0, 0, 0.0});
+
+	uint32_t count = 0;
+	skip_ws();
+	if (_p < _end and ']' == *_p)
+		_p++;
+	else while (true)
+	{
+		if (not parse_value()) return false;
+		count++;
+		skip_ws();
+		if (_p >= _end) return fail("Unterminated array");
+		if (']' == *_p) { _p++; break; }
+		if (',' != *_p) return fail("Expecting , or ]");
+		_p++;
+	}
+
+	_tape[idx].end = _tape.size();
+	_tape[idx].count = count;
+	_depth--;
+	return true;
+}
+
+bool JsonParser::parse_object(void)
+{
+	if (JSON_MAX_DEPTH < ++_depth) return fail("Nested too deeply");
+	_p++;
+
+	uint32_t idx = _tape.size();
+	_tape.push_back({OBJECT, 0, 0, 0, 0, 0.0});
+
+	uint32_t count = 0;
+	skip_ws();
+	if (_p < _end and '}' == *_p)
+		_p++;
+	else while (true)
+	{
+		skip_ws();
+		if (_p >= _end or '"' != *_p) return fail("Expecting a key");
+		if (not parse_string()) return false;
+		skip_ws();
+		if (_p >= _end or ':' != *_p) return fail("Expecting :");
+		_p++;
+		if (not parse_value()) return false;
+		count++;
+		skip_ws();
+		if (_p >= _end) return fail("Unterminated object");
+		if ('}' == *_p) { _p++; break; }
+		if (',' != *_p) return fail("Expecting , or }");
+		_p++;
+	}
+
+	_tape[idx].end = _tape.size();
+	_tape[idx].count = count;
+	_depth--;
+	return true;
+}
+
+// ==============================================================
+
+std::string_view JsonParser::Ref::as_string(void) const
+{
+	if (not is_string()) return std::string_view();
+	const Node& n = node();
+	return std::string_view(_doc->_strings.data() + n.str_off, n.str_len);
+}
+
+double JsonParser::Ref::as_number(void) const
+{
+	return is_number() ? node().num : 0.0;
+}
+
+size_t JsonParser::Ref::size(void) const
+{
+	if (not is_array() and not is_object()) return 0;
+	return node().count;
+}
+
+JsonParser::Ref JsonParser::Ref::operator[](std::string_view k) const
+{
+	if (not is_object()) return Ref();
+
+	// Members are key, value, key, value ...
+	uint32_t end = node().end;
+	uint32_t i = _idx + 1;
+	while (i < end)
+	{
+		Ref key(_doc, i);
+		uint32_t val = _doc->_tape[i].end;
+		if (key.as_string() == k) return Ref(_doc, val);
+		i = _doc->_tape[val].end;
+	}
+	return Ref();
+}
+
+JsonParser::Ref JsonParser::Ref::at(size_t pos) const
+{
+	if (pos >= size()) return Ref();
+
+	uint32_t i = _idx + 1;
+	if (is_object())
+	{
+		for (size_t j = 0; j < pos; j++)
+			i = _doc->_tape[_doc->_tape[i].end].end;
+		return Ref(_doc, _doc->_tape[i].end);
+	}
+
+	for (size_t j = 0; j < pos; j++)
+		i = _doc->_tape[i].end;
+	return Ref(_doc, i);
+}
+
+std::string_view JsonParser::Ref::key(size_t pos) const
+{
+	if (not is_object() or pos >= size()) return std::string_view();
+
+	uint32_t i = _idx + 1;
+	for (size_t j = 0; j < pos; j++)
+		i = _doc->_tape[_doc->_tape[i].end].end;
+	return Ref(_doc, i).as_string();
+}
+
+// ==============================================================
+
+std::string JsonParser::escape(std::string_view s)
+{
+	static const char hex[] = "0123456789abcdef";
+	std::string result;
+	result.reserve(s.size() + 16);
+	for (char c : s)
+	{
+		switch (c)
+		{
+			case '"':  result += "\\\""; break;
+			case '\\': result += "\\\\"; break;
+			case '\n': result += "\\n"; break;
+			case '\r': result += "\\r"; break;
+			case '\t': result += "\\t"; break;
+			default:
+				if ((unsigned char) c < 0x20)
+				{
+					result += "\\u00";
+					result += hex[(c >> 4) & 0xF];
+					result += hex[c & 0xF];
+				}
+				else
+					result += c;
+				break;
+		}
+	}
+	return result;
+}
+
+// ====================================================================
@@ -0,0 +1,159 @@
+/*
+ * opencog/atoms/sensory/JsonParser.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_JSON_PARSER_H
+#define _OPENCOG_JSON_PARSER_H
+
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * JsonParser - Small, fast JSON parser.
+ *
+ * The document is parsed in one pass into a flat "tape" of nodes, in
+ * document order; each node records where its subtree ends, so that
+ * skipping over a value is a single step. Decoded strings all go into
+ * one shared buffer. Both the tape and the buffer are kept between
+ * parses, so that parsing a stream of small documents (e.g. JSON
+ * lines) does not allocate once the buffers have grown to size.
+ *
+ * String contents, where most of the bytes usually are, are scanned
+ * sixteen bytes at a time for quotes, backslashes and control chars.
+ * Numbers are converted with std::from_chars.
+ *
+ * Not thread-safe; use one parser per thread. A Ref is valid until
+ * the next parse.
+ */
+class JsonParser
+{
+public:
+	enum Kind : uint8_t
+	{
+		NUL,
+		FALSE,
+		TRUE,
+		NUMBER,
+		STRING,
+		ARRAY,
+		OBJECT
+	};
+
+private:
+	struct Node
+	{
+		Kind kind;
+		uint32_t end;      // Tape index just past this subtree.
+		uint32_t count;    // Array elements, or object members.
+		uint32_t str_off;  // Strings: offset into _strings.
+		uint32_t str_len;
+		double num;
+	};
+
+	std::vector<Node> _tape;
+	std::string _strings;
+	std::string _error;
+
+	const char* _start;
+	const char* _p;
+	const char* _end;
+	size_t _depth;
+
+	bool fail(const char*);
+	void skip_ws(void);
+	bool parse_value(void);
+	bool parse_string(void);
+	bool parse_number(void);
+	bool parse_literal(const char*, size_t, Kind);
+	bool parse_array(void);
+	bool parse_object(void);
+
+public:
+	class Ref
+	{
+		friend class JsonParser;
+		const JsonParser* _doc;
+		uint32_t _idx;
+		Ref(const JsonParser* d, uint32_t i) : _doc(d), _idx(i) {}
+		const Node& node(void) const { return _doc->_tape[_idx]; }
+
+	public:
+		Ref(void) : _doc(nullptr), _idx(0) {}
+
+		/// False for a missing key or index.
+		bool valid(void) const { return nullptr != _doc; }
+		Kind kind(void) const { return valid() ? node().kind : NUL; }
+
+		bool is_string(void) const { return STRING == kind(); }
+		bool is_number(void) const { return NUMBER == kind(); }
+		bool is_array(void) const { return ARRAY == kind(); }
+		bool is_object(void) const { return OBJECT == kind(); }
+
+		/// Empty if not a string.
+		std::string_view as_string(void) const;
+		/// Zero if not a number.
+		double as_number(void) const;
+		bool as_bool(void) const { return TRUE == kind(); }
+
+		/// Number of array elements, or object members.
+		size_t size(void) const;
+
+		/// Object member by key; not valid() if missing.
+		Ref operator[](std::string_view) const;
+
+		/// Array element, or object member value, by position.
+		Ref at(size_t) const;
+
+		/// Object member key, by position.
+		std::string_view key(size_t) const;
+
+		/// The value just after this one, in document order, skipping
+		/// over its insides. For walking an array in linear time: from
+		/// at(0), call next() size()-1 times. In an object, keys and
+		/// values alternate: the next() of a member value is the key
+		/// of the member after it.
+		Ref next(void) const { return Ref(_doc, node().end); }
+	};
+
+	JsonParser(void);
+
+	/// Parse the document. Returns false, and sets error(), if it is
+	/// not valid JSON.
+	bool parse(const char*, size_t);
+	bool parse(const std::string& s) { return parse(s.data(), s.size()); }
+
+	const std::string& error(void) const { return _error; }
+
+	/// The top-level value. Not valid() if the last parse failed.
+	Ref root(void) const;
+
+	/// Escape a string for embedding in a JSON document.
+	static std::string escape(std::string_view);
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_JSON_PARSER_H
@@ -0,0 +1,96 @@
+/*
+ * opencog/atoms/sensory/LineFilter.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string.h>
+
+#include <opencog/util/exceptions.h>
+
+#include "LineFilter.h"
+
+using namespace opencog;
+
+LineFilter::LineFilter(Kind kind, const std::string& pattern) :
+	_kind(kind),
+	_pattern(pattern),
+	_hits(0),
+	_misses(0)
+{
+	if (REGEX != _kind) return;
+
+	// REG_NEWLINE so that `$` matches before the trailing newline.
+	int rc = regcomp(&_regex, _pattern.c_str(),
+		REG_EXTENDED | REG_NOSUB | REG_NEWLINE);
+	if (rc)
+	{
+		char buf[256];
+		regerror(rc, &_regex, buf, sizeof(buf));
+		throw RuntimeException(TRACE_INFO,
+			"Bad filter regex \"%s\": %s\n", _pattern.c_str(), buf);
+	}
+}
+
+LineFilter::~LineFilter()
+{
+	if (REGEX == _kind)
+		regfree(&_regex);
+}
+
+LineFilter::Kind LineFilter::kind_from_name(const std::string& name)
+{
+	if (0 == name.compare("substring")) return SUBSTRING;
+	if (0 == name.compare("prefix")) return PREFIX;
+	if (0 == name.compare("regex")) return REGEX;
+	throw RuntimeException(TRACE_INFO,
+		"Unknown filter kind \"%s\"; expecting substring, prefix or regex\n",
+		name.c_str());
+}
+
+bool LineFilter::match(const std::string& line) const
+{
+	bool keep;
+	switch (_kind)
+	{
+		case SUBSTRING:
+			keep = nullptr != memmem(line.data(), line.size(),
+				_pattern.data(), _pattern.size());
+			break;
+		case PREFIX:
+			keep = 0 == line.compare(0, _pattern.size(), _pattern);
+			break;
+		default:
+			// glibc regexec is safe to call from many threads.
+			keep = 0 == regexec(&_regex, line.c_str(), 0, nullptr, 0);
+			break;
+	}
+
+	if (keep) _hits++;
+	else _misses++;
+	return keep;
+}
+
+std::string LineFilter::to_string(void) const
+{
+	static const char* names[] = { "substring", "prefix", "regex" };
+	std::string rpt = "Filter: ";
+	rpt += names[_kind];
+	rpt += " \"" + _pattern + "\"\n";
+	rpt += "Filter hits: " + std::to_string(_hits) + "\n";
+	rpt += "Filter misses: " + std::to_string(_misses) + "\n";
+	return rpt;
+}
+
+// ====================================================================
@@ -0,0 +1,86 @@
+/*
+ * opencog/atoms/sensory/LineFilter.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_LINE_FILTER_H
+#define _OPENCOG_LINE_FILTER_H
+
+#include <regex.h>
+
+#include <atomic>
+#include <string>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * LineFilter - Decide which lines of text to keep.
+ *
+ * A line is kept if it contains a literal substring, starts with a
+ * literal prefix, or matches a POSIX extended regular expression.
+ * This runs on the raw line, before it is turned into a Value, so
+ * that rejected lines cost nothing more than the test itself.
+ *
+ * Counts of kept (hit) and rejected (miss) lines are kept, for the
+ * monitor.
+ */
+class LineFilter
+{
+public:
+	enum Kind
+	{
+		SUBSTRING,
+		PREFIX,
+		REGEX
+	};
+
+private:
+	Kind _kind;
+	std::string _pattern;
+	regex_t _regex;
+
+	mutable std::atomic<size_t> _hits;
+	mutable std::atomic<size_t> _misses;
+
+public:
+	/// @throws RuntimeException if the regex does not compile.
+	LineFilter(Kind, const std::string&);
+	~LineFilter();
+
+	// Prevent copying
+	LineFilter(const LineFilter&) = delete;
+	LineFilter& operator=(const LineFilter&) = delete;
+
+	/// Kind from its name: "substring", "prefix" or "regex".
+	/// @throws RuntimeException for anything else.
+	static Kind kind_from_name(const std::string&);
+
+	/// True if the line should be kept. Updates the counts.
+	bool match(const std::string&) const;
+
+	size_t hits(void) const { return _hits; }
+	size_t misses(void) const { return _misses; }
+
+	std::string to_string(void) const;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_LINE_FILTER_H
@@ -0,0 +1,156 @@
+/*
+ * opencog/atoms/sensory/LineNormalizer.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "LineNormalizer.h"
+
+using namespace opencog;
+
+LineNormalizer::LineNormalizer(bool trim, Utf8Mode utf8) :
+	_trim(trim),
+	_utf8(utf8),
+	_repaired(0),
+	_dropped(0)
+{
+}
+
+// ==============================================================
+
+// Length of the valid, non-ASCII UTF-8 character at `p`, or zero if
+// it is not valid; in that case, `skip` is set to the length of the
+// bad part, per the Unicode "maximal subpart" rule. The ranges are
+// those of table 3-7 in the Unicode standard; they exclude overlong
+// forms, surrogates, and anything past U+10FFFF.
+static size_t seq_len(const unsigned char* p, size_t n, size_t& skip)
+{
+	unsigned char c = p[0];
+	unsigned char lo = 0x80;
+	unsigned char hi = 0xBF;
+	size_t len;
+
+	if (0xC2 <= c and c <= 0xDF) len = 2;
+	else if (0xE0 == c) { len = 3; lo = 0xA0; }
+	else if (0xE1 <= c and c <= 0xEC) len = 3;
+	else if (0xED == c) { len = 3; hi = 0x9F; }
+	else if (0xEE <= c and c <= 0xEF) len = 3;
+	else if (0xF0 == c) { len = 4; lo = 0x90; }
+	else if (0xF1 <= c and c <= 0xF3) len = 4;
+	else if (0xF4 == c) { len = 4; hi = 0x8F; }
+	else { skip = 1; return 0; }
+
+	for (size_t i = 1; i < len; i++)
+	{
+		if (n <= i) { skip = i; return 0; }
+		unsigned char b = p[i];
+		if (b < (1 == i ? lo : 0x80) or (1 == i ? hi : 0xBF) < b)
+		{
+			skip = i;
+			return 0;
+		}
+	}
+	return len;
+}
+
+size_t LineNormalizer::find_invalid(const char* buf, size_t len)
+{
+	const unsigned char* p = (const unsigned char*) buf;
+	size_t i = 0;
+	while (i < len)
+	{
+#ifdef __SSE2__
+		// Skip ASCII; the movemask picks up the high bit of each byte.
+		while (i + 16 <= len)
+		{
+			__m128i blk = _mm_loadu_si128((const __m128i*) (p + i));
+			unsigned int mask = _mm_movemask_epi8(blk);
+			if (mask) { i += __builtin_ctz(mask); break; }
+			i += 16;
+		}
+		if (len <= i) break;
+#endif
+		if (p[i] < 0x80) { i++; continue; }
+
+		size_t skip;
+		size_t n = seq_len(p + i, len - i, skip);
+		if (0 == n) return i;
+		i += n;
+	}
+	return len;
+}
+
+bool LineNormalizer::normalize(std::string& line) const
+{
+	if (_trim)
+	{
+		size_t n = line.size();
+		if (0 < n and '\n' == line[n-1]) n--;
+		if (0 < n and '\r' == line[n-1]) n--;
+		line.resize(n);
+	}
+
+	if (UTF8_NONE == _utf8) return true;
+
+	size_t bad = find_invalid(line.data(), line.size());
+	if (line.size() == bad) return true;
+
+	if (UTF8_VALIDATE == _utf8)
+	{
+		_dropped++;
+		return false;
+	}
+
+	// Repair. Copy the good prefix, and go on from there.
+	const unsigned char* p = (const unsigned char*) line.data();
+	size_t len = line.size();
+	std::string out;
+	out.reserve(len + 8);
+	out.append(line, 0, bad);
+
+	size_t i = bad;
+	while (i < len)
+	{
+		size_t good = find_invalid((const char*) p + i, len - i);
+		out.append((const char*) p + i, good);
+		i += good;
+		if (len <= i) break;
+
+		size_t skip;
+		seq_len(p + i, len - i, skip);
+		out += "\xEF\xBF\xBD";
+		i += skip;
+	}
+	line.swap(out);
+	_repaired++;
+	return true;
+}
+
+std::string LineNormalizer::to_string(void) const
+{
+	static const char* modes[] = { "none", "validate", "repair" };
+	std::string rpt = "Normalize trim: ";
+	rpt += _trim ? "yes\n" : "no\n";
+	rpt += "Normalize UTF-8: ";
+	rpt += modes[_utf8];
+	rpt += "\nNormalize repaired: " + std::to_string(_repaired) + "\n";
+	rpt += "Normalize dropped: " + std::to_string(_dropped) + "\n";
+	return rpt;
+}
+
+// ====================================================================
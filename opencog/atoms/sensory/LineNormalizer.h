@@ -0,0 +1,79 @@
+/*
+ * opencog/atoms/sensory/LineNormalizer.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_LINE_NORMALIZER_H
+#define _OPENCOG_LINE_NORMALIZER_H
+
+#include <atomic>
+#include <string>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * LineNormalizer - Clean up lines of text as they are read.
+ *
+ * Optionally trims the line terminator (LF or CRLF), and optionally
+ * checks that the line is valid UTF-8. Invalid lines are either
+ * dropped, or repaired, by replacing each bad byte sequence with
+ * U+FFFD, the replacement character.
+ *
+ * The UTF-8 check skips over pure-ASCII stretches sixteen bytes at a
+ * time; only multi-byte characters are looked at byte by byte. Lines
+ * that are already valid are not copied.
+ */
+class LineNormalizer
+{
+public:
+	enum Utf8Mode
+	{
+		UTF8_NONE,
+		UTF8_VALIDATE,
+		UTF8_REPAIR
+	};
+
+private:
+	bool _trim;
+	Utf8Mode _utf8;
+
+	mutable std::atomic<size_t> _repaired;
+	mutable std::atomic<size_t> _dropped;
+
+public:
+	LineNormalizer(bool trim, Utf8Mode);
+
+	// Prevent copying
+	LineNormalizer(const LineNormalizer&) = delete;
+	LineNormalizer& operator=(const LineNormalizer&) = delete;
+
+	/// Normalize the line in place. Returns false if the line should
+	/// be dropped.
+	bool normalize(std::string&) const;
+
+	/// Offset of the first invalid UTF-8 byte, or `len` if none.
+	static size_t find_invalid(const char*, size_t len);
+
+	std::string to_string(void) const;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_LINE_NORMALIZER_H
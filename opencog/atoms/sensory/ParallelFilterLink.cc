@@ -0,0 +1,102 @@
+/*
+ * opencog/atoms/sensory/ParallelFilterLink.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/core/NumberNode.h>
+
+#include <opencog/sensory/types/atom_types.h>
+#include "Executor.h"
+#include "ParallelFilterLink.h"
+#include "ParallelStream.h"
+
+using namespace opencog;
+
+ParallelFilterLink::ParallelFilterLink(const HandleSeq&& oset, Type t)
+	: Link(std::move(oset), t), _nworkers(0), _window(0)
+{
+	if (not nameserver().isA(t, PARALLEL_FILTER_LINK))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting a ParallelFilterLink, got %s", tname.c_str());
+	}
+	init();
+}
+
+void ParallelFilterLink::init(void)
+{
+	size_t sz = _outgoing.size();
+	if (2 != sz and 3 != sz)
+		throw SyntaxException(TRACE_INFO,
+			"Expecting a rule, a source, and optional sizes; got %s",
+			to_string().c_str());
+
+	if (2 == sz) return;
+
+	if (not _outgoing[2]->is_type(NUMBER_NODE))
+		throw SyntaxException(TRACE_INFO,
+			"Expecting the sizes to be a NumberNode; got %s",
+			_outgoing[2]->to_string().c_str());
+
+	const std::vector<double>& sizes =
+		NumberNodeCast(_outgoing[2])->value();
+	if (0 == sizes.size() or 2 < sizes.size() or sizes[0] < 1.0 or
+	    (2 == sizes.size() and sizes[1] < sizes[0]))
+		throw SyntaxException(TRACE_INFO,
+			"Expecting at least one worker, and a window no smaller "
+			"than that; got %s", _outgoing[2]->to_string().c_str());
+
+	_nworkers = (size_t) sizes[0];
+	if (2 == sizes.size()) _window = (size_t) sizes[1];
+}
+
+// ---------------------------------------------------------------
+
+ValuePtr ParallelFilterLink::execute(AtomSpace* as, bool silent)
+{
+	size_t nworkers = _nworkers;
+	if (0 == nworkers) nworkers = Executor::instance().nthreads();
+	size_t window = _window;
+	if (0 == window) window = 4 * nworkers;
+
+	bool ordered = not nameserver().isA(_type, UNORDERED_FILTER_LINK);
+
+	const Handle& rule(_outgoing[0]);
+	const Handle& src(_outgoing[1]);
+	if (src->is_type(SENSORY_NODE))
+		return createParallelStream(rule, SensoryNodeCast(src), as,
+			nworkers, window, ordered);
+
+	ValuePtr vp;
+	if (src->is_executable()) vp = src->execute(as, silent);
+	if (nullptr == vp or vp->is_type(VOID_VALUE))
+		throw RuntimeException(TRACE_INFO,
+			"Expecting the source to be a SensoryNode or a stream; got %s",
+			src->to_string().c_str());
+
+	if (vp->is_type(SENSORY_NODE))
+		return createParallelStream(rule, SensoryNodeCast(vp), as,
+			nworkers, window, ordered);
+
+	return createParallelStream(rule, vp, as, nworkers, window, ordered);
+}
+
+// Adds factory when library is loaded. UnorderedFilterLink, being a
+// subtype, gets the same factory.
+DEFINE_LINK_FACTORY(ParallelFilterLink, PARALLEL_FILTER_LINK)
+
+/* ===================== END OF FILE ===================== */
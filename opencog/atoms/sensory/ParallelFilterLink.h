@@ -0,0 +1,84 @@
+/*
+ * opencog/atoms/sensory/ParallelFilterLink.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_PARALLEL_FILTER_LINK_H
+#define _OPENCOG_PARALLEL_FILTER_LINK_H
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/sensory/types/atom_types.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * ParallelFilterLink - Apply a rule to each item of a stream, on
+ * several threads at once.
+ *
+ *    (ParallelFilter rule source)
+ *    (ParallelFilter rule source (Number nworkers))
+ *    (ParallelFilter rule source (Number nworkers window))
+ *
+ * When executed, returns a ParallelStream, whose samples are the
+ * results of applying the RuleLink to the items of the source, one
+ * at a time, in the same order. Each result is what
+ * (Filter rule item) would have given.
+ *
+ * The source is a SensoryNode, or anything that executes to one, or
+ * to a stream Value, such as the StringStream from *-stream-*. Note
+ * that the rule sees each item, and not the stream: a variable typed
+ * (Type 'StringStream) in a rule used with FilterLink becomes
+ * (Type 'StringValue) here.
+ *
+ * The number of workers defaults to the size of the Executor pool.
+ * The window, the most items read ahead of the consumer, defaults to
+ * four times that; it bounds the memory used for results that are
+ * done, but are waiting for an earlier, slower one.
+ *
+ * UnorderedFilterLink does the same, but gives the results in the
+ * order in which they are finished; a slow item does not hold up the
+ * ones after it.
+ */
+class ParallelFilterLink : public Link
+{
+protected:
+	size_t _nworkers;
+	size_t _window;
+
+	void init(void);
+
+public:
+	ParallelFilterLink(const HandleSeq&&, Type = PARALLEL_FILTER_LINK);
+
+	ParallelFilterLink(const ParallelFilterLink&) = delete;
+	ParallelFilterLink& operator=(const ParallelFilterLink&) = delete;
+
+	virtual ValuePtr execute(AtomSpace*, bool);
+	virtual bool is_executable(void) const { return true; }
+
+	static Handle factory(const Handle&);
+};
+
+LINK_PTR_DECL(ParallelFilterLink)
+#define createParallelFilterLink CREATE_DECL(ParallelFilterLink)
+
+/** @}*/
+}
+
+#endif // _OPENCOG_PARALLEL_FILTER_LINK_H
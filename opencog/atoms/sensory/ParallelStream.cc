@@ -0,0 +1,307 @@
+/*
+ * opencog/atoms/sensory/ParallelStream.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <pthread.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <thread>
+#include <utility>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/flow/ValueShimLink.h>
+#include <opencog/atoms/value/QueueValue.h>
+#include <opencog/atoms/value/StringValue.h>
+#include <opencog/atoms/value/VoidValue.h>
+
+#include <opencog/sensory/types/atom_types.h>
+#include "Executor.h"
+#include "ParallelStream.h"
+
+using namespace opencog;
+
+// Everything the feeder thread and the rule tasks need. They hold it
+// by shared_ptr, so that the ParallelStream can go away while they
+// are still busy; they notice `stop`, and finish by themselves.
+struct ParallelStream::Stage
+{
+	Handle rule;
+	SensoryNodePtr snp;     // Either this,
+	ValuePtr stream;        // or this, is the source.
+	AtomSpace* as;
+	size_t nworkers;
+	size_t window;
+	bool ordered;
+
+	struct Result
+	{
+		ValuePtr vp;
+		std::exception_ptr err;
+	};
+
+	std::mutex mtx;
+	std::condition_variable cv_feed;   // Feeder waits for room
+	std::condition_variable cv_out;    // Reader waits for a result
+
+	uint64_t pulled = 0;      // Items taken from the source
+	uint64_t finished = 0;    // Items the rule is done with
+	uint64_t delivered = 0;   // Results handed to the reader
+	size_t running = 0;       // Items the rule is working on
+
+	// Results not yet delivered. When ordered, the key is the item's
+	// place in the input, so this is the reorder buffer; otherwise it
+	// is the order of finishing. Either way, the reader takes them in
+	// key order.
+	std::map<uint64_t, Result> done;
+
+	bool eof = false;
+	std::atomic<bool> stop = false;
+	std::exception_ptr src_err;
+};
+
+ParallelStream::ParallelStream(const Handle& rule,
+                               const SensoryNodePtr& snp,
+                               AtomSpace* as, size_t nworkers,
+                               size_t window, bool ordered)
+	: LinkValue(PARALLEL_STREAM), _stage(std::make_shared<Stage>())
+{
+	_stage->rule = rule;
+	_stage->snp = snp;
+	_stage->as = as;
+	_stage->nworkers = nworkers;
+	_stage->window = window;
+	_stage->ordered = ordered;
+}
+
+ParallelStream::ParallelStream(const Handle& rule,
+                               const ValuePtr& stream,
+                               AtomSpace* as, size_t nworkers,
+                               size_t window, bool ordered)
+	: LinkValue(PARALLEL_STREAM), _stage(std::make_shared<Stage>())
+{
+	// Anything else would give the same item over and over.
+	if (not stream->is_type(STREAM_VALUE) and
+	    not stream->is_type(CONTAINER_VALUE) and
+	    not stream->is_type(STRING_STREAM))
+		throw RuntimeException(TRACE_INFO,
+			"Expecting a stream; got %s\n", stream->to_string().c_str());
+
+	_stage->rule = rule;
+	_stage->stream = stream;
+	_stage->as = as;
+	_stage->nworkers = nworkers;
+	_stage->window = window;
+	_stage->ordered = ordered;
+}
+
+ParallelStream::~ParallelStream()
+{
+	std::lock_guard<std::mutex> lock(_stage->mtx);
+	_stage->stop = true;
+	_stage->cv_feed.notify_all();
+}
+
+// ==============================================================
+
+// The next sample from the source, or nullptr at the end. A
+// container, such as the QueueValue from *-stream-*, has its items
+// removed, one at a time, and ends when it is closed and empty. Any
+// other stream gives its current sample, copied, since the next
+// sample overwrites it in place; a LinkValue stream holding just one
+// item, as ReadStream does, gives that item.
+ValuePtr ParallelStream::take(Stage& stage)
+{
+	if (stage.snp)
+	{
+		if (not stage.snp->connected()) return nullptr;
+		return stage.snp->read();
+	}
+
+	if (stage.stream->is_type(CONTAINER_VALUE))
+	{
+		ContainerValuePtr cvp(ContainerValueCast(stage.stream));
+		if (cvp->is_closed() and 0 == cvp->size()) return nullptr;
+		try
+		{
+			return cvp->remove();
+		}
+		catch (typename concurrent_queue<ValuePtr>::Canceled& e)
+		{
+			return nullptr;
+		}
+	}
+
+	if (stage.stream->is_type(STRING_VALUE))
+	{
+		std::vector<std::string> strs(
+			StringValueCast(stage.stream)->value());
+		if (0 == strs.size()) return nullptr;
+		return createStringValue(std::move(strs));
+	}
+
+	ValueSeq vals(LinkValueCast(stage.stream)->value());
+	if (0 == vals.size()) return nullptr;
+	if (1 < vals.size()) return createLinkValue(std::move(vals));
+	return vals[0];
+}
+
+// The next item, skipping reads that timed out; nullptr at the end.
+ValuePtr ParallelStream::pull(Stage& stage)
+{
+	while (not stage.stop)
+	{
+		ValuePtr vp(take(stage));
+		if (nullptr == vp or vp->is_type(VOID_VALUE)) return nullptr;
+		if (SensoryNode::is_timeout(vp)) continue;
+		return vp;
+	}
+	return nullptr;
+}
+
+// Read items, and hand them to the Executor, as long as there are
+// fewer than nworkers in progress, and fewer than window not yet
+// delivered. The read itself may block, so it gets a thread of its
+// own, rather than tying up an Executor worker.
+void ParallelStream::feed(std::shared_ptr<Stage> stage)
+{
+	pthread_setname_np(pthread_self(), "parallel-feed");
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(stage->mtx);
+			stage->cv_feed.wait(lock, [&] {
+				return stage->stop or
+					(stage->running < stage->nworkers and
+					 stage->pulled - stage->delivered < stage->window); });
+			if (stage->stop) break;
+		}
+
+		ValuePtr item;
+		try
+		{
+			item = pull(*stage);
+		}
+		catch (const SilentException&)
+		{
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(stage->mtx);
+			stage->src_err = std::current_exception();
+		}
+
+		std::lock_guard<std::mutex> lock(stage->mtx);
+		if (nullptr == item or stage->stop) break;
+
+		uint64_t seq = stage->pulled++;
+		stage->running++;
+		Executor::instance().submit(
+			[stage, seq, item]() { eval(stage, seq, item); },
+			ExecOptions("parallel"));
+	}
+
+	std::lock_guard<std::mutex> lock(stage->mtx);
+	stage->eof = true;
+	stage->cv_out.notify_all();
+}
+
+// Apply the rule to one item, exactly as a FilterLink would.
+void ParallelStream::eval(std::shared_ptr<Stage> stage,
+                          uint64_t seq, ValuePtr item)
+{
+	Stage::Result res;
+	try
+	{
+		ValueShimLinkPtr shim(createValueShimLink());
+		shim->set_value(item);
+		HandleSeq oset({stage->rule, HandleCast(shim)});
+		Handle filter(createLink(std::move(oset), FILTER_LINK));
+		res.vp = filter->execute(stage->as, true);
+	}
+	catch (...)
+	{
+		res.err = std::current_exception();
+	}
+
+	std::lock_guard<std::mutex> lock(stage->mtx);
+	uint64_t key = stage->ordered ? seq : stage->finished;
+	stage->finished++;
+	stage->running--;
+	stage->done.emplace(key, std::move(res));
+	stage->cv_out.notify_all();
+	stage->cv_feed.notify_all();
+}
+
+// ==============================================================
+
+void ParallelStream::update() const
+{
+	std::call_once(_started, [this]() {
+		std::thread(feed, _stage).detach();
+	});
+
+	Stage& stage = *_stage;
+	std::unique_lock<std::mutex> lock(stage.mtx);
+	stage.cv_out.wait(lock, [&] {
+		return 0 < stage.done.count(stage.delivered) or
+			(stage.eof and stage.delivered == stage.pulled); });
+
+	auto it = stage.done.find(stage.delivered);
+	if (stage.done.end() == it)
+	{
+		_value.resize(1);
+		_value[0] = createVoidValue();
+		if (stage.src_err)
+			std::rethrow_exception(std::exchange(stage.src_err, nullptr));
+		return;
+	}
+
+	Stage::Result res(std::move(it->second));
+	stage.done.erase(it);
+	stage.delivered++;
+	stage.cv_feed.notify_all();
+	lock.unlock();
+
+	if (res.err) std::rethrow_exception(res.err);
+	_value.resize(1);
+	_value[0] = res.vp;
+}
+
+// ==============================================================
+
+std::string ParallelStream::to_string(const std::string& indent) const
+{
+	std::string rv = indent + "(" + nameserver().getTypeName(_type);
+	rv += "\n" + _stage->rule->to_short_string(indent + "   ");
+	if (_stage->snp)
+		rv += "\n" + _stage->snp->to_short_string(indent + "   ");
+	rv += ")\n";
+	{
+		std::lock_guard<std::mutex> lock(_stage->mtx);
+		rv += indent + "; Workers: " + std::to_string(_stage->nworkers) +
+			"   Running: " + std::to_string(_stage->running) +
+			"   Waiting: " + std::to_string(_stage->done.size()) +
+			"   Delivered: " + std::to_string(_stage->delivered) + "\n";
+	}
+	rv += indent + "; Current sample:\n";
+	rv += LinkValue::to_string(indent + "; ", LINK_VALUE);
+	return rv;
+}
+
+/* ===================== END OF FILE ===================== */
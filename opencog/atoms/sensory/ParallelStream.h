@@ -0,0 +1,91 @@
+/*
+ * opencog/atoms/sensory/ParallelStream.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_PARALLEL_STREAM_H
+#define _OPENCOG_PARALLEL_STREAM_H
+
+#include <memory>
+#include <mutex>
+#include <opencog/atoms/sensory/SensoryNode.h>
+#include <opencog/atoms/value/LinkValue.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * ParallelStream applies a RuleLink to each item of a source stream,
+ * on several threads at once, and provides a stream of the results.
+ * It is made by executing a ParallelFilterLink; see there for usage.
+ *
+ * The source is either a SensoryNode, which is read one item at a
+ * time, or a stream Value, such as a StringStream, ReadStream or
+ * another ParallelStream, whose successive samples are the items, or
+ * a QueueValue, whose items are removed from it one by one. Reads
+ * that timed out are skipped.
+ * Each item gets the same treatment as (Filter rule item) would give
+ * it, but the rule runs on the shared Executor, with at most
+ * `nworkers` items in progress at once; fewer, if the Executor has
+ * fewer threads than that.
+ *
+ * A feeder thread reads ahead of the consumer, by at most `window`
+ * items; this caps the memory used by results that are waiting to be
+ * read. Results are given either in the order of the input, held back
+ * in a reorder buffer until the ones before them are done, or in the
+ * order in which they are finished.
+ *
+ * Like ReadStream, the current sample is one item; at the end of the
+ * source, it is a VoidValue. An error from the rule is thrown when its
+ * result would have been read.
+ */
+class ParallelStream
+	: public LinkValue
+{
+	struct Stage;
+	std::shared_ptr<Stage> _stage;
+	mutable std::once_flag _started;
+
+	static ValuePtr take(Stage&);
+	static ValuePtr pull(Stage&);
+	static void feed(std::shared_ptr<Stage>);
+	static void eval(std::shared_ptr<Stage>, uint64_t, ValuePtr);
+
+protected:
+	virtual void update() const;
+
+public:
+	ParallelStream(const Handle& rule, const SensoryNodePtr&,
+	               AtomSpace*, size_t nworkers, size_t window,
+	               bool ordered);
+	ParallelStream(const Handle& rule, const ValuePtr& stream,
+	               AtomSpace*, size_t nworkers, size_t window,
+	               bool ordered);
+	virtual ~ParallelStream();
+
+	virtual std::string to_string(const std::string& indent = "") const;
+};
+
+VALUE_PTR_DECL(ParallelStream)
+CREATE_VALUE_DECL(ParallelStream)
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_PARALLEL_STREAM_H
@@ -0,0 +1,198 @@
+/*
+ * opencog/atoms/sensory/PumpLink.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include <thread>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/core/NumberNode.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/ValueFactory.h>
+
+#include <opencog/sensory/types/atom_types.h>
+#include "PumpLink.h"
+
+using namespace opencog;
+
+PumpLink::PumpLink(const HandleSeq&& oset, Type t)
+	: Link(std::move(oset), t), _batch(0)
+{
+	if (not nameserver().isA(t, PUMP_LINK))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting a PumpLink, got %s", tname.c_str());
+	}
+	init();
+}
+
+void PumpLink::init(void)
+{
+	size_t sz = _outgoing.size();
+	if (2 != sz and 3 != sz)
+		throw SyntaxException(TRACE_INFO,
+			"Expecting a source, a sink, and an optional batch size; got %s",
+			to_string().c_str());
+
+	if (3 == sz)
+	{
+		if (not _outgoing[2]->is_type(NUMBER_NODE))
+			throw SyntaxException(TRACE_INFO,
+				"Expecting the batch size to be a NumberNode; got %s",
+				_outgoing[2]->to_string().c_str());
+
+		double bs = NumberNodeCast(_outgoing[2])->get_value();
+		if (bs < 1.0)
+			throw SyntaxException(TRACE_INFO,
+				"Expecting a batch size of at least one; got %s",
+				_outgoing[2]->to_string().c_str());
+		_batch = (size_t) bs;
+	}
+}
+
+// ---------------------------------------------------------------
+
+SensoryNodePtr PumpLink::get_source(AtomSpace* as, bool silent) const
+{
+	SensoryNodePtr snp(get_sensory_node(_outgoing[0], as, silent));
+	if (nullptr == snp)
+		throw RuntimeException(TRACE_INFO,
+			"Expecting the source to be a SensoryNode; got %s",
+			_outgoing[0]->to_string().c_str());
+	return snp;
+}
+
+StreamNodePtr PumpLink::get_sink(AtomSpace* as, bool silent) const
+{
+	SensoryNodePtr snp(get_sensory_node(_outgoing[1], as, silent));
+	if (nullptr == snp or not snp->is_type(STREAM_NODE))
+		throw RuntimeException(TRACE_INFO,
+			"Expecting the sink to be a StreamNode; got %s",
+			_outgoing[1]->to_string().c_str());
+	return StreamNodeCast(snp);
+}
+
+// ---------------------------------------------------------------
+
+/// Move items until end-of-file, or until either end is closed. A
+/// VoidValue from the source is end-of-file; an error from a closed
+/// end is just the end, too. A TimeoutValue is a read that timed
+/// out; go around again, to check that both ends are still open.
+void PumpLink::pump(const SensoryNodePtr& src, const StreamNodePtr& sink,
+                    std::atomic<size_t>& moved) const
+{
+	size_t inbatch = 0;
+	try
+	{
+		while (src->connected() and sink->connected())
+		{
+			ValuePtr vp(src->read());
+			if (nullptr == vp or vp->is_type(VOID_VALUE)) break;
+			if (SensoryNode::is_timeout(vp)) continue;
+
+			sink->write_one(vp);
+			moved++;
+
+			if (0 < _batch and _batch <= ++inbatch)
+			{
+				sink->barrier();
+				inbatch = 0;
+			}
+		}
+	}
+	catch (const SilentException&)
+	{
+	}
+	catch (const StandardException&)
+	{
+		if (src->connected() and sink->connected()) throw;
+		return;
+	}
+
+	if (sink->connected())
+		sink->barrier();
+}
+
+ValuePtr PumpLink::execute(AtomSpace* as, bool silent)
+{
+	SensoryNodePtr src(get_source(as, silent));
+	StreamNodePtr sink(get_sink(as, silent));
+
+	std::atomic<size_t> moved(0);
+	pump(src, sink, moved);
+	return createFloatValue((double) moved);
+}
+
+DEFINE_LINK_FACTORY(PumpLink, PUMP_LINK)
+
+// ---------------------------------------------------------------
+
+PumpThreadedLink::PumpThreadedLink(const HandleSeq&& oset, Type t)
+	: PumpLink(std::move(oset), t), _running(false), _moved(0)
+{
+	if (not nameserver().isA(t, PUMP_THREADED_LINK))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting a PumpThreadedLink, got %s", tname.c_str());
+	}
+}
+
+// The thread holds a Handle to this link, so that the link stays
+// around for as long as the pump runs. It is detached; there is no
+// one to join it, and it ends by itself, at EOF or on close.
+ValuePtr PumpThreadedLink::execute(AtomSpace* as, bool silent)
+{
+	if (_running.exchange(true))
+		return createFloatValue((double) _moved);
+
+	SensoryNodePtr src;
+	StreamNodePtr sink;
+	try
+	{
+		src = get_source(as, silent);
+		sink = get_sink(as, silent);
+	}
+	catch (...)
+	{
+		_running = false;
+		throw;
+	}
+
+	Handle self(get_handle());
+	std::thread([this, self, src, sink]()
+	{
+		pthread_setname_np(pthread_self(), "pump");
+		try
+		{
+			pump(src, sink, _moved);
+		}
+		catch (const std::exception& ex)
+		{
+			fprintf(stderr, "PumpThreadedLink: %s\n", ex.what());
+		}
+		_running = false;
+	}).detach();
+
+	return createFloatValue((double) _moved);
+}
+
+DEFINE_LINK_FACTORY(PumpThreadedLink, PUMP_THREADED_LINK)
+
+/* ===================== END OF FILE ===================== */
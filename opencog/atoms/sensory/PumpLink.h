@@ -0,0 +1,109 @@
+/*
+ * opencog/atoms/sensory/PumpLink.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_PUMP_LINK_H
+#define _OPENCOG_PUMP_LINK_H
+
+#include <atomic>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/sensory/StreamNode.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * PumpLink - Copy everything read from one SensoryNode to another.
+ *
+ *    (Pump source sink)
+ *    (Pump source sink (Number batch))
+ *
+ * When executed, reads items from the source, and writes them to the
+ * sink, until the source reaches end-of-file, or either one is closed.
+ * Returns the number of items moved, as a FloatValue.
+ *
+ * This does the same thing as a tail-recursive Atomese loop of
+ * (SetValue sink (Predicate "*-write-*") (ValueOf source ...)), as
+ * shown in examples/xterm-bridge.scm, but calls read() and write_one()
+ * directly, in a C++ loop, and so skips the Atomese evaluation and the
+ * message dispatch, for each item.
+ *
+ * If the source has a read timeout, reads that time out are skipped;
+ * this lets the pump notice, in good time, that the sink was closed.
+ *
+ * The source and sink may be given directly, or as anything that
+ * executes to them, e.g. a NameNode that has been Pipe'd to them.
+ *
+ * With a batch size, the sink is sent a barrier after every batch
+ * of items, as well as at the end. Items are still written as they
+ * arrive; the batch only sets how often the sink is flushed.
+ *
+ * PumpThreadedLink does the same thing, in a thread of its own. It
+ * returns at once, with the number of items moved so far; executing
+ * it again, while the pump runs, just returns the count. Once the
+ * pump has stopped, executing it starts it again, and the count keeps
+ * adding up.
+ */
+class PumpLink : public Link
+{
+protected:
+	size_t _batch;
+
+	void init(void);
+	SensoryNodePtr get_source(AtomSpace*, bool) const;
+	StreamNodePtr get_sink(AtomSpace*, bool) const;
+	void pump(const SensoryNodePtr&, const StreamNodePtr&,
+	          std::atomic<size_t>&) const;
+
+public:
+	PumpLink(const HandleSeq&&, Type = PUMP_LINK);
+
+	PumpLink(const PumpLink&) = delete;
+	PumpLink& operator=(const PumpLink&) = delete;
+
+	virtual ValuePtr execute(AtomSpace*, bool);
+	virtual bool is_executable(void) const { return true; }
+
+	static Handle factory(const Handle&);
+};
+
+LINK_PTR_DECL(PumpLink)
+#define createPumpLink CREATE_DECL(PumpLink)
+
+class PumpThreadedLink : public PumpLink
+{
+	std::atomic<bool> _running;
+	std::atomic<size_t> _moved;
+
+public:
+	PumpThreadedLink(const HandleSeq&&, Type = PUMP_THREADED_LINK);
+
+	virtual ValuePtr execute(AtomSpace*, bool);
+
+	static Handle factory(const Handle&);
+};
+
+LINK_PTR_DECL(PumpThreadedLink)
+#define createPumpThreadedLink CREATE_DECL(PumpThreadedLink)
+
+/** @}*/
+}
+
+#endif // _OPENCOG_PUMP_LINK_H
@@ -25,6 +25,7 @@
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atoms/value/StringValue.h>
 #include <opencog/atoms/value/ValueFactory.h>
+#include <opencog/atoms/value/VoidValue.h>
 
 #include <opencog/sensory/types/atom_types.h>
 #include "ReadStream.h"
@@ -56,10 +57,16 @@ ReadStream::~ReadStream()
 // that does nothing except add overhead.
 void ReadStream::update() const
 {
-	if (not _snp->connected()) return;
-
 	// _value.emplace_back(_snp->read());
 	_value.resize(1);
+
+	// Once closed, the stream is at its end; don't leave the last
+	// item in place, where it would be taken as a new one.
+	if (not _snp->connected())
+	{
+		_value[0] = createVoidValue();
+		return;
+	}
 	_value[0] = _snp->read();
 }
 
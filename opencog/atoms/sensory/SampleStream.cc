@@ -0,0 +1,127 @@
+/*
+ * opencog/atoms/sensory/SampleStream.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <opencog/atoms/value/VoidValue.h>
+
+#include <opencog/sensory/types/atom_types.h>
+#include "SampleStream.h"
+
+using namespace opencog;
+
+SampleSlot::SampleSlot(void) :
+	_published(0),
+	_taken(0),
+	_eof(false),
+	_readers(0),
+	_gen(0)
+{
+}
+
+void SampleSlot::publish(const ValuePtr& vp)
+{
+	std::shared_ptr<Sample> smp(std::make_shared<Sample>());
+	smp->vp = vp;
+	smp->seq = ++_published;
+	smp->taken = false;
+	std::atomic_store(&_latest, smp);
+
+	_gen++;
+	_gen.notify_all();
+}
+
+void SampleSlot::finish(void)
+{
+	_eof = true;
+	_gen++;
+	_gen.notify_all();
+}
+
+// The generation is read before the slot, so that an item that comes
+// in between the two bumps it, and the wait returns at once.
+ValuePtr SampleSlot::next(uint64_t& last)
+{
+	while (true)
+	{
+		uint32_t gen = _gen;
+		std::shared_ptr<Sample> smp(std::atomic_load(&_latest));
+		if (smp and last < smp->seq)
+		{
+			last = smp->seq;
+			if (not smp->taken.exchange(true)) _taken++;
+			return smp->vp;
+		}
+		if (_eof) return nullptr;
+		_gen.wait(gen);
+	}
+}
+
+// Everything published was taken, or replaced, or is still waiting
+// in the slot.
+uint64_t SampleSlot::superseded(void) const
+{
+	uint64_t waiting = 0;
+	std::shared_ptr<Sample> smp(std::atomic_load(&_latest));
+	if (smp and not smp->taken) waiting = 1;
+
+	uint64_t published = smp ? smp->seq : 0;
+	uint64_t taken = _taken;
+	if (published < taken + waiting) return 0;
+	return published - taken - waiting;
+}
+
+std::string SampleSlot::to_string(void) const
+{
+	return std::string("Sampling latest:") +
+		(_eof ? " finished\n" : "\n") +
+		"   Items: " + std::to_string(_published) +
+		"   Taken: " + std::to_string(_taken) +
+		"   Superseded: " + std::to_string(superseded()) +
+		"   Readers: " + std::to_string(_readers) + "\n";
+}
+
+// ==============================================================
+
+SampleStream::SampleStream(const std::shared_ptr<SampleSlot>& slot)
+	: LinkValue(SAMPLE_STREAM), _slot(slot), _last(0)
+{
+	_slot->add_reader();
+}
+
+// The producer stops after its next read, once there are no readers.
+SampleStream::~SampleStream()
+{
+	_slot->remove_reader();
+}
+
+void SampleStream::update() const
+{
+	ValuePtr vp(_slot->next(_last));
+	_value.resize(1);
+	_value[0] = vp ? vp : createVoidValue();
+}
+
+std::string SampleStream::to_string(const std::string& indent) const
+{
+	std::string rv = indent + "(" + nameserver().getTypeName(_type) + ")\n";
+	rv += indent + "; Superseded: " + std::to_string(_slot->superseded()) +
+		"\n";
+	rv += indent + "; Current sample:\n";
+	rv += LinkValue::to_string(indent + "; ", LINK_VALUE);
+	return rv;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,121 @@
+/*
+ * opencog/atoms/sensory/SampleStream.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_SAMPLE_STREAM_H
+#define _OPENCOG_SAMPLE_STREAM_H
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <opencog/atoms/value/LinkValue.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * SampleSlot - Holds just the most recent item of a stream.
+ *
+ * A producer thread puts each item it reads into the slot, replacing
+ * whatever was there, whether or not anyone took it; there is no
+ * backlog. Each item is swapped in, along with its number, as one
+ * pointer, so readers never wait on the producer, nor it on them.
+ *
+ * An item replaced before any reader took it is superseded; the
+ * counts of those, and of the ones taken, are in to_string().
+ */
+class SampleSlot
+{
+	struct Sample
+	{
+		ValuePtr vp;
+		uint64_t seq;
+		std::atomic<bool> taken;
+	};
+
+	std::shared_ptr<Sample> _latest;
+	std::atomic<uint64_t> _published;
+	std::atomic<uint64_t> _taken;
+	std::atomic<bool> _eof;
+	std::atomic<size_t> _readers;
+
+	// Bumped on every change; readers wait on it.
+	std::atomic<uint32_t> _gen;
+
+public:
+	SampleSlot(void);
+
+	SampleSlot(const SampleSlot&) = delete;
+	SampleSlot& operator=(const SampleSlot&) = delete;
+
+	void publish(const ValuePtr&);
+	void finish(void);
+	bool is_finished(void) const { return _eof; }
+
+	/// The latest item, if it is newer than item number `last`;
+	/// otherwise, wait for one that is. Updates `last`. Returns
+	/// nullptr once the producer has finished, and the latest item
+	/// has been taken.
+	ValuePtr next(uint64_t& last);
+
+	void add_reader(void) { _readers++; }
+	void remove_reader(void) { _readers--; }
+	size_t readers(void) const { return _readers; }
+
+	uint64_t superseded(void) const;
+
+	/// A line or two for *-monitor-* reports.
+	std::string to_string(void) const;
+};
+
+/**
+ * SampleStream gives the freshest item of a stream, instead of the
+ * next one in line. It is what *-stream-* gives, after the
+ * *-conflate-* message has turned that on; a thread of its own keeps
+ * reading the node, and keeps just the latest item.
+ *
+ * Each sample is the latest item, or, if this stream has already
+ * given that one, the next to arrive. At the end of the stream, the
+ * sample is a VoidValue. Several SampleStreams of one node share the
+ * same thread and slot, and may each get the same item.
+ */
+class SampleStream
+	: public LinkValue
+{
+protected:
+	std::shared_ptr<SampleSlot> _slot;
+	mutable uint64_t _last;
+	virtual void update() const;
+
+public:
+	SampleStream(const std::shared_ptr<SampleSlot>&);
+	virtual ~SampleStream();
+
+	virtual std::string to_string(const std::string& indent = "") const;
+};
+
+VALUE_PTR_DECL(SampleStream)
+CREATE_VALUE_DECL(SampleStream)
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_SAMPLE_STREAM_H
@@ -0,0 +1,161 @@
+/*
+ * opencog/atoms/sensory/SelectLink.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/core/NumberNode.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/ValueFactory.h>
+
+#include <opencog/atoms/sensory/Async.h>
+#include <opencog/sensory/types/atom_types.h>
+#include "SelectLink.h"
+
+using namespace opencog;
+
+// Longest single poll(). Nodes are re-checked at least this often,
+// in case a wakeup was lost to another thread.
+#define POLL_CAP_MS 250
+
+// How often to check nodes that have no fd to wait on.
+#define NO_FD_POLL_MS 50
+
+SelectLink::SelectLink(const HandleSeq&& oset, Type t)
+	: Link(std::move(oset), t), _timeout_ms(-1)
+{
+	if (not nameserver().isA(t, SELECT_LINK))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting a SelectLink, got %s", tname.c_str());
+	}
+	init();
+}
+
+void SelectLink::init(void)
+{
+	_nnodes = _outgoing.size();
+	if (0 < _nnodes and _outgoing[_nnodes-1]->is_type(NUMBER_NODE))
+	{
+		double ms = NumberNodeCast(_outgoing[_nnodes-1])->get_value();
+		if (ms < 0.0)
+			throw SyntaxException(TRACE_INFO,
+				"Expecting a timeout of zero or more; got %s",
+				_outgoing[_nnodes-1]->to_string().c_str());
+		_timeout_ms = (int) ms;
+		_nnodes--;
+	}
+
+	if (0 == _nnodes)
+		throw SyntaxException(TRACE_INFO,
+			"Expecting at least one node to wait on; got %s",
+			to_string().c_str());
+}
+
+// ---------------------------------------------------------------
+
+std::vector<SensoryNodePtr> SelectLink::get_nodes(AtomSpace* as,
+                                                  bool silent) const
+{
+	std::vector<SensoryNodePtr> nodes;
+	for (size_t i = 0; i < _nnodes; i++)
+	{
+		SensoryNodePtr snp(get_sensory_node(_outgoing[i], as, silent));
+		if (nullptr == snp)
+			throw RuntimeException(TRACE_INFO,
+				"Expecting a SensoryNode; got %s",
+				_outgoing[i]->to_string().c_str());
+		nodes.emplace_back(snp);
+	}
+	return nodes;
+}
+
+/// Return the handles of the nodes that are ready, in the order
+/// given, waiting until there is at least one. Empty on timeout.
+ValueSeq SelectLink::wait_ready(const std::vector<SensoryNodePtr>& nodes) const
+{
+	Deadline dl;
+	if (0 <= _timeout_ms)
+		dl = Deadline(std::chrono::milliseconds(_timeout_ms));
+
+	std::vector<struct pollfd> pfds;
+	while (true)
+	{
+		// Ask each node first, and collect the fds of those that are
+		// not ready. Nodes clear their own wakeups when asked, so an
+		// fd that polls readable after this is news.
+		ValueSeq ready;
+		pfds.clear();
+		bool no_fd = false;
+		for (const SensoryNodePtr& snp : nodes)
+		{
+			if (snp->ready())
+			{
+				ready.emplace_back(snp);
+				continue;
+			}
+			int fd = snp->ready_fd();
+			if (0 > fd) no_fd = true;
+			else pfds.push_back({fd, POLLIN, 0});
+		}
+
+		if (0 < ready.size() or dl.expired()) return ready;
+
+		int cap = no_fd ? NO_FD_POLL_MS : POLL_CAP_MS;
+		int rc = poll(pfds.data(), pfds.size(), dl.wait_ms(cap));
+		if (0 > rc and EINTR != errno)
+			throw RuntimeException(TRACE_INFO,
+				"Unable to wait for input: %s", strerror(errno));
+	}
+}
+
+ValuePtr SelectLink::execute(AtomSpace* as, bool silent)
+{
+	return createLinkValue(wait_ready(get_nodes(as, silent)));
+}
+
+DEFINE_LINK_FACTORY(SelectLink, SELECT_LINK)
+
+// ---------------------------------------------------------------
+
+SelectReadLink::SelectReadLink(const HandleSeq&& oset, Type t)
+	: SelectLink(std::move(oset), t)
+{
+	if (not nameserver().isA(t, SELECT_READ_LINK))
+	{
+		const std::string& tname = nameserver().getTypeName(t);
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting a SelectReadLink, got %s", tname.c_str());
+	}
+}
+
+ValuePtr SelectReadLink::execute(AtomSpace* as, bool silent)
+{
+	ValueSeq ready(wait_ready(get_nodes(as, silent)));
+	if (0 == ready.size()) return SensoryNode::timeout_value();
+
+	SensoryNodePtr first(SensoryNodeCast(ready[0]));
+	ValuePtr item(first->read());
+	return createLinkValue(ValueSeq({createLinkValue(std::move(ready)), item}));
+}
+
+DEFINE_LINK_FACTORY(SelectReadLink, SELECT_READ_LINK)
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,105 @@
+/*
+ * opencog/atoms/sensory/SelectLink.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_SELECT_LINK_H
+#define _OPENCOG_SELECT_LINK_H
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/sensory/SensoryNode.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * SelectLink - Wait until any one of several SensoryNodes has input.
+ *
+ *    (Select node-a node-b ...)
+ *    (Select node-a node-b ... (Number msecs))
+ *
+ * When executed, waits until at least one of the nodes can be read
+ * without waiting, and returns a LinkValue holding all those that can.
+ * A node that has been closed counts as ready, too: reading it gives
+ * end-of-file at once. With a timeout, in milliseconds, an empty
+ * LinkValue is returned if none became ready in time.
+ *
+ * This is the select(2) of sensory nodes. It lets one agent watch many
+ * streams from one thread, instead of one thread blocked in each read.
+ * The wait is on the file descriptors that the nodes provide, in a
+ * single poll(); nodes that fill a queue from a thread of their own
+ * (IRChatNode, OllamaNode) ring an eventfd, so they wake it up, too.
+ * Nodes with no fd to wait on are checked every 50 milliseconds.
+ *
+ * As with select(2), ready is a hint, not a promise: some other thread
+ * may read the input first. A partly-received line also counts as
+ * ready; the read then waits for the rest of it.
+ *
+ * The nodes may be given directly, or as anything that executes to
+ * them, e.g. a NameNode that has been Pipe'd to them.
+ *
+ * SelectReadLink does the same, and then also reads one item from the
+ * first ready node, in the order given. It returns
+ *
+ *    (LinkValue (LinkValue ready-nodes...) item)
+ *
+ * or, on timeout, the same TimeoutValue that a read that timed out
+ * returns.
+ */
+class SelectLink : public Link
+{
+protected:
+	int _timeout_ms;
+	size_t _nnodes;
+
+	void init(void);
+	std::vector<SensoryNodePtr> get_nodes(AtomSpace*, bool) const;
+	ValueSeq wait_ready(const std::vector<SensoryNodePtr>&) const;
+
+public:
+	SelectLink(const HandleSeq&&, Type = SELECT_LINK);
+
+	SelectLink(const SelectLink&) = delete;
+	SelectLink& operator=(const SelectLink&) = delete;
+
+	virtual ValuePtr execute(AtomSpace*, bool);
+	virtual bool is_executable(void) const { return true; }
+
+	static Handle factory(const Handle&);
+};
+
+LINK_PTR_DECL(SelectLink)
+#define createSelectLink CREATE_DECL(SelectLink)
+
+class SelectReadLink : public SelectLink
+{
+public:
+	SelectReadLink(const HandleSeq&&, Type = SELECT_READ_LINK);
+
+	virtual ValuePtr execute(AtomSpace*, bool);
+
+	static Handle factory(const Handle&);
+};
+
+LINK_PTR_DECL(SelectReadLink)
+#define createSelectReadLink CREATE_DECL(SelectReadLink)
+
+/** @}*/
+}
+
+#endif // _OPENCOG_SELECT_LINK_H
@@ -25,6 +25,7 @@
 
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/value/BoolValue.h>
+#include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atoms/value/StringValue.h>
 #include <opencog/atoms/value/VoidValue.h>
 #include "SensoryNode.h"
@@ -57,6 +58,29 @@ void SensoryNode::follow(const ValuePtr& value)
 	// Default: do nothing. Derived classes can override.
 }
 
+bool SensoryNode::ready(void) const
+{
+	return true;
+}
+
+int SensoryNode::ready_fd(void) const
+{
+	return -1;
+}
+
+// ====================================================================
+
+SensoryNodePtr opencog::get_sensory_node(const Handle& h,
+                                         AtomSpace* as, bool silent)
+{
+	if (h->is_type(SENSORY_NODE)) return SensoryNodeCast(h);
+	if (not h->is_executable()) return nullptr;
+
+	Handle nh(HandleCast(h->execute(as, silent)));
+	if (nullptr == nh or not nh->is_type(SENSORY_NODE)) return nullptr;
+	return SensoryNodeCast(nh);
+}
+
 // The open, close and write messages are hopefully self-explanatory.
 //
 // The barrier message is a multi-threading ordering message, so that
@@ -169,6 +193,19 @@ ValuePtr SensoryNode::getValue(const Handle& key) const
 
 // ====================================================================
 
+const ValuePtr& SensoryNode::timeout_value(void)
+{
+	static const ValuePtr tmo(createLinkValue(TIMEOUT_VALUE, ValueSeq()));
+	return tmo;
+}
+
+bool SensoryNode::is_timeout(const ValuePtr& vp)
+{
+	return nullptr != vp and TIMEOUT_VALUE == vp->get_type();
+}
+
+// ====================================================================
+
 void opencog_sensory_init(void)
 {
 	// Force shared lib ctors to run
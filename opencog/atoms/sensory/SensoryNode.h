@@ -39,7 +39,11 @@ extern template class ObjectCRTP<SensoryNode>;
 // Also, holder of URL's.
 class SensoryNode : public ObjectCRTP<SensoryNode>
 {
+	friend class ParallelStream;
+	friend class PumpLink;
 	friend class ReadStream;
+	friend class SelectLink;
+	friend class SelectReadLink;
 	friend class StringStream;
 	friend class ObjectCRTP<SensoryNode>;
 
@@ -72,15 +76,40 @@ protected:
 	virtual ValuePtr read(void) const = 0;
 	virtual ValuePtr stream(void) const = 0;
 
+	/**
+	 * Readiness, for SelectLink. ready() returns true if read() would
+	 * return without waiting, or if the node is closed, so that read()
+	 * would return at once with end-of-stream. It must not block.
+	 *
+	 * ready_fd() returns a file descriptor that polls readable when
+	 * ready() might have become true, or -1 if there is none; in that
+	 * case, the node is polled, every so often. The default has no fd,
+	 * and is always ready; nodes that can block in read() override
+	 * both.
+	 */
+	virtual bool ready(void) const;
+	virtual int ready_fd(void) const;
+
 public:
 	virtual ~SensoryNode();
 
 	virtual void setValue(const Handle& key, const ValuePtr& value);
 	virtual ValuePtr getValue(const Handle& key) const;
+
+	/// What read() returns when it times out: an empty TimeoutValue,
+	/// the same one every time. It is not end-of-stream; the next read
+	/// just tries again. Readers never return it for anything else.
+	static const ValuePtr& timeout_value(void);
+	static bool is_timeout(const ValuePtr&);
 };
 
 NODE_PTR_DECL(SensoryNode)
 
+/// The SensoryNode given as the argument of some link: either the
+/// node itself, or whatever the argument executes to, e.g. a NameNode
+/// that was Pipe'd to a node. Returns nullptr if it is neither.
+SensoryNodePtr get_sensory_node(const Handle&, AtomSpace*, bool silent);
+
 /** @}*/
 } // namespace opencog
 
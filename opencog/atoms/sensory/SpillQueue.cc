@@ -0,0 +1,325 @@
+/*
+ * opencog/atoms/sensory/SpillQueue.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/sensory/types/atom_types.h>
+#include "SpillQueue.h"
+#include "ValueCodec.h"
+
+using namespace opencog;
+
+// Each record on disk is a four-byte length, then the encoded Value.
+#define HDR_BYTES sizeof(uint32_t)
+
+SpillQueue::SpillQueue(size_t cap, const std::string& dir) :
+	QueueValue(SPILL_QUEUE),
+	_cap(cap),
+	_parent_dir(dir),
+	_nsegs(0),
+	_mem_bytes(0),
+	_disk_bytes(0),
+	_disk_items(0),
+	_spilled(0),
+	_no_spill(false)
+{
+}
+
+SpillQueue::~SpillQueue()
+{
+	remove_files();
+}
+
+void SpillQueue::remove_files(void) const
+{
+	for (const Segment& seg : _segs)
+	{
+		::close(seg.fd);
+		unlink(seg.path.c_str());
+	}
+	_segs.clear();
+	_disk_bytes = 0;
+	_disk_items = 0;
+
+	if (not _dir.empty())
+	{
+		rmdir(_dir.c_str());
+		_dir.clear();
+	}
+}
+
+// ==============================================================
+// The disk side. All of these are called with the lock held.
+
+void SpillQueue::spill(const ValuePtr& vp) const
+{
+	std::string rec(HDR_BYTES, 0);
+	ValueCodec::encode(vp, rec);
+	uint32_t len = rec.size() - HDR_BYTES;
+	memcpy(rec.data(), &len, HDR_BYTES);
+
+	// The directory is made on the first spill; most queues never
+	// need one.
+	if (_dir.empty())
+	{
+		std::string tmpl = _parent_dir + "/opencog-spill-XXXXXX";
+		if (nullptr == mkdtemp(tmpl.data()))
+			throw RuntimeException(TRACE_INFO,
+				"Unable to make a spill directory in \"%s\": %s\n",
+				_parent_dir.c_str(), strerror(errno));
+		_dir = tmpl;
+	}
+
+	if (_segs.empty() or SEGMENT_BYTES <= _segs.back().write_off)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "/%08zu.seg", _nsegs++);
+		std::string path = _dir + name;
+		int fd = ::open(path.c_str(),
+			O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+		if (0 > fd)
+			throw RuntimeException(TRACE_INFO,
+				"Unable to create spill file \"%s\": %s\n",
+				path.c_str(), strerror(errno));
+		_segs.push_back({fd, path, 0, 0});
+	}
+
+	Segment& seg = _segs.back();
+	const char* p = rec.data();
+	size_t left = rec.size();
+	while (0 < left)
+	{
+		ssize_t nw = pwrite(seg.fd, p, left, seg.write_off);
+		if (0 > nw and EINTR == errno) continue;
+		if (0 >= nw)
+			throw RuntimeException(TRACE_INFO,
+				"Unable to write spill file \"%s\": %s\n",
+				seg.path.c_str(), strerror(errno));
+		p += nw;
+		left -= nw;
+		seg.write_off += nw;
+	}
+
+	_disk_bytes += rec.size();
+	_disk_items++;
+	_spilled++;
+}
+
+static void read_all(int fd, char* buf, size_t len, size_t off,
+                     const std::string& path)
+{
+	while (0 < len)
+	{
+		ssize_t nr = pread(fd, buf, len, off);
+		if (0 > nr and EINTR == errno) continue;
+		if (0 >= nr)
+			throw RuntimeException(TRACE_INFO,
+				"Unable to read spill file \"%s\": %s\n",
+				path.c_str(), 0 == nr ? "short read" : strerror(errno));
+		buf += nr;
+		len -= nr;
+		off += nr;
+	}
+}
+
+// Read back the oldest item on disk. If asked, report its encoded
+// size, as counted in _mem_bytes.
+ValuePtr SpillQueue::unspill(size_t* szp) const
+{
+	Segment& seg = _segs.front();
+
+	uint32_t len;
+	read_all(seg.fd, (char*) &len, HDR_BYTES, seg.read_off, seg.path);
+	std::string buf(len, 0);
+	read_all(seg.fd, buf.data(), len, seg.read_off + HDR_BYTES, seg.path);
+
+	const char* p = buf.data();
+	ValuePtr vp(ValueCodec::decode(p, p + len));
+
+	seg.read_off += HDR_BYTES + len;
+	_disk_bytes -= HDR_BYTES + len;
+	_disk_items--;
+	if (szp) *szp = len;
+
+	// Done with this segment. The last one is kept, and started over,
+	// rather than made anew.
+	if (seg.read_off == seg.write_off)
+	{
+		if (1 < _segs.size())
+		{
+			::close(seg.fd);
+			unlink(seg.path.c_str());
+			_segs.pop_front();
+		}
+		else if (0 == ftruncate(seg.fd, 0))
+		{
+			seg.read_off = 0;
+			seg.write_off = 0;
+		}
+	}
+	return vp;
+}
+
+// Move items from disk back into memory, oldest first, while there
+// is room. Items cannot be added after close; those still on disk
+// then, are handed out directly, by remove().
+void SpillQueue::refill(void)
+{
+	while (0 < _disk_items and (_no_spill or _mem_bytes < _cap) and
+	       not is_closed())
+	{
+		size_t sz;
+		ValuePtr vp(unspill(&sz));
+		_mem_bytes += sz;
+		QueueValue::add(std::move(vp));
+	}
+}
+
+// ==============================================================
+
+void SpillQueue::add(const ValuePtr& vp)
+{
+	add(ValuePtr(vp));
+}
+
+void SpillQueue::add(ValuePtr&& vp)
+{
+	size_t sz = ValueCodec::encoded_size(vp);
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (is_closed())
+	{
+		QueueValue::add(std::move(vp));
+		return;
+	}
+	refill();
+
+	// Once anything is on disk, everything after it goes there too,
+	// to keep the order. An empty queue always takes the item, so
+	// that a big item can't get stuck on disk with no one to pull it
+	// back.
+	if (not _no_spill and (0 < _disk_items or
+	    (0 < _mem_bytes and _cap < _mem_bytes + sz)))
+	{
+		spill(vp);
+		return;
+	}
+
+	_mem_bytes += sz;
+	QueueValue::add(std::move(vp));
+}
+
+ValuePtr SpillQueue::remove()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		if (0 == QueueValue::size() and 0 < _disk_items)
+			return unspill();
+	}
+
+	ValuePtr vp;
+	try
+	{
+		vp = QueueValue::remove();
+	}
+	catch (typename concurrent_queue<ValuePtr>::Canceled& e)
+	{
+		// Closed, and another reader got the last one in memory.
+		std::lock_guard<std::mutex> lock(_mtx);
+		if (0 < _disk_items) return unspill();
+		throw;
+	}
+
+	size_t sz = ValueCodec::encoded_size(vp);
+	std::lock_guard<std::mutex> lock(_mtx);
+	_mem_bytes -= std::min(sz, _mem_bytes);
+	refill();
+	return vp;
+}
+
+size_t SpillQueue::size() const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	return QueueValue::size() + _disk_items;
+}
+
+void SpillQueue::clear()
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	QueueValue::clear();
+	remove_files();
+	_mem_bytes = 0;
+}
+
+// Everything comes back into memory, and stays there; whoever asked
+// for all of it is going to hold all of it anyway.
+void SpillQueue::update() const
+{
+	SpillQueue* self = const_cast<SpillQueue*>(this);
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		_no_spill = true;
+		self->refill();
+	}
+
+	QueueValue::update();
+
+	// If closed, what is still on disk comes after what was in memory.
+	std::lock_guard<std::mutex> lock(_mtx);
+	while (0 < _disk_items)
+		_value.emplace_back(unspill());
+	_mem_bytes = 0;
+}
+
+// ==============================================================
+
+size_t SpillQueue::mem_bytes(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	return _mem_bytes;
+}
+
+size_t SpillQueue::disk_bytes(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	return _disk_bytes;
+}
+
+std::string SpillQueue::stats(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	size_t nmem = QueueValue::size();
+
+	std::string rpt = "Spill queue: cap " + std::to_string(_cap) + " bytes\n";
+	rpt += "   In memory: " + std::to_string(nmem) + " items, " +
+		std::to_string(_mem_bytes) + " bytes\n";
+	rpt += "   On disk: " + std::to_string(_disk_items) + " items, " +
+		std::to_string(_disk_bytes) + " bytes, in " +
+		std::to_string(_segs.size()) + " segment files\n";
+	rpt += "   Spilled in all: " + std::to_string(_spilled) + " items\n";
+	return rpt;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,111 @@
+/*
+ * opencog/atoms/sensory/SpillQueue.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_SPILL_QUEUE_H
+#define _OPENCOG_SPILL_QUEUE_H
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <opencog/atoms/value/QueueValue.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * SpillQueue - A QueueValue that keeps at most so many bytes in RAM.
+ *
+ * Items are held in memory, as usual, until they add up to more than
+ * the cap. After that, new items are written to segment files on disk,
+ * with ValueCodec, and read back, in order, as the consumer removes
+ * the items ahead of them. Nothing is ever dropped. To consumers, it
+ * is just a QueueValue.
+ *
+ * The segment files go into a directory of their own, made under the
+ * given directory, and are removed when they have been read, and when
+ * the queue goes away. Each one is appended to until it holds about
+ * SEGMENT_BYTES; the one being read is unlinked once it is read out.
+ *
+ * Byte counts are those of the encoding; the Values themselves, in
+ * memory, take somewhat more.
+ *
+ * Asking for the whole of the queue at once, with value(), reads all
+ * of it back into memory; after that, the queue no longer spills.
+ *
+ * Only Values that ValueCodec can encode may be added. Atoms that go
+ * to disk come back as fresh Atoms, not in any AtomSpace.
+ */
+class SpillQueue : public QueueValue
+{
+	struct Segment
+	{
+		int fd;
+		std::string path;
+		size_t read_off;
+		size_t write_off;
+	};
+
+	mutable std::mutex _mtx;
+	size_t _cap;
+	std::string _parent_dir;
+	mutable std::string _dir;
+	mutable size_t _nsegs;
+
+	mutable std::deque<Segment> _segs;
+	mutable size_t _mem_bytes;
+	mutable size_t _disk_bytes;
+	mutable size_t _disk_items;
+	mutable size_t _spilled;
+	mutable bool _no_spill;
+
+	void spill(const ValuePtr&) const;
+	ValuePtr unspill(size_t* = nullptr) const;
+	void refill(void);
+	void remove_files(void) const;
+
+protected:
+	virtual void update() const;
+
+public:
+	static constexpr size_t SEGMENT_BYTES = 16 * 1024 * 1024;
+
+	SpillQueue(size_t cap, const std::string& dir);
+	virtual ~SpillQueue();
+
+	virtual void add(const ValuePtr&);
+	virtual void add(ValuePtr&&);
+	virtual ValuePtr remove();
+	virtual size_t size() const;
+	virtual void clear();
+
+	size_t mem_bytes(void) const;
+	size_t disk_bytes(void) const;
+
+	/// A line or two for *-monitor-* reports.
+	std::string stats(void) const;
+};
+
+VALUE_PTR_DECL(SpillQueue)
+CREATE_VALUE_DECL(SpillQueue)
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_SPILL_QUEUE_H
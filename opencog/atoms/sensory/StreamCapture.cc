@@ -0,0 +1,278 @@
+/*
+ * opencog/atoms/sensory/StreamCapture.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <opencog/util/exceptions.h>
+#include "Executor.h"
+#include "StreamCapture.h"
+#include "ValueCodec.h"
+
+using namespace opencog;
+
+#define MAGIC_BYTES 8
+
+StreamCapture::StreamCapture(const std::string& path) :
+	_path(path),
+	_last(std::chrono::steady_clock::now()),
+	_items(0),
+	_bytes(0),
+	_timer(0)
+{
+	_fd = ::open(_path.c_str(),
+		O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (0 > _fd)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to create capture file \"%s\": %s\n",
+			_path.c_str(), strerror(errno));
+
+	uint64_t now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+
+	_buf.append(MAGIC, MAGIC_BYTES);
+	ValueCodec::put_varint(_buf, now_us);
+
+	ValueCodec::put_types(_buf);
+}
+
+StreamCapture::~StreamCapture()
+{
+	// cancel() waits for a flush that is running right now; that
+	// takes the lock, so it must not be held here.
+	uint64_t timer;
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		timer = _timer;
+		_timer = 0;
+	}
+	if (timer) Executor::instance().cancel(timer);
+
+	try { flush(); }
+	catch (const RuntimeException&) {}
+	::close(_fd);
+}
+
+// Called with the lock held, or from the dtor.
+void StreamCapture::flush(void)
+{
+	const char* p = _buf.data();
+	size_t left = _buf.size();
+	while (0 < left)
+	{
+		ssize_t nw = ::write(_fd, p, left);
+		if (0 > nw and EINTR == errno) continue;
+		if (0 > nw)
+		{
+			// Keep only what did not go out, for the next try.
+			int norr = errno;
+			size_t done = p - _buf.data();
+			_bytes += done;
+			_buf.erase(0, done);
+			throw RuntimeException(TRACE_INFO,
+				"Unable to write capture file \"%s\": %s\n",
+				_path.c_str(), strerror(norr));
+		}
+		p += nw;
+		left -= nw;
+	}
+	_bytes += _buf.size();
+	_buf.clear();
+}
+
+void StreamCapture::record(const ValuePtr& vp)
+{
+	std::string enc;
+	ValueCodec::encode(vp, enc);
+
+	// The time is taken under the lock, so that it never runs
+	// backwards from one item to the next.
+	std::lock_guard<std::mutex> lock(_mtx);
+	auto now = std::chrono::steady_clock::now();
+	uint64_t dt = std::chrono::duration_cast<std::chrono::microseconds>(
+		now - _last).count();
+	_last = now;
+
+	ValueCodec::put_varint(_buf, dt);
+	ValueCodec::put_varint(_buf, enc.size());
+	_buf.append(enc);
+	_items++;
+
+	if (BUFFER_BYTES <= _buf.size())
+	{
+		flush();
+		return;
+	}
+
+	// The first item into an empty buffer starts the clock; whatever
+	// has come in by then goes out together.
+	if (0 == _timer)
+		_timer = Executor::instance().schedule(FLUSH_MS,
+			[this]() { timed_flush(); }, ExecOptions("capture"));
+}
+
+void StreamCapture::timed_flush(void)
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (0 == _timer) return;
+	_timer = 0;
+
+	// Executor tasks must not throw; what is left in the buffer is
+	// tried again, and the error reported, at the next record().
+	try { flush(); }
+	catch (const RuntimeException&) {}
+}
+
+void StreamCapture::sync(void)
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	flush();
+}
+
+std::string StreamCapture::to_string(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	return "Capturing to: " + _path + "\n   Items: " +
+		std::to_string(_items) + "   Bytes: " +
+		std::to_string(_bytes + _buf.size()) + "\n";
+}
+
+// ==============================================================
+
+CaptureReader::CaptureReader(const std::string& path) :
+	_path(path),
+	_pos(0),
+	_eof(false),
+	_start_us(0),
+	_t_us(0)
+{
+	_fd = ::open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (0 > _fd)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to open capture file \"%s\": %s\n",
+			_path.c_str(), strerror(errno));
+
+	uint64_t ntypes;
+	if (not fill(MAGIC_BYTES) or
+	    0 != memcmp(_buf.data(), StreamCapture::MAGIC, MAGIC_BYTES))
+	{
+		::close(_fd);
+		throw RuntimeException(TRACE_INFO,
+			"Not a capture file: \"%s\"\n", _path.c_str());
+	}
+	_pos = MAGIC_BYTES;
+
+	if (not get_varint(_start_us) or not get_varint(ntypes))
+	{
+		::close(_fd);
+		throw RuntimeException(TRACE_INFO,
+			"Capture file \"%s\" is cut short\n", _path.c_str());
+	}
+
+	// Type numbers in the file are mapped to ours, by name. Types we
+	// don't have are an error only if they are actually used.
+	try
+	{
+		_types.reserve(ntypes);
+		for (uint64_t i = 0; i < ntypes; i++)
+			_types.push_back(nameserver().getType(get_string()));
+	}
+	catch (...)
+	{
+		::close(_fd);
+		throw;
+	}
+}
+
+CaptureReader::~CaptureReader()
+{
+	::close(_fd);
+}
+
+// Make sure there are at least n bytes in the buffer; false at EOF.
+bool CaptureReader::fill(size_t n)
+{
+	if (n <= _buf.size() - _pos) return true;
+	if (_eof) return false;
+
+	_buf.erase(0, _pos);
+	_pos = 0;
+	while (_buf.size() < n)
+	{
+		size_t have = _buf.size();
+		size_t want = std::max(n - have, StreamCapture::BUFFER_BYTES);
+		_buf.resize(have + want);
+		ssize_t nr = ::read(_fd, _buf.data() + have, want);
+		if (0 > nr and EINTR == errno) nr = 0;
+		else if (0 > nr)
+			throw RuntimeException(TRACE_INFO,
+				"Unable to read capture file \"%s\": %s\n",
+				_path.c_str(), strerror(errno));
+		else if (0 == nr)
+			_eof = true;
+		_buf.resize(have + nr);
+		if (_eof) return n <= _buf.size();
+	}
+	return true;
+}
+
+bool CaptureReader::get_varint(uint64_t& n)
+{
+	n = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		if (not fill(1)) return false;
+		uint8_t b = (uint8_t) _buf[_pos++];
+		n |= ((uint64_t) (b & 0x7f)) << shift;
+		if (0 == (b & 0x80)) return true;
+	}
+	throw RuntimeException(TRACE_INFO,
+		"Bad varint in capture file \"%s\"\n", _path.c_str());
+}
+
+std::string CaptureReader::get_string(void)
+{
+	uint64_t len;
+	if (not get_varint(len) or not fill(len))
+		throw RuntimeException(TRACE_INFO,
+			"Capture file \"%s\" is cut short\n", _path.c_str());
+	std::string str(_buf.data() + _pos, len);
+	_pos += len;
+	return str;
+}
+
+// An item cut short, by a crash during the capture, is the end.
+ValuePtr CaptureReader::next(uint64_t& t_us)
+{
+	uint64_t dt, len;
+	if (not get_varint(dt)) return nullptr;
+	if (not get_varint(len) or not fill(len)) return nullptr;
+
+	const char* p = _buf.data() + _pos;
+	ValuePtr vp(ValueCodec::decode(p, p + len, &_types));
+	_pos += len;
+
+	_t_us += dt;
+	t_us = _t_us;
+	return vp;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,125 @@
+/*
+ * opencog/atoms/sensory/StreamCapture.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_STREAM_CAPTURE_H
+#define _OPENCOG_STREAM_CAPTURE_H
+
+#include <stdint.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * StreamCapture - Records the items a stream hands out, with the time
+ * each one came, to a file, for replay later with a ReplayNode.
+ *
+ * The file starts with a magic string, the wall-clock time at which
+ * the capture began, and the names of all of the types, so that it
+ * can be read by another build. Then come the items: each one is the
+ * microseconds since the one before, its length, and the Value, in
+ * ValueCodec form. Numbers are varints.
+ *
+ * Writes are buffered; the buffer goes to disk when it fills, at
+ * sync(), at close, and otherwise no later than FLUSH_MS after the
+ * first item put into it, so that a slow stream is not held back in
+ * memory. A capture cut off by a crash reads back up to the last whole
+ * item written.
+ */
+class StreamCapture
+{
+	std::string _path;
+	int _fd;
+
+	mutable std::mutex _mtx;
+	std::string _buf;
+	std::chrono::steady_clock::time_point _last;
+	size_t _items;
+	size_t _bytes;
+	uint64_t _timer;
+
+	void flush(void);
+	void timed_flush(void);
+
+public:
+	static constexpr const char* MAGIC = "OCSCAP01";
+	static constexpr size_t BUFFER_BYTES = 64 * 1024;
+	static constexpr std::chrono::milliseconds FLUSH_MS{500};
+
+	/// Start a new capture; an existing file is replaced.
+	StreamCapture(const std::string& path);
+	~StreamCapture();
+
+	StreamCapture(const StreamCapture&) = delete;
+	StreamCapture& operator=(const StreamCapture&) = delete;
+
+	void record(const ValuePtr&);
+
+	/// Write out everything recorded so far.
+	void sync(void);
+
+	const std::string& path(void) const { return _path; }
+	std::string to_string(void) const;
+};
+
+/**
+ * CaptureReader - Reads back a file written by StreamCapture, in order.
+ */
+class CaptureReader
+{
+	std::string _path;
+	int _fd;
+	std::string _buf;
+	size_t _pos;
+	bool _eof;
+
+	std::vector<Type> _types;
+	uint64_t _start_us;
+	uint64_t _t_us;
+
+	bool fill(size_t);
+	bool get_varint(uint64_t&);
+	std::string get_string(void);
+
+public:
+	CaptureReader(const std::string& path);
+	~CaptureReader();
+
+	CaptureReader(const CaptureReader&) = delete;
+	CaptureReader& operator=(const CaptureReader&) = delete;
+
+	/// The next item, and when it came, in microseconds since the
+	/// capture began; nullptr at the end.
+	ValuePtr next(uint64_t& t_us);
+
+	/// Wall-clock time the capture began, in microseconds since the
+	/// epoch.
+	uint64_t start_time(void) const { return _start_us; }
+	const std::string& path(void) const { return _path; }
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_STREAM_CAPTURE_H
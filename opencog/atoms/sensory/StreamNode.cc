@@ -21,28 +21,44 @@
  */
 
 #include <errno.h>
+#include <pthread.h>
 #include <string.h> // for strerror()
 
+#include <thread>
+
 #include <opencog/util/exceptions.h>
 #include <opencog/util/oc_assert.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/signature/TypeNode.h>
+#include <opencog/atoms/value/BoolValue.h>
+#include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/value/LinkValue.h>
 #include <opencog/atoms/value/ContainerValue.h>
 #include <opencog/atoms/value/StringValue.h>
+#include <opencog/atoms/value/VoidValue.h>
 
 #include <opencog/sensory/types/atom_types.h>
 #include "ReadStream.h"
 #include "StreamNode.h"
+#include "TeeStream.h"
 
 using namespace opencog;
 
 StreamNode::StreamNode(Type t, const std::string&& url)
-	: SensoryNode(t, std::move(url))
+	: SensoryNode(t, std::move(url)), _replaying(false), _wal_last(-1),
+	_tee_cap(1024), _tee_policy(BroadcastRing::BLOCK), _conflate(false)
 {
 	OC_ASSERT(nameserver().isA(_type, SENSORY_NODE),
 		"Bad StreamNode constructor!");
+	addMessage("*-wal-*");
+	addMessage("*-ack-*");
+	addMessage("*-replay-*");
+	addMessage("*-offset-*");
+	addMessage("*-capture-*");
+	addMessage("*-tee-*");
+	addMessage("*-conflate-*");
 }
 
 StreamNode::~StreamNode()
@@ -77,11 +93,26 @@ void StreamNode::open(const ValuePtr& item_type)
 // return a ContainerValue (QueueValue or UnisetValue) here.
 ValuePtr StreamNode::stream(void) const
 {
+	if (_conflate) return get_sample();
 	return createReadStream(get_handle());
 }
 
 // ==============================================================
 
+// Defaults, for nodes that have no way of waiting other than blocking.
+AsyncTask<ValuePtr> StreamNode::async_read(void) const
+{
+	co_return read();
+}
+
+AsyncTask<void> StreamNode::async_write(ValuePtr content)
+{
+	write(content);
+	co_return;
+}
+
+// ==============================================================
+
 // Provide a reasonable default implementation
 void StreamNode::write_one(const ValuePtr& content)
 {
@@ -190,3 +221,426 @@ void StreamNode::write(const ValuePtr& cref)
 }
 
 // ==============================================================
+
+double StreamNode::get_number(const ValuePtr& vp)
+{
+	if (vp->is_type(NUMBER_NODE))
+		return NumberNodeCast(HandleCast(vp))->get_value();
+	if (vp->is_type(FLOAT_VALUE) and 0 < vp->size())
+		return FloatValueCast(vp)->value()[0];
+	throw RuntimeException(TRACE_INFO,
+		"Expecting a number; got %s\n", vp->to_string().c_str());
+}
+
+// ==============================================================
+// Write-ahead logging.
+//
+// The *-wal-* message takes the directory to keep the log in; it is
+// made if need be, and an existing log there is picked up where it
+// left off. A VoidValue or (BoolValue #f) stops logging. *-ack-* takes
+// the offset of the last item dealt with, or a VoidValue, for the
+// last one read. *-replay-* takes the offset to replay from, or a
+// VoidValue, for the one after the last acknowledged.
+
+void StreamNode::set_wal(const ValuePtr& value)
+{
+	std::shared_ptr<WriteAheadLog> wal;
+	if (value->is_type(STRING_VALUE))
+		wal = std::make_shared<WriteAheadLog>(
+			StringValueCast(value)->value()[0]);
+	else if (value->is_type(NODE))
+		wal = std::make_shared<WriteAheadLog>(HandleCast(value)->get_name());
+	else if (value->is_type(BOOL_VALUE))
+	{
+		const std::vector<bool>& bv = BoolValueCast(value)->value();
+		if (0 < bv.size() and bv[0])
+			throw RuntimeException(TRACE_INFO,
+				"The log needs a directory; (BoolValue #f) turns it off\n");
+	}
+	else if (not value->is_type(VOID_VALUE))
+		throw RuntimeException(TRACE_INFO,
+			"Expecting a directory for the log; got %s\n",
+			value->to_string().c_str());
+
+	std::lock_guard<std::mutex> lock(_wal_mtx);
+	_replay.reset();
+	_replaying = false;
+	_wal_last = -1;
+	std::atomic_store(&_wal, wal);
+}
+
+static std::shared_ptr<WriteAheadLog> need_wal(
+	const std::shared_ptr<WriteAheadLog>& wal)
+{
+	if (nullptr == wal)
+		throw RuntimeException(TRACE_INFO,
+			"There is no write-ahead log; set one with *-wal-* first\n");
+	return wal;
+}
+
+void StreamNode::set_ack(const ValuePtr& value)
+{
+	std::shared_ptr<WriteAheadLog> wal = need_wal(std::atomic_load(&_wal));
+
+	double off;
+	if (value->is_type(VOID_VALUE))
+	{
+		std::lock_guard<std::mutex> lock(_wal_mtx);
+		off = _wal_last;
+	}
+	else
+		off = get_number(value);
+
+	if (0.0 <= off) wal->ack((uint64_t) off);
+}
+
+void StreamNode::set_replay(const ValuePtr& value)
+{
+	std::shared_ptr<WriteAheadLog> wal = need_wal(std::atomic_load(&_wal));
+
+	double from;
+	if (value->is_type(VOID_VALUE))
+		from = wal->acked() + 1;
+	else
+		from = get_number(value);
+	if (from < 0.0)
+		throw RuntimeException(TRACE_INFO,
+			"Expecting an offset of zero or more; got %s\n",
+			value->to_string().c_str());
+
+	std::unique_ptr<WriteAheadLog::Reader> rdr(
+		wal->replay((uint64_t) from, replay_end(*wal)));
+
+	std::lock_guard<std::mutex> lock(_wal_mtx);
+	_replay = std::move(rdr);
+	_replaying = true;
+}
+
+uint64_t StreamNode::replay_end(const WriteAheadLog& wal) const
+{
+	return wal.next_offset();
+}
+
+// The last offset handed out, the last acknowledged, and the next
+// to be logged; -1 for none.
+ValuePtr StreamNode::get_offsets(void) const
+{
+	std::shared_ptr<WriteAheadLog> wal = std::atomic_load(&_wal);
+	if (nullptr == wal) return createVoidValue();
+
+	std::lock_guard<std::mutex> lock(_wal_mtx);
+	return createFloatValue(std::vector<double>({
+		(double) _wal_last,
+		(double) wal->acked(),
+		(double) wal->next_offset()}));
+}
+
+ValuePtr StreamNode::wal_replay_next(void) const
+{
+	if (not _replaying) return nullptr;
+
+	std::lock_guard<std::mutex> lock(_wal_mtx);
+	if (nullptr == _replay) return nullptr;
+
+	uint64_t off;
+	ValuePtr vp(_replay->next(off));
+	if (nullptr == vp)
+	{
+		_replay.reset();
+		_replaying = false;
+		return nullptr;
+	}
+	_wal_last = off;
+	capture(vp);
+	return vp;
+}
+
+// Neither end-of-stream, nor a read that timed out.
+bool StreamNode::is_item(const ValuePtr& vp)
+{
+	return not vp->is_type(VOID_VALUE) and not is_timeout(vp);
+}
+
+ValuePtr StreamNode::wal_take(const ValuePtr& vp) const
+{
+	if (not is_item(vp)) return vp;
+	capture(vp);
+
+	std::shared_ptr<WriteAheadLog> wal = std::atomic_load(&_wal);
+	if (wal) wal_delivered(wal->append(vp));
+	return vp;
+}
+
+void StreamNode::wal_delivered(uint64_t off) const
+{
+	std::lock_guard<std::mutex> lock(_wal_mtx);
+	if (_wal_last < (int64_t) off) _wal_last = off;
+}
+
+// ==============================================================
+// Capture.
+//
+// The *-capture-* message takes the file to record to; it is made
+// anew. A VoidValue or (BoolValue #f) stops recording, and closes
+// the file.
+
+void StreamNode::set_capture(const ValuePtr& value)
+{
+	std::shared_ptr<StreamCapture> cap;
+	if (value->is_type(STRING_VALUE))
+		cap = std::make_shared<StreamCapture>(
+			StringValueCast(value)->value()[0]);
+	else if (value->is_type(NODE))
+		cap = std::make_shared<StreamCapture>(HandleCast(value)->get_name());
+	else if (value->is_type(BOOL_VALUE))
+	{
+		const std::vector<bool>& bv = BoolValueCast(value)->value();
+		if (0 < bv.size() and bv[0])
+			throw RuntimeException(TRACE_INFO,
+				"Capture needs a file; (BoolValue #f) turns it off\n");
+	}
+	else if (not value->is_type(VOID_VALUE))
+		throw RuntimeException(TRACE_INFO,
+			"Expecting a file to capture to; got %s\n",
+			value->to_string().c_str());
+
+	// A reader may still be recording to the old one; it is closed
+	// when the last of them lets go of it.
+	std::atomic_store(&_capture, cap);
+}
+
+void StreamNode::capture(const ValuePtr& vp) const
+{
+	std::shared_ptr<StreamCapture> cap = std::atomic_load(&_capture);
+	if (cap) cap->record(vp);
+}
+
+// ==============================================================
+// Tee.
+//
+// Getting *-tee-* gives another reader of the shared ring, which is
+// made, along with the thread that fills it, when there are none.
+// Setting it takes the size of the ring, "block" or "drop", or both,
+// for the next ring made; a VoidValue puts back the defaults.
+
+void StreamNode::set_tee(const ValuePtr& value)
+{
+	ValueSeq args;
+	if (value->is_type(LINK_VALUE))
+		args = LinkValueCast(value)->value();
+	else if (value->is_link())
+		for (const Handle& h : HandleCast(value)->getOutgoingSet())
+			args.push_back(h);
+	else if (not value->is_type(VOID_VALUE))
+		args.push_back(value);
+
+	size_t cap = 1024;
+	BroadcastRing::Policy policy = BroadcastRing::BLOCK;
+	for (const ValuePtr& arg : args)
+	{
+		if (arg->is_type(NUMBER_NODE) or arg->is_type(FLOAT_VALUE))
+		{
+			double sz = get_number(arg);
+			if (sz < 1.0)
+				throw RuntimeException(TRACE_INFO,
+					"The tee needs room for at least one item; got %s\n",
+					arg->to_string().c_str());
+			cap = (size_t) sz;
+		}
+		else if (arg->is_type(STRING_VALUE))
+			policy = BroadcastRing::policy_from_name(
+				StringValueCast(arg)->value()[0]);
+		else if (arg->is_type(NODE))
+			policy = BroadcastRing::policy_from_name(
+				HandleCast(arg)->get_name());
+		else
+			throw RuntimeException(TRACE_INFO,
+				"Expecting a size, or \"block\" or \"drop\"; got %s\n",
+				arg->to_string().c_str());
+	}
+
+	std::lock_guard<std::mutex> lock(_tee_mtx);
+	_tee_cap = cap;
+	_tee_policy = policy;
+}
+
+ValuePtr StreamNode::get_tee(void) const
+{
+	std::lock_guard<std::mutex> lock(_tee_mtx);
+	std::shared_ptr<BroadcastRing> ring(_tee.lock());
+	if (ring and not ring->is_closed())
+		return createTeeStream(ring);
+
+	// The thread holds on to this node until the stream ends, or
+	// until the last reader goes away; it notices that only when it
+	// has the next item, and that item is then lost. Read errors end
+	// the stream, for all of the readers.
+	Handle self(get_handle());
+	ring = std::make_shared<BroadcastRing>(_tee_cap, _tee_policy,
+		[self](std::shared_ptr<BroadcastRing> tee)
+		{
+			pthread_setname_np(pthread_self(), "tee");
+			StreamNodePtr snp(StreamNodeCast(self));
+			try
+			{
+				while (snp->connected())
+				{
+					ValuePtr vp(snp->read());
+					if (nullptr == vp or vp->is_type(VOID_VALUE)) break;
+					if (not is_item(vp)) continue;
+					if (not tee->publish(vp)) break;
+				}
+			}
+			catch (...) {}
+			tee->close();
+		});
+	_tee = ring;
+	return createTeeStream(ring);
+}
+
+std::shared_ptr<BroadcastRing> StreamNode::tee_ring(void) const
+{
+	std::lock_guard<std::mutex> lock(_tee_mtx);
+	return _tee.lock();
+}
+
+// ==============================================================
+// Conflation.
+//
+// The *-conflate-* message takes (BoolValue #t) to have *-stream-*
+// give the latest item, and (BoolValue #f), or a VoidValue, to have
+// it give every item again. Streams already handed out are unchanged.
+
+void StreamNode::set_conflate(const ValuePtr& value)
+{
+	if (value->is_type(VOID_VALUE))
+		_conflate = false;
+	else if (value->is_type(BOOL_VALUE) and 0 < value->size())
+		_conflate = BoolValueCast(value)->value()[0];
+	else
+		throw RuntimeException(TRACE_INFO,
+			"Expecting a BoolValue; got %s\n", value->to_string().c_str());
+}
+
+ValuePtr StreamNode::get_sample(void) const
+{
+	std::lock_guard<std::mutex> lock(_sample_mtx);
+	std::shared_ptr<SampleSlot> slot(_sample.lock());
+	if (slot and not slot->is_finished())
+		return createSampleStream(slot);
+
+	// Made before the thread starts, so that it has a reader.
+	slot = std::make_shared<SampleSlot>();
+	ValuePtr vp(createSampleStream(slot));
+	_sample = slot;
+
+	// As with the tee, the thread notices that the readers are all
+	// gone only after its next read.
+	Handle self(get_handle());
+	std::thread([self, slot]()
+	{
+		pthread_setname_np(pthread_self(), "sample");
+		StreamNodePtr snp(StreamNodeCast(self));
+		try
+		{
+			while (snp->connected() and 0 < slot->readers())
+			{
+				ValuePtr item(snp->read());
+				if (nullptr == item or item->is_type(VOID_VALUE)) break;
+				if (is_item(item)) slot->publish(item);
+			}
+		}
+		catch (...) {}
+		slot->finish();
+	}).detach();
+
+	return vp;
+}
+
+std::shared_ptr<SampleSlot> StreamNode::sample_slot(void) const
+{
+	std::lock_guard<std::mutex> lock(_sample_mtx);
+	return _sample.lock();
+}
+
+// ==============================================================
+
+void StreamNode::setValue(const Handle& key, const ValuePtr& value)
+{
+	if (PREDICATE_NODE == key->get_type())
+	{
+		static constexpr uint32_t p_wal =
+			dispatch_hash("*-wal-*");
+		static constexpr uint32_t p_ack =
+			dispatch_hash("*-ack-*");
+		static constexpr uint32_t p_replay =
+			dispatch_hash("*-replay-*");
+		static constexpr uint32_t p_capture =
+			dispatch_hash("*-capture-*");
+		static constexpr uint32_t p_tee =
+			dispatch_hash("*-tee-*");
+		static constexpr uint32_t p_conflate =
+			dispatch_hash("*-conflate-*");
+		static constexpr uint32_t p_barrier =
+			dispatch_hash("*-barrier-*");
+
+		switch (dispatch_hash(key->get_name().c_str()))
+		{
+			case p_wal:
+				set_wal(value);
+				return;
+			case p_ack:
+				set_ack(value);
+				return;
+			case p_replay:
+				set_replay(value);
+				return;
+			case p_capture:
+				set_capture(value);
+				return;
+			case p_tee:
+				set_tee(value);
+				return;
+			case p_conflate:
+				set_conflate(value);
+				return;
+			case p_barrier:
+			{
+				// Then on to the barrier of the node itself.
+				std::shared_ptr<StreamCapture> cap =
+					std::atomic_load(&_capture);
+				if (cap) cap->sync();
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	SensoryNode::setValue(key, value);
+}
+
+ValuePtr StreamNode::getValue(const Handle& key) const
+{
+	if (PREDICATE_NODE == key->get_type())
+	{
+		static constexpr uint32_t p_offset =
+			dispatch_hash("*-offset-*");
+		static constexpr uint32_t p_tee =
+			dispatch_hash("*-tee-*");
+
+		switch (dispatch_hash(key->get_name().c_str()))
+		{
+			case p_offset:
+				return get_offsets();
+			case p_tee:
+				return get_tee();
+			default:
+				break;
+		}
+	}
+
+	return SensoryNode::getValue(key);
+}
+
+// ==============================================================
@@ -23,7 +23,15 @@
 #ifndef _OPENCOG_STREAM_NODE_H
 #define _OPENCOG_STREAM_NODE_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <opencog/atoms/sensory/Async.h>
+#include <opencog/atoms/sensory/BroadcastRing.h>
+#include <opencog/atoms/sensory/SampleStream.h>
 #include <opencog/atoms/sensory/SensoryNode.h>
+#include <opencog/atoms/sensory/StreamCapture.h>
+#include <opencog/atoms/sensory/WriteAheadLog.h>
 
 namespace opencog
 {
@@ -38,12 +46,46 @@ namespace opencog
  * it enables the construction of streams that will run indefinitely
  * i.e. looping for as long as an input stream remains open.
  *
+ * Reading and writing can also be done asynchronously, with the
+ * coroutines async_read() and async_write(); see Async.h. While they
+ * wait for input or output, no thread is tied up. The defaults just
+ * call read() and write(); derived classes that wait on a file
+ * descriptor provide real ones, and then read() and write() are thin
+ * wrappers around those.
+ *
+ * Items read can be written to a durable log, a WriteAheadLog, with
+ * the *-wal-* message. Each item read then has an offset; consumers
+ * acknowledge them with *-ack-*, and, after a crash or restart, the
+ * *-replay-* message has the next reads come from the log, starting
+ * after the last one acknowledged. *-offset-* tells where things are.
+ * Derived classes decide where items are logged: as they are read,
+ * or, for nodes that queue, as they are queued.
+ *
+ * Items handed out can also be recorded, with the time each one came,
+ * with the *-capture-* message; a ReplayNode plays them back later,
+ * for testing and benchmarking without the live source. *-barrier-*
+ * writes out what has been recorded so far.
+ *
+ * Reads from *-stream-* are destructive: two readers of it each get
+ * some of the items. Asking for *-tee-* instead gives a TeeStream;
+ * every TeeStream of the node gets every item. They share a ring of
+ * the most recent items, whose size, and what is done when a reader
+ * falls a whole ring behind, are set with the *-tee-* message.
+ *
+ * For sources that are sampled, rather than consumed, the *-conflate-*
+ * message has *-stream-* give a SampleStream: a thread keeps reading,
+ * and readers get the latest item, never a backlog. Derived classes
+ * that provide their own stream() must defer to this one when
+ * conflating.
+ *
  * This API is experimental.
  * See DesignNotes-J.md for detailed design considerations.
  */
 class StreamNode
 	: public SensoryNode
 {
+	friend class PumpLink;
+
 protected:
 	// The type of the Items that the *-read-* method should return.
 	Type _item_type;
@@ -67,8 +109,69 @@ protected:
 	// Helper routine, converts a line-oriented reader to a stream.
 	virtual ValuePtr stream(void) const;
 
+	// The write-ahead log of items read; null if none.
+	std::shared_ptr<WriteAheadLog> _wal;
+	void set_wal(const ValuePtr&);
+	void set_ack(const ValuePtr&);
+	void set_replay(const ValuePtr&);
+	ValuePtr get_offsets(void) const;
+
+	// Replay in progress, and the offset of the last item handed out;
+	// -1 if none yet.
+	mutable std::mutex _wal_mtx;
+	mutable std::unique_ptr<WriteAheadLog::Reader> _replay;
+	mutable std::atomic<bool> _replaying;
+	mutable int64_t _wal_last;
+
+	// Where a replay stops: the offset of the first item that will
+	// be handed out by a plain read. Nodes that log items as they are
+	// queued override this.
+	virtual uint64_t replay_end(const WriteAheadLog&) const;
+
+	// Recording of items handed out; null if none.
+	std::shared_ptr<StreamCapture> _capture;
+	void set_capture(const ValuePtr&);
+	void capture(const ValuePtr&) const;
+
+	// Readers of the same items; the ring lives as long as they do.
+	mutable std::mutex _tee_mtx;
+	mutable std::weak_ptr<BroadcastRing> _tee;
+	size_t _tee_cap;
+	BroadcastRing::Policy _tee_policy;
+	void set_tee(const ValuePtr&);
+	ValuePtr get_tee(void) const;
+	std::shared_ptr<BroadcastRing> tee_ring(void) const;
+
+	// Latest-item sampling, for *-stream-*; the slot lives as long
+	// as its readers do.
+	std::atomic<bool> _conflate;
+	mutable std::mutex _sample_mtx;
+	mutable std::weak_ptr<SampleSlot> _sample;
+	void set_conflate(const ValuePtr&);
+	ValuePtr get_sample(void) const;
+	std::shared_ptr<SampleSlot> sample_slot(void) const;
+
+	// Readers should first ask for wal_replay_next(), which is nullptr
+	// unless replaying, and pass what they read fresh to wal_take(),
+	// which logs it. Both also capture() what they hand out.
+	// End-of-stream and timeouts are neither logged nor captured.
+	ValuePtr wal_replay_next(void) const;
+	ValuePtr wal_take(const ValuePtr&) const;
+	void wal_delivered(uint64_t) const;
+	static bool is_item(const ValuePtr&);
+
+	// The argument of messages that take a number: a NumberNode or
+	// a FloatValue. Throws for anything else.
+	static double get_number(const ValuePtr&);
+
 public:
 	virtual ~StreamNode();
+
+	virtual void setValue(const Handle& key, const ValuePtr& value);
+	virtual ValuePtr getValue(const Handle& key) const;
+
+	virtual AsyncTask<ValuePtr> async_read(void) const;
+	virtual AsyncTask<void> async_write(ValuePtr);
 };
 
 NODE_PTR_DECL(StreamNode)
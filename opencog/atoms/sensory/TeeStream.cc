@@ -0,0 +1,57 @@
+/*
+ * opencog/atoms/sensory/TeeStream.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <opencog/atoms/value/VoidValue.h>
+
+#include <opencog/sensory/types/atom_types.h>
+#include "TeeStream.h"
+
+using namespace opencog;
+
+TeeStream::TeeStream(const std::shared_ptr<BroadcastRing>& ring)
+	: LinkValue(TEE_STREAM), _ring(ring), _cursor(ring->subscribe())
+{
+}
+
+// Let go of the cursor, so that the producer does not wait for it.
+TeeStream::~TeeStream()
+{
+	_ring->unsubscribe(_cursor);
+}
+
+// ==============================================================
+
+void TeeStream::update() const
+{
+	ValuePtr vp(_ring->next(*_cursor));
+	_value.resize(1);
+	_value[0] = vp ? vp : createVoidValue();
+}
+
+// ==============================================================
+
+std::string TeeStream::to_string(const std::string& indent) const
+{
+	std::string rv = indent + "(" + nameserver().getTypeName(_type) + ")\n";
+	rv += indent + "; Taken: " + std::to_string(_cursor->taken) +
+		"   Dropped: " + std::to_string(_cursor->dropped) + "\n";
+	rv += indent + "; Current sample:\n";
+	rv += LinkValue::to_string(indent + "; ", LINK_VALUE);
+	return rv;
+}
+
+/* ===================== END OF FILE ===================== */
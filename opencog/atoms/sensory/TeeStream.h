@@ -0,0 +1,63 @@
+/*
+ * opencog/atoms/sensory/TeeStream.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_TEE_STREAM_H
+#define _OPENCOG_TEE_STREAM_H
+
+#include <memory>
+#include <opencog/atoms/sensory/BroadcastRing.h>
+#include <opencog/atoms/value/LinkValue.h>
+
+namespace opencog
+{
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * TeeStream is one reader of a stream that several can read at once,
+ * each getting every item. It is made by the *-tee-* message of a
+ * StreamNode; each time that is asked for, another TeeStream, with a
+ * cursor of its own, is made, on the same BroadcastRing.
+ *
+ * Like ReadStream, the current sample is one item; at the end of the
+ * stream, it is a VoidValue. Unlike the QueueValue of *-stream-*,
+ * reading does not take the item away from the other readers.
+ */
+class TeeStream
+	: public LinkValue
+{
+protected:
+	std::shared_ptr<BroadcastRing> _ring;
+	BroadcastRing::CursorPtr _cursor;
+	virtual void update() const;
+
+public:
+	TeeStream(const std::shared_ptr<BroadcastRing>&);
+	virtual ~TeeStream();
+
+	virtual std::string to_string(const std::string& indent = "") const;
+};
+
+VALUE_PTR_DECL(TeeStream)
+CREATE_VALUE_DECL(TeeStream)
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_TEE_STREAM_H
@@ -21,53 +21,171 @@
  */
 
 #include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
 #include <string.h> // for strerror()
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <thread>
 
 #include <opencog/util/exceptions.h>
 #include <opencog/util/oc_assert.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/value/BoolValue.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/QueueValue.h>
 #include <opencog/atoms/value/StringValue.h>
 #include <opencog/atoms/value/VoidValue.h>
 
 #include <opencog/sensory/types/atom_types.h>
+#include "JsonParser.h"
 #include "StringStream.h"
 #include "TextStreamNode.h"
 
 using namespace opencog;
 
 TextStreamNode::TextStreamNode(Type t, const std::string&& url)
-	: StreamNode(t, std::move(url))
+	: StreamNode(t, std::move(url)), _timeout_ms(0), _notify_fd(-1),
+	  _spill_cap(0), _wal_in(0), _wal_out(0)
 {
 	OC_ASSERT(nameserver().isA(_type, STREAM_NODE),
 		"Bad TextStreamNode constructor!");
+	addMessage("*-filter-*");
+	addMessage("*-fields-*");
+	addMessage("*-normalize-*");
+	addMessage("*-timeout-*");
+	addMessage("*-spill-*");
 }
 
 TextStreamNode::~TextStreamNode()
 {
 	printf ("TextStreamNode dtor\n");
+	int fd = _notify_fd;
+	if (0 <= fd) ::close(fd);
 }
 
 // ==============================================================
 
-// Decode the Item type.
+// Decode the Item type. A LinkValue type asks for JSON lines: each
+// line is parsed as a JSON document.
 void TextStreamNode::open(const ValuePtr& item_type)
 {
 	StreamNode::open(item_type);
 
 	if (not nameserver().isA(_item_type, STRING_VALUE) and
-	    not nameserver().isA(_item_type, NODE))
+	    not nameserver().isA(_item_type, NODE) and
+	    not nameserver().isA(_item_type, LINK_VALUE))
 		throw RuntimeException(TRACE_INFO,
-			"Expecting the type to be a StringValue or Node; got %s\n",
-			item_type->to_string().c_str());
+			"Expecting the type to be a StringValue, Node or LinkValue;"
+			" got %s\n", item_type->to_string().c_str());
 }
 
 // ==============================================================
 
-// Reader utility
+// Convert JSON to Values. Objects become a LinkValue of (key, value)
+// pairs, and arrays a LinkValue of their elements, except that arrays
+// holding only numbers become a single FloatValue. Strings, numbers
+// and booleans become StringValue, FloatValue and BoolValue; null
+// becomes an empty LinkValue.
+static ValuePtr json_to_value(const JsonParser::Ref& r)
+{
+	switch (r.kind())
+	{
+		case JsonParser::STRING:
+			return createStringValue(std::string(r.as_string()));
+		case JsonParser::NUMBER:
+			return createFloatValue(r.as_number());
+		case JsonParser::TRUE:
+		case JsonParser::FALSE:
+			return createBoolValue(r.as_bool());
+		case JsonParser::ARRAY:
+		{
+			size_t n = r.size();
+			bool numeric = 0 < n;
+			JsonParser::Ref el = r.at(0);
+			for (size_t i = 0; numeric and i < n; i++, el = el.next())
+				numeric = el.is_number();
+
+			el = r.at(0);
+			if (numeric)
+			{
+				std::vector<double> nums;
+				nums.reserve(n);
+				for (size_t i = 0; i < n; i++, el = el.next())
+					nums.push_back(el.as_number());
+				return createFloatValue(std::move(nums));
+			}
+
+			ValueSeq vs;
+			vs.reserve(n);
+			for (size_t i = 0; i < n; i++, el = el.next())
+				vs.push_back(json_to_value(el));
+			return createLinkValue(std::move(vs));
+		}
+		case JsonParser::OBJECT:
+		{
+			// Keys and values alternate; walk them in one pass.
+			size_t n = r.size();
+			ValueSeq vs;
+			vs.reserve(n);
+			std::string_view key = r.key(0);
+			JsonParser::Ref val = r.at(0);
+			for (size_t i = 0; i < n; i++)
+			{
+				vs.push_back(createLinkValue(ValueSeq({
+					createStringValue(std::string(key)),
+					json_to_value(val)})));
+				if (i + 1 == n) break;
+				JsonParser::Ref kr = val.next();
+				key = kr.as_string();
+				val = kr.next();
+			}
+			return createLinkValue(std::move(vs));
+		}
+		default:
+			return createLinkValue(ValueSeq());
+	}
+}
+
+// Reader utility. An empty string is EOF.
 ValuePtr TextStreamNode::string_to_type(std::string str) const
 {
 	if (0 == str.length()) return createVoidValue();
+	return line_to_type(std::move(str));
+}
+
+// Convert a line that was read. The line may be empty, if it was
+// trimmed; EOF must have been checked for already.
+ValuePtr TextStreamNode::line_to_type(std::string str) const
+{
+	// Split into fields, if asked to.
+	std::shared_ptr<const FieldSplitter> fs = std::atomic_load(&_fields);
+	if (fs)
+	{
+		if (fs->numeric())
+		{
+			std::vector<double> nums;
+			fs->split(str, nums);
+			return createFloatValue(std::move(nums));
+		}
+		std::vector<std::string> fields;
+		fs->split(str, fields);
+		return createStringValue(std::move(fields));
+	}
+
+	// JSON lines.
+	if (nameserver().isA(_item_type, LINK_VALUE))
+	{
+		// One parser per thread; it keeps its buffers between lines.
+		static thread_local JsonParser jp;
+		if (not jp.parse(str))
+			throw RuntimeException(TRACE_INFO,
+				"Bad JSON: %s\n", jp.error().c_str());
+		return json_to_value(jp.root());
+	}
 
 	// If a StringValue was asked for, get them that.
 	if (nameserver().isA(_item_type, STRING_VALUE))
@@ -77,9 +195,59 @@ ValuePtr TextStreamNode::string_to_type(std::string str) const
 	return createNode(_item_type, std::move(str));
 }
 
+// True if the line is nothing but whitespace.
+static bool is_blank(const std::string& str)
+{
+	return std::string::npos == str.find_first_not_of(" \t\r\n");
+}
+
+// Lines are normalized, and then filtered, here, before they are
+// turned into Values. Blank lines are dropped in JSON mode.
+//
+// do_read() returns an empty string at EOF; any line actually read
+// has at least its newline. So EOF is checked for before trimming,
+// and a trimmed, empty line is still a line.
+AsyncTask<ValuePtr> TextStreamNode::next_value(void) const
+{
+	std::shared_ptr<const LineFilter> filt = std::atomic_load(&_filter);
+	std::shared_ptr<const LineNormalizer> norm = std::atomic_load(&_normalizer);
+	bool json = nameserver().isA(_item_type, LINK_VALUE);
+	if (nullptr == filt and nullptr == norm and not json)
+		co_return string_to_type(co_await async_do_read());
+
+	while (true)
+	{
+		std::string str = co_await async_do_read();
+		if (0 == str.length()) co_return createVoidValue();
+		if (norm and not norm->normalize(str)) continue;
+		if (json and is_blank(str)) continue;
+		if (filt and not filt->match(str)) continue;
+		co_return line_to_type(std::move(str));
+	}
+}
+
+// A read that runs out of time returns timeout_value(). While a
+// replay is on, items come from the log instead.
+//
+// The synchronous read() is just this, run to completion.
+AsyncTask<ValuePtr> TextStreamNode::async_read(void) const
+{
+	ValuePtr rvp(wal_replay_next());
+	if (rvp) co_return rvp;
+
+	try
+	{
+		co_return wal_take(co_await next_value());
+	}
+	catch (const ReadTimeout&)
+	{
+	}
+	co_return timeout_value();
+}
+
 ValuePtr TextStreamNode::read(void) const
 {
-	return string_to_type(do_read());
+	return sync_wait(async_read());
 }
 
 std::string TextStreamNode::do_read(void) const
@@ -87,6 +255,450 @@ std::string TextStreamNode::do_read(void) const
 	return std::string();
 }
 
+AsyncTask<std::string> TextStreamNode::async_do_read(void) const
+{
+	co_return do_read();
+}
+
+AsyncTask<void> TextStreamNode::async_do_write(std::string str)
+{
+	do_write(str);
+	co_return;
+}
+
+// ==============================================================
+// Filtering.
+//
+// The *-filter-* message takes a StringValue or Node, to keep lines
+// containing that string, or a (kind, pattern) pair, with kind being
+// "substring", "prefix" or "regex". A VoidValue, or (BoolValue #f),
+// removes the filter. The filter stays in place across open/close.
+
+static std::string get_string(const ValuePtr& vp)
+{
+	if (vp->is_type(STRING_VALUE))
+		return StringValueCast(vp)->value()[0];
+	if (vp->is_type(NODE))
+		return HandleCast(vp)->get_name();
+	throw RuntimeException(TRACE_INFO,
+		"Expecting StringValue or Node; got %s\n", vp->to_string().c_str());
+}
+
+void TextStreamNode::set_filter(const ValuePtr& value)
+{
+	std::shared_ptr<const LineFilter> filt;
+
+	ValueSeq args;
+	if (value->is_type(LINK_VALUE))
+		args = LinkValueCast(value)->value();
+	else if (value->is_link())
+		for (const Handle& h : HandleCast(value)->getOutgoingSet())
+			args.push_back(h);
+
+	if (value->is_type(VOID_VALUE))
+		;
+	else if (value->is_type(BOOL_VALUE))
+	{
+		const std::vector<bool>& bv = BoolValueCast(value)->value();
+		if (0 < bv.size() and bv[0])
+			throw RuntimeException(TRACE_INFO,
+				"Filter needs a pattern; (BoolValue #f) turns it off\n");
+	}
+	else if (2 == args.size())
+		filt = std::make_shared<const LineFilter>(
+			LineFilter::kind_from_name(get_string(args[0])),
+			get_string(args[1]));
+	else
+		filt = std::make_shared<const LineFilter>(
+			LineFilter::SUBSTRING, get_string(value));
+
+	// Readers in other threads may be holding the old one.
+	std::atomic_store(&_filter, filt);
+}
+
+// ==============================================================
+// Field splitting.
+//
+// The *-fields-* message takes the delimiter, as a one-character
+// StringValue or Node, or a list of the delimiter followed by options:
+// "numeric" to get a FloatValue for each line, instead of a
+// StringValue, and "noquote" to treat double-quotes as ordinary
+// characters. A VoidValue, or (BoolValue #f), turns splitting off.
+
+void TextStreamNode::set_fields(const ValuePtr& value)
+{
+	std::shared_ptr<const FieldSplitter> fs;
+
+	ValueSeq args;
+	if (value->is_type(LINK_VALUE))
+		args = LinkValueCast(value)->value();
+	else if (value->is_link())
+		for (const Handle& h : HandleCast(value)->getOutgoingSet())
+			args.push_back(h);
+	else if (not value->is_type(VOID_VALUE) and
+	         not value->is_type(BOOL_VALUE))
+		args.push_back(value);
+
+	if (value->is_type(BOOL_VALUE))
+	{
+		const std::vector<bool>& bv = BoolValueCast(value)->value();
+		if (0 < bv.size() and bv[0])
+			throw RuntimeException(TRACE_INFO,
+				"Fields need a delimiter; (BoolValue #f) turns them off\n");
+	}
+	else if (0 < args.size())
+	{
+		std::string delim = get_string(args[0]);
+		if (1 != delim.size())
+			throw RuntimeException(TRACE_INFO,
+				"Field delimiter must be one character; got \"%s\"\n",
+				delim.c_str());
+
+		bool quoting = true;
+		bool numeric = false;
+		for (size_t i = 1; i < args.size(); i++)
+		{
+			std::string opt = get_string(args[i]);
+			if (0 == opt.compare("numeric")) numeric = true;
+			else if (0 == opt.compare("noquote")) quoting = false;
+			else
+				throw RuntimeException(TRACE_INFO,
+					"Unknown field option \"%s\"\n", opt.c_str());
+		}
+		fs = std::make_shared<const FieldSplitter>(delim[0], quoting, numeric);
+	}
+
+	std::atomic_store(&_fields, fs);
+}
+
+// ==============================================================
+// Normalization.
+//
+// The *-normalize-* message takes a list of options: "trim" to drop
+// the trailing LF or CRLF, and "validate" or "repair" for UTF-8;
+// validate drops lines that are not valid UTF-8, while repair fixes
+// them up with replacement characters. (BoolValue #t) is the same
+// as trim and repair; a VoidValue or (BoolValue #f) turns it off.
+
+void TextStreamNode::set_normalize(const ValuePtr& value)
+{
+	std::shared_ptr<const LineNormalizer> norm;
+
+	std::vector<std::string> opts;
+	if (value->is_type(STRING_VALUE))
+		opts = StringValueCast(value)->value();
+	else if (value->is_type(LINK_VALUE))
+		for (const ValuePtr& v : LinkValueCast(value)->value())
+			opts.push_back(get_string(v));
+	else if (value->is_link())
+		for (const Handle& h : HandleCast(value)->getOutgoingSet())
+			opts.push_back(get_string(h));
+	else if (value->is_type(NODE))
+		opts.push_back(HandleCast(value)->get_name());
+
+	if (value->is_type(BOOL_VALUE))
+	{
+		const std::vector<bool>& bv = BoolValueCast(value)->value();
+		if (0 < bv.size() and bv[0])
+			norm = std::make_shared<const LineNormalizer>(
+				true, LineNormalizer::UTF8_REPAIR);
+	}
+	else if (0 < opts.size())
+	{
+		bool trim = false;
+		LineNormalizer::Utf8Mode utf8 = LineNormalizer::UTF8_NONE;
+		for (const std::string& opt : opts)
+		{
+			if (0 == opt.compare("trim")) trim = true;
+			else if (0 == opt.compare("validate"))
+				utf8 = LineNormalizer::UTF8_VALIDATE;
+			else if (0 == opt.compare("repair"))
+				utf8 = LineNormalizer::UTF8_REPAIR;
+			else
+				throw RuntimeException(TRACE_INFO,
+					"Unknown normalize option \"%s\"\n", opt.c_str());
+		}
+		norm = std::make_shared<const LineNormalizer>(trim, utf8);
+	}
+
+	std::atomic_store(&_normalizer, norm);
+}
+
+// ==============================================================
+// Read timeouts.
+//
+// The *-timeout-* message takes a number of milliseconds; after that
+// long with nothing to read, a read returns a TimeoutValue. That
+// is not end-of-file (a VoidValue): the next read picks up where this
+// one left off. Zero, a VoidValue or (BoolValue #f) waits forever.
+
+void TextStreamNode::set_timeout(const ValuePtr& value)
+{
+	double ms = 0.0;
+	if (not value->is_type(VOID_VALUE) and
+	    not value->is_type(BOOL_VALUE))
+		ms = get_number(value);
+
+	if (ms < 0.0)
+		throw RuntimeException(TRACE_INFO,
+			"Expecting a timeout of zero or more; got %s\n",
+			value->to_string().c_str());
+
+	_timeout_ms = (int) ms;
+}
+
+Deadline TextStreamNode::read_deadline(void) const
+{
+	int ms = _timeout_ms;
+	if (0 == ms) return Deadline();
+	return Deadline(std::chrono::milliseconds(ms));
+}
+
+// ==============================================================
+// Spilling queues to disk.
+//
+// The *-spill-* message takes the most bytes to keep in memory, or a
+// list of that and the directory to spill into; the default is
+// $TMPDIR, or /tmp. Zero, a VoidValue or (BoolValue #f) keeps it all
+// in memory. It applies to the queue made at the next open.
+
+void TextStreamNode::set_spill(const ValuePtr& value)
+{
+	ValueSeq args;
+	if (value->is_type(LINK_VALUE))
+		args = LinkValueCast(value)->value();
+	else if (value->is_link())
+		for (const Handle& h : HandleCast(value)->getOutgoingSet())
+			args.push_back(h);
+	else if (not value->is_type(VOID_VALUE) and
+	         not value->is_type(BOOL_VALUE))
+		args.push_back(value);
+
+	if (value->is_type(BOOL_VALUE))
+	{
+		const std::vector<bool>& bv = BoolValueCast(value)->value();
+		if (0 < bv.size() and bv[0])
+			throw RuntimeException(TRACE_INFO,
+				"Spilling needs a byte count; (BoolValue #f) turns it off\n");
+	}
+	if (2 < args.size())
+		throw RuntimeException(TRACE_INFO,
+			"Expecting a byte count and a directory; got %s\n",
+			value->to_string().c_str());
+
+	double cap = 0.0;
+	if (0 < args.size()) cap = get_number(args[0]);
+	if (cap < 0.0)
+		throw RuntimeException(TRACE_INFO,
+			"Expecting a byte count of zero or more; got %s\n",
+			value->to_string().c_str());
+
+	std::string dir;
+	if (2 == args.size())
+		dir = get_string(args[1]);
+	else
+	{
+		const char* tmp = getenv("TMPDIR");
+		dir = (tmp and *tmp) ? tmp : "/tmp";
+	}
+
+	std::lock_guard<std::mutex> lock(_spill_mtx);
+	_spill_cap = (size_t) cap;
+	_spill_dir = dir;
+}
+
+QueueValuePtr TextStreamNode::make_queue(void) const
+{
+	std::shared_ptr<WriteAheadLog> wal = std::atomic_load(&_wal);
+	{
+		std::lock_guard<std::mutex> lock(_wal_mtx);
+		if (wal) _wal_in = _wal_out = wal->next_offset();
+		std::atomic_store(&_queue_wal, wal);
+	}
+
+	std::lock_guard<std::mutex> lock(_spill_mtx);
+	if (0 == _spill_cap)
+	{
+		_spill_queue.reset();
+		return createQueueValue();
+	}
+
+	SpillQueuePtr sqp(createSpillQueue(_spill_cap, _spill_dir));
+	_spill_queue = sqp;
+	return sqp;
+}
+
+// For readers that take what other threads have put in a queue. With
+// no timeout, the caller should just remove() from the queue. Returns
+// a VoidValue once the queue is closed and empty.
+ValuePtr TextStreamNode::wait_queue(const QueueValuePtr& qvp) const
+{
+	Deadline dl(read_deadline());
+	int fd = notify_fd();
+	while (true)
+	{
+		// Clear first, then look; anything added after the look
+		// leaves the eventfd readable, and so the poll returns.
+		clear_notify();
+		if (0 < qvp->size()) return qvp->remove();
+		if (qvp->is_closed()) return createVoidValue();
+		if (dl.expired()) return timeout_value();
+
+		// Someone else (another reader, or a SelectLink) may clear
+		// the eventfd under us; the cap bounds the wait, if so.
+		struct pollfd pfd = {fd, POLLIN, 0};
+		poll(&pfd, 1, dl.wait_ms(250));
+	}
+}
+
+// The eventfd is made on first use, by whoever gets there first;
+// losers of the race close theirs.
+int TextStreamNode::notify_fd(void) const
+{
+	int fd = _notify_fd;
+	if (0 <= fd) return fd;
+
+	int nfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (nfd < 0)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to create eventfd: %s\n", strerror(errno));
+
+	if (_notify_fd.compare_exchange_strong(fd, nfd)) return nfd;
+	::close(nfd);
+	return fd;
+}
+
+void TextStreamNode::notify(void) const
+{
+	int fd = _notify_fd;
+	if (0 <= fd) eventfd_write(fd, 1);
+}
+
+void TextStreamNode::clear_notify(void) const
+{
+	int fd = _notify_fd;
+	eventfd_t cnt;
+	if (0 <= fd) eventfd_read(fd, &cnt);
+}
+
+// With a log, the item is on disk before it is queued. The appends
+// of several writers are committed together, and may come back in
+// any order; each waits its turn to go into the queue.
+void TextStreamNode::enqueue(const QueueValuePtr& qvp, ValuePtr vp) const
+{
+	std::shared_ptr<WriteAheadLog> wal = std::atomic_load(&_queue_wal);
+	if (wal and is_item(vp))
+	{
+		uint64_t off = wal->append(vp);
+		std::unique_lock<std::mutex> lock(_wal_mtx);
+		_wal_cv.wait(lock, [&] { return _wal_in == off; });
+		qvp->add(std::move(vp));
+		_wal_in++;
+		_wal_cv.notify_all();
+	}
+	else
+		qvp->add(std::move(vp));
+	notify();
+}
+
+// Readers of a queue pass what they remove through here, to keep
+// count of the offset, if logged, and to capture it.
+ValuePtr TextStreamNode::wal_dequeued(const ValuePtr& vp) const
+{
+	if (not is_item(vp)) return vp;
+	capture(vp);
+	if (nullptr == std::atomic_load(&_queue_wal)) return vp;
+
+	std::lock_guard<std::mutex> lock(_wal_mtx);
+	_wal_last = _wal_out++;
+	return vp;
+}
+
+// Items still in the queue are read from it, not replayed.
+uint64_t TextStreamNode::replay_end(const WriteAheadLog& wal) const
+{
+	std::shared_ptr<WriteAheadLog> qwal = std::atomic_load(&_queue_wal);
+	if (qwal.get() != &wal) return wal.next_offset();
+
+	std::lock_guard<std::mutex> lock(_wal_mtx);
+	return _wal_out;
+}
+
+// ==============================================================
+
+void TextStreamNode::setValue(const Handle& key, const ValuePtr& value)
+{
+	if (PREDICATE_NODE == key->get_type())
+	{
+		static constexpr uint32_t p_filter =
+			dispatch_hash("*-filter-*");
+		static constexpr uint32_t p_fields =
+			dispatch_hash("*-fields-*");
+		static constexpr uint32_t p_normalize =
+			dispatch_hash("*-normalize-*");
+		static constexpr uint32_t p_timeout =
+			dispatch_hash("*-timeout-*");
+		static constexpr uint32_t p_spill =
+			dispatch_hash("*-spill-*");
+
+		switch (dispatch_hash(key->get_name().c_str()))
+		{
+			case p_filter:
+				set_filter(value);
+				return;
+			case p_fields:
+				set_fields(value);
+				return;
+			case p_normalize:
+				set_normalize(value);
+				return;
+			case p_timeout:
+				set_timeout(value);
+				return;
+			case p_spill:
+				set_spill(value);
+				return;
+			default:
+				break;
+		}
+	}
+
+	StreamNode::setValue(key, value);
+}
+
+std::string TextStreamNode::monitor(void) const
+{
+	std::shared_ptr<const LineFilter> filt = std::atomic_load(&_filter);
+	std::shared_ptr<const FieldSplitter> fs = std::atomic_load(&_fields);
+	std::shared_ptr<const LineNormalizer> norm = std::atomic_load(&_normalizer);
+	std::shared_ptr<WriteAheadLog> wal = std::atomic_load(&_wal);
+	std::shared_ptr<StreamCapture> cap = std::atomic_load(&_capture);
+	std::shared_ptr<BroadcastRing> tee = tee_ring();
+	std::shared_ptr<SampleSlot> smp = sample_slot();
+	int ms = _timeout_ms;
+	SpillQueuePtr sqp;
+	{
+		std::lock_guard<std::mutex> lock(_spill_mtx);
+		sqp = _spill_queue.lock();
+	}
+	if (nullptr == filt and nullptr == fs and nullptr == norm and 0 == ms
+	    and nullptr == sqp and nullptr == wal and nullptr == cap
+	    and nullptr == tee and nullptr == smp)
+		return StreamNode::monitor();
+
+	std::string rpt;
+	if (ms) rpt += "Read timeout: " + std::to_string(ms) + " ms\n";
+	if (sqp) rpt += sqp->stats();
+	if (wal) rpt += wal->to_string();
+	if (cap) rpt += cap->to_string();
+	if (tee) rpt += tee->to_string();
+	if (smp) rpt += smp->to_string();
+	if (norm) rpt += norm->to_string();
+	if (filt) rpt += filt->to_string();
+	if (fs) rpt += fs->to_string();
+	return rpt;
+}
+
 // ==============================================================
 
 // Unpack strings.
@@ -110,10 +722,34 @@ void TextStreamNode::do_write(const ValuePtr& content)
 		"Expecting strings, got %s\n", content->to_string().c_str());
 }
 
+// Same as above, but without blocking. Anything that isn't a plain
+// string (streams, lists, and so on) goes the long way, through write().
+AsyncTask<void> TextStreamNode::async_write_text(ValuePtr content)
+{
+	if (content->is_type(STRING_VALUE))
+	{
+		StringValuePtr svp(StringValueCast(content));
+		for (const std::string& str : svp->value())
+			co_await async_do_write(str);
+		co_return;
+	}
+	if (content->is_type(NODE))
+	{
+		co_await async_do_write(HandleCast(content)->get_name());
+		co_return;
+	}
+	write(content);
+}
+
 // ==============================================================
 
+// JSON lines and numeric fields are not strings; stream them whole.
 ValuePtr TextStreamNode::stream(void) const
 {
+	std::shared_ptr<const FieldSplitter> fs = std::atomic_load(&_fields);
+	if (nameserver().isA(_item_type, LINK_VALUE) or (fs and fs->numeric())
+	    or _conflate)
+		return StreamNode::stream();
 	return createStringStream(get_handle());
 }
 
@@ -23,7 +23,16 @@
 #ifndef _OPENCOG_TEXT_STREAM_NODE_H
 #define _OPENCOG_TEXT_STREAM_NODE_H
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <opencog/atoms/sensory/FieldSplitter.h>
+#include <opencog/atoms/sensory/LineFilter.h>
+#include <opencog/atoms/sensory/LineNormalizer.h>
+#include <opencog/atoms/sensory/SpillQueue.h>
 #include <opencog/atoms/sensory/StreamNode.h>
+#include <opencog/atoms/value/QueueValue.h>
 
 namespace opencog
 {
@@ -42,6 +51,41 @@ namespace opencog
  * almost anything to be streamed in, converting it into c++ strings
  * that are easy to handle to the actual writer.
  *
+ * Lines being read can be normalized, with the *-normalize-* message:
+ * the trailing newline or CRLF trimmed off, and the text checked to
+ * be valid UTF-8, or repaired if not.
+ *
+ * Lines being read can be filtered, with the *-filter-* message,
+ * before they are converted to Values; lines that are dropped never
+ * become Values at all. This applies to every reader built on
+ * do_read(). The monitor reports how many lines were kept and
+ * dropped.
+ *
+ * Lines can also be split into fields, with the *-fields-* message,
+ * for reading CSV, TSV and the like. Each line then becomes one
+ * multi-element StringValue, or, in numeric mode, one FloatValue.
+ *
+ * Reads can be given a timeout, in milliseconds, with the *-timeout-*
+ * message. A read that times out returns a TimeoutValue, which is
+ * not end-of-file; the next read just tries again. This lets an agent
+ * poll many nodes, with bounded latency, from one thread. (In JSON
+ * mode, a line of `null` or `[]` reads as an empty LinkValue; that is
+ * an item, like any other, and not a timeout.)
+ *
+ * Nodes that queue up what they read, for stream(), can be told to
+ * keep at most so many bytes of it in memory, with the *-spill-*
+ * message; the rest goes to disk, until the consumer catches up. See
+ * SpillQueue.
+ *
+ * With a write-ahead log (see StreamNode), items are logged as they
+ * are read; or, for nodes that queue, as they are queued, so that a
+ * crash loses nothing that was queued but not yet read. For those,
+ * the log in place at open is the one used, until the next open.
+ *
+ * Opening with (Type 'LinkValue) reads JSON lines (NDJSON): each line
+ * is parsed as JSON, and converted into nested LinkValues, with
+ * StringValue, FloatValue and BoolValue leaves.
+ *
  * This API is experimental.
  */
 class TextStreamNode
@@ -49,6 +93,60 @@ class TextStreamNode
 {
 protected:
 	ValuePtr string_to_type(std::string) const;
+	ValuePtr line_to_type(std::string) const;
+
+	// Filter on lines being read; null if none.
+	std::shared_ptr<const LineFilter> _filter;
+	void set_filter(const ValuePtr&);
+
+	// Field splitting of lines being read; null if none.
+	std::shared_ptr<const FieldSplitter> _fields;
+	void set_fields(const ValuePtr&);
+
+	// Trimming and UTF-8 checking of lines being read; null if none.
+	std::shared_ptr<const LineNormalizer> _normalizer;
+	void set_normalize(const ValuePtr&);
+
+	// Read timeout, in milliseconds; zero if none. Readers that wait
+	// should get a read_deadline(), and throw ReadTimeout when it has
+	// passed; or, if they read from a queue, use wait_queue().
+	std::atomic<int> _timeout_ms;
+	void set_timeout(const ValuePtr&);
+	Deadline read_deadline(void) const;
+	ValuePtr wait_queue(const QueueValuePtr&) const;
+
+	// Wakeups for readers of a queue. Writers to the queue should
+	// enqueue() rather than add(), and close() should notify(), so
+	// that wait_queue() and SelectLink wake up at once. The eventfd
+	// is made on first use; nodes that never queue never have one.
+	mutable std::atomic<int> _notify_fd;
+	int notify_fd(void) const;
+	void notify(void) const;
+	void clear_notify(void) const;
+	void enqueue(const QueueValuePtr&, ValuePtr) const;
+
+	// Memory cap for queues, in bytes, and where to spill past it.
+	// Derived classes that queue should get their queue from
+	// make_queue(), at open; a cap of zero is a plain QueueValue.
+	mutable std::mutex _spill_mtx;
+	size_t _spill_cap;
+	std::string _spill_dir;
+	mutable std::weak_ptr<SpillQueue> _spill_queue;
+	void set_spill(const ValuePtr&);
+	QueueValuePtr make_queue(void) const;
+
+	// The log that enqueue() writes to, set by make_queue(). Items
+	// go into the queue in offset order, so readers can count them
+	// off: _wal_in is the offset of the next to go in, _wal_out of
+	// the next to come out. Both are under _wal_mtx.
+	mutable std::shared_ptr<WriteAheadLog> _queue_wal;
+	mutable std::condition_variable _wal_cv;
+	mutable uint64_t _wal_in;
+	mutable uint64_t _wal_out;
+	ValuePtr wal_dequeued(const ValuePtr&) const;
+	virtual uint64_t replay_end(const WriteAheadLog&) const;
+
+	AsyncTask<ValuePtr> next_value(void) const;
 
 	TextStreamNode(Type t, const std::string&&);
 	virtual void open(const ValuePtr&);
@@ -56,6 +154,15 @@ protected:
 	virtual ValuePtr read(void) const;
 	virtual std::string do_read(void) const;
 
+	// Derived classes that can wait on a file descriptor should
+	// override these, and make do_read() and do_write() call them,
+	// with sync_wait(). The defaults call do_read() and do_write().
+	virtual AsyncTask<std::string> async_do_read(void) const;
+	virtual AsyncTask<void> async_do_write(std::string);
+
+	// Write strings with async_do_write(); anything else with write().
+	AsyncTask<void> async_write_text(ValuePtr);
+
 	virtual void do_write(const ValuePtr&);
 
 	// Derived classes need to implement a handler.
@@ -65,6 +172,11 @@ protected:
 
 public:
 	virtual ~TextStreamNode();
+
+	virtual void setValue(const Handle& key, const ValuePtr& value);
+	virtual std::string monitor(void) const;
+
+	virtual AsyncTask<ValuePtr> async_read(void) const;
 };
 
 NODE_PTR_DECL(TextStreamNode)
@@ -0,0 +1,337 @@
+/*
+ * opencog/atoms/sensory/ValueCodec.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string.h>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/value/BoolValue.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/StringValue.h>
+#include <opencog/atoms/value/ValueFactory.h>
+#include <opencog/atoms/value/VoidValue.h>
+
+#include <opencog/sensory/types/atom_types.h>
+#include "ValueCodec.h"
+
+using namespace opencog;
+
+// ==============================================================
+// Varints: seven bits per byte, low bits first; the high bit is set
+// on every byte but the last.
+
+void ValueCodec::put_varint(std::string& out, uint64_t n)
+{
+	while (0x80 <= n)
+	{
+		out.push_back((char) (0x80 | (n & 0x7f)));
+		n >>= 7;
+	}
+	out.push_back((char) n);
+}
+
+static size_t varint_size(uint64_t n)
+{
+	size_t sz = 1;
+	while (0x80 <= n) { n >>= 7; sz++; }
+	return sz;
+}
+
+static void cut_short(void)
+{
+	throw RuntimeException(TRACE_INFO, "Encoded Value is cut short\n");
+}
+
+static uint64_t get_varint(const char*& p, const char* end)
+{
+	uint64_t n = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		if (p >= end) cut_short();
+		uint8_t b = (uint8_t) *p++;
+		n |= ((uint64_t) (b & 0x7f)) << shift;
+		if (0 == (b & 0x80)) return n;
+	}
+	throw RuntimeException(TRACE_INFO, "Bad varint in encoded Value\n");
+}
+
+// A count of things that take at least `min` bytes each; checked
+// against what is left, so that a bad count can't ask for the moon.
+static size_t get_count(const char*& p, const char* end, size_t min)
+{
+	uint64_t n = get_varint(p, end);
+	if (0 < min and (uint64_t) (end - p) / min < n) cut_short();
+	return (size_t) n;
+}
+
+static void put_string(std::string& out, const std::string& str)
+{
+	ValueCodec::put_varint(out, str.size());
+	out.append(str);
+}
+
+static std::string get_string(const char*& p, const char* end)
+{
+	size_t len = get_count(p, end, 1);
+	std::string str(p, len);
+	p += len;
+	return str;
+}
+
+// ==============================================================
+
+void ValueCodec::encode(const ValuePtr& vp, std::string& out)
+{
+	Type t = vp->get_type();
+	put_varint(out, t);
+
+	if (nameserver().isA(t, STRING_VALUE))
+	{
+		const std::vector<std::string>& strs = StringValueCast(vp)->value();
+		put_varint(out, strs.size());
+		for (const std::string& str : strs)
+			put_string(out, str);
+		return;
+	}
+
+	if (nameserver().isA(t, FLOAT_VALUE))
+	{
+		const std::vector<double>& dbl = FloatValueCast(vp)->value();
+		put_varint(out, dbl.size());
+		out.append((const char*) dbl.data(), dbl.size() * sizeof(double));
+		return;
+	}
+
+	if (nameserver().isA(t, BOOL_VALUE))
+	{
+		const std::vector<bool>& bits = BoolValueCast(vp)->value();
+		put_varint(out, bits.size());
+		for (size_t i = 0; i < bits.size(); i += 8)
+		{
+			uint8_t b = 0;
+			for (size_t j = 0; j < 8 and i + j < bits.size(); j++)
+				if (bits[i+j]) b |= (1 << j);
+			out.push_back((char) b);
+		}
+		return;
+	}
+
+	// Containers change as they are looked at; there is no one
+	// value to save.
+	if (nameserver().isA(t, LINK_VALUE) and
+	    not nameserver().isA(t, CONTAINER_VALUE))
+	{
+		const ValueSeq& vals = LinkValueCast(vp)->value();
+		put_varint(out, vals.size());
+		for (const ValuePtr& v : vals)
+			encode(v, out);
+		return;
+	}
+
+	if (nameserver().isA(t, VOID_VALUE))
+		return;
+
+	if (vp->is_node())
+	{
+		put_string(out, HandleCast(vp)->get_name());
+		return;
+	}
+
+	if (vp->is_link())
+	{
+		const HandleSeq& oset = HandleCast(vp)->getOutgoingSet();
+		put_varint(out, oset.size());
+		for (const Handle& h : oset)
+			encode(h, out);
+		return;
+	}
+
+	throw RuntimeException(TRACE_INFO,
+		"Unable to encode %s\n", vp->to_string().c_str());
+}
+
+size_t ValueCodec::encoded_size(const ValuePtr& vp)
+{
+	Type t = vp->get_type();
+	size_t sz = varint_size(t);
+
+	if (nameserver().isA(t, STRING_VALUE))
+	{
+		const std::vector<std::string>& strs = StringValueCast(vp)->value();
+		sz += varint_size(strs.size());
+		for (const std::string& str : strs)
+			sz += varint_size(str.size()) + str.size();
+		return sz;
+	}
+
+	if (nameserver().isA(t, FLOAT_VALUE))
+	{
+		size_t n = FloatValueCast(vp)->value().size();
+		return sz + varint_size(n) + n * sizeof(double);
+	}
+
+	if (nameserver().isA(t, BOOL_VALUE))
+	{
+		size_t n = BoolValueCast(vp)->value().size();
+		return sz + varint_size(n) + (n + 7) / 8;
+	}
+
+	if (nameserver().isA(t, LINK_VALUE) and
+	    not nameserver().isA(t, CONTAINER_VALUE))
+	{
+		const ValueSeq& vals = LinkValueCast(vp)->value();
+		sz += varint_size(vals.size());
+		for (const ValuePtr& v : vals)
+			sz += encoded_size(v);
+		return sz;
+	}
+
+	if (nameserver().isA(t, VOID_VALUE))
+		return sz;
+
+	if (vp->is_node())
+	{
+		const std::string& name = HandleCast(vp)->get_name();
+		return sz + varint_size(name.size()) + name.size();
+	}
+
+	if (vp->is_link())
+	{
+		const HandleSeq& oset = HandleCast(vp)->getOutgoingSet();
+		sz += varint_size(oset.size());
+		for (const Handle& h : oset)
+			sz += encoded_size(h);
+		return sz;
+	}
+
+	throw RuntimeException(TRACE_INFO,
+		"Unable to encode %s\n", vp->to_string().c_str());
+}
+
+// ==============================================================
+
+void ValueCodec::put_types(std::string& out)
+{
+	Type ntypes = nameserver().getNumberOfClasses();
+	put_varint(out, ntypes);
+	for (Type t = 0; t < ntypes; t++)
+		put_string(out, nameserver().getTypeName(t));
+}
+
+std::vector<Type> ValueCodec::get_types(const char*& p, const char* end)
+{
+	size_t n = get_count(p, end, 1);
+	std::vector<Type> types;
+	types.reserve(n);
+	for (size_t i = 0; i < n; i++)
+		types.push_back(nameserver().getType(get_string(p, end)));
+	return types;
+}
+
+// ==============================================================
+
+ValuePtr ValueCodec::decode(const char*& p, const char* end,
+                            const std::vector<Type>* types)
+{
+	uint64_t tnum = get_varint(p, end);
+	if (types)
+	{
+		if (types->size() <= tnum or NOTYPE == (*types)[tnum])
+			throw RuntimeException(TRACE_INFO,
+				"Unknown type %lu in encoded Value\n", (unsigned long) tnum);
+		tnum = (*types)[tnum];
+	}
+	if (nameserver().getNumberOfClasses() <= tnum)
+		throw RuntimeException(TRACE_INFO,
+			"Bad type %lu in encoded Value\n", (unsigned long) tnum);
+	Type t = (Type) tnum;
+
+	if (nameserver().isA(t, STRING_VALUE))
+	{
+		size_t n = get_count(p, end, 1);
+		std::vector<std::string> strs;
+		strs.reserve(n);
+		for (size_t i = 0; i < n; i++)
+			strs.emplace_back(get_string(p, end));
+		if (STRING_VALUE == t) return createStringValue(std::move(strs));
+		return valueserver().create(t, std::move(strs));
+	}
+
+	if (nameserver().isA(t, FLOAT_VALUE))
+	{
+		size_t n = get_count(p, end, sizeof(double));
+		std::vector<double> dbl(n);
+		memcpy(dbl.data(), p, n * sizeof(double));
+		p += n * sizeof(double);
+		if (FLOAT_VALUE == t) return createFloatValue(std::move(dbl));
+		return valueserver().create(t, std::move(dbl));
+	}
+
+	if (nameserver().isA(t, BOOL_VALUE))
+	{
+		size_t n = get_varint(p, end);
+		if ((size_t) (end - p) < (n + 7) / 8) cut_short();
+		std::vector<bool> bits(n);
+		for (size_t i = 0; i < n; i++)
+			bits[i] = (p[i / 8] >> (i % 8)) & 1;
+		p += (n + 7) / 8;
+		if (BOOL_VALUE == t) return createBoolValue(std::move(bits));
+		return valueserver().create(t, std::move(bits));
+	}
+
+	if (nameserver().isA(t, LINK_VALUE) and
+	    not nameserver().isA(t, CONTAINER_VALUE))
+	{
+		size_t n = get_count(p, end, 1);
+		ValueSeq vals;
+		vals.reserve(n);
+		for (size_t i = 0; i < n; i++)
+			vals.emplace_back(decode(p, end, types));
+		if (LINK_VALUE == t) return createLinkValue(std::move(vals));
+		return valueserver().create(t, std::move(vals));
+	}
+
+	if (nameserver().isA(t, VOID_VALUE))
+		return createVoidValue();
+
+	if (nameserver().isA(t, NODE))
+		return createNode(t, get_string(p, end));
+
+	if (nameserver().isA(t, LINK))
+	{
+		size_t n = get_count(p, end, 1);
+		HandleSeq oset;
+		oset.reserve(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			Handle h(HandleCast(decode(p, end, types)));
+			if (nullptr == h)
+				throw RuntimeException(TRACE_INFO,
+					"Expecting an Atom in an encoded Link\n");
+			oset.emplace_back(h);
+		}
+		return createLink(std::move(oset), t);
+	}
+
+	throw RuntimeException(TRACE_INFO,
+		"Unable to decode a Value of type %s\n",
+		nameserver().getTypeName(t).c_str());
+}
+
+/* ===================== END OF FILE ===================== */
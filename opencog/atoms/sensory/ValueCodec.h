@@ -0,0 +1,80 @@
+/*
+ * opencog/atoms/sensory/ValueCodec.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_VALUE_CODEC_H
+#define _OPENCOG_VALUE_CODEC_H
+
+#include <string>
+#include <vector>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * ValueCodec - Compact binary encoding of Values, for keeping them
+ * outside of RAM for a while, in the same process.
+ *
+ * Handles StringValues, FloatValues, BoolValues, LinkValues, VoidValues,
+ * Nodes and Links, and their subtypes; that is everything the sensory
+ * nodes produce. Anything else, e.g. a QueueValue, cannot be encoded.
+ *
+ * Each Value is its type, then its contents; counts and lengths are
+ * varints, floats are raw doubles, and bools are packed eight to a
+ * byte. Type numbers are not stable from one build to the next; to
+ * read back an encoding made elsewhere, pass decode() a table mapping
+ * the writer's type numbers to ours; put_types() and get_types()
+ * save and restore the type names for that.
+ *
+ * Atoms come back as fresh Atoms, not in any AtomSpace.
+ */
+class ValueCodec
+{
+public:
+	/// Append the encoding to `out`. Throws if the Value, or anything
+	/// in it, cannot be encoded.
+	static void encode(const ValuePtr&, std::string& out);
+
+	/// The number of bytes that encode() would append.
+	static size_t encoded_size(const ValuePtr&);
+
+	/// Append an unsigned number, as a varint, the way encode() does.
+	static void put_varint(std::string& out, uint64_t);
+
+	/// Append a table of the names of all of our types, in order of
+	/// their numbers, for get_types() to read back.
+	static void put_types(std::string& out);
+
+	/// Read a table made by put_types(), perhaps by another process,
+	/// and advance `p` past it. The result maps the writer's type
+	/// numbers to ours, for decode(); types we don't have are NOTYPE.
+	static std::vector<Type> get_types(const char*& p, const char* end);
+
+	/// Decode one Value starting at `p`, and advance `p` past it.
+	/// Throws if the encoding is cut short, or is not valid. If given,
+	/// `types` maps the type numbers in the encoding to ours.
+	static ValuePtr decode(const char*& p, const char* end,
+	                       const std::vector<Type>* types = nullptr);
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_VALUE_CODEC_H
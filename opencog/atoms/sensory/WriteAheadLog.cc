@@ -0,0 +1,609 @@
+/*
+ * opencog/atoms/sensory/WriteAheadLog.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+
+#include <opencog/util/exceptions.h>
+#include "ValueCodec.h"
+#include "WriteAheadLog.h"
+
+using namespace opencog;
+
+// Each record is a four-byte length of the Value, a four-byte CRC32C,
+// the eight-byte offset, and then the encoded Value. The checksum
+// covers the Value, and then the offset.
+#define HDR_BYTES 16
+
+// ==============================================================
+// CRC32C, the Castagnoli polynomial; the one with a CPU instruction.
+
+#ifndef __SSE4_2__
+static uint32_t crc_table[256];
+
+static bool make_crc_table(void)
+{
+	for (uint32_t i = 0; i < 256; i++)
+	{
+		uint32_t c = i;
+		for (int k = 0; k < 8; k++)
+			c = (c & 1) ? (0x82F63B78 ^ (c >> 1)) : (c >> 1);
+		crc_table[i] = c;
+	}
+	return true;
+}
+#endif
+
+static uint32_t crc32c(uint32_t crc, const char* buf, size_t len)
+{
+	crc = ~crc;
+#ifdef __SSE4_2__
+	while (8 <= len)
+	{
+		uint64_t w;
+		memcpy(&w, buf, 8);
+		crc = (uint32_t) _mm_crc32_u64(crc, w);
+		buf += 8;
+		len -= 8;
+	}
+	while (0 < len--)
+		crc = _mm_crc32_u8(crc, (uint8_t) *buf++);
+#else
+	static bool made = make_crc_table();
+	(void) made;
+	while (0 < len--)
+		crc = crc_table[(crc ^ (uint8_t) *buf++) & 0xff] ^ (crc >> 8);
+#endif
+	return ~crc;
+}
+
+// ==============================================================
+// Each segment starts with MAGIC, the four-byte length of a type
+// table, its CRC32C, and then the table, from ValueCodec::put_types().
+
+#define MAGIC_BYTES 8
+#define SEG_HDR_BYTES 16
+
+static std::string make_header(void)
+{
+	std::string table;
+	ValueCodec::put_types(table);
+	uint32_t tlen = table.size();
+	uint32_t crc = crc32c(0, table.data(), tlen);
+
+	std::string hdr(WriteAheadLog::MAGIC, MAGIC_BYTES);
+	hdr.append((const char*) &tlen, 4);
+	hdr.append((const char*) &crc, 4);
+	hdr.append(table);
+	return hdr;
+}
+
+// The size of the header at the start of a segment; zero if it is
+// not whole, as when a crash came while the segment was being made.
+static size_t header_size(const char* map, size_t len)
+{
+	if (len < SEG_HDR_BYTES or
+	    0 != memcmp(map, WriteAheadLog::MAGIC, MAGIC_BYTES))
+		return 0;
+	uint32_t tlen, crc;
+	memcpy(&tlen, map + MAGIC_BYTES, 4);
+	memcpy(&crc, map + MAGIC_BYTES + 4, 4);
+	if (len - SEG_HDR_BYTES < tlen or
+	    crc != crc32c(0, map + SEG_HDR_BYTES, tlen))
+		return 0;
+	return SEG_HDR_BYTES + tlen;
+}
+
+// ==============================================================
+
+static void fsync_dir(const std::string& dir)
+{
+	int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (0 > fd) return;
+	fsync(fd);
+	::close(fd);
+}
+
+// Returns zero, or the errno.
+static int write_all(int fd, const char* p, size_t len)
+{
+	while (0 < len)
+	{
+		ssize_t nw = ::write(fd, p, len);
+		if (0 > nw and EINTR == errno) continue;
+		if (0 > nw) return errno;
+		p += nw;
+		len -= nw;
+	}
+	return 0;
+}
+
+WriteAheadLog::WriteAheadLog(const std::string& dir) :
+	_dir(dir),
+	_header(make_header()),
+	_fd(-1),
+	_seg_bytes(0),
+	_next(0),
+	_durable(0),
+	_acked(-1),
+	_pending_end(0),
+	_committing(false),
+	_error(0),
+	_commits(0),
+	_committed(0)
+{
+	if (0 != mkdir(_dir.c_str(), 0700) and EEXIST != errno)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to make log directory \"%s\": %s\n",
+			_dir.c_str(), strerror(errno));
+	recover();
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+	if (0 <= _fd) ::close(_fd);
+}
+
+// ==============================================================
+// Opening an existing log.
+
+void WriteAheadLog::recover(void)
+{
+	FILE* af = fopen((_dir + "/ack").c_str(), "r");
+	if (af)
+	{
+		long long a;
+		if (1 == fscanf(af, "%lld", &a)) _acked = a;
+		fclose(af);
+	}
+
+	DIR* dp = opendir(_dir.c_str());
+	if (nullptr == dp)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to read log directory \"%s\": %s\n",
+			_dir.c_str(), strerror(errno));
+	struct dirent* de;
+	while ((de = readdir(dp)))
+	{
+		const char* name = de->d_name;
+		size_t len = strlen(name);
+		if (len < 5 or 0 != strcmp(name + len - 4, ".wal")) continue;
+		char* endp;
+		uint64_t base = strtoull(name, &endp, 10);
+		if (endp != name + len - 4) continue;
+		_segs.push_back({base, base, _dir + "/" + name, false});
+	}
+	closedir(dp);
+
+	std::sort(_segs.begin(), _segs.end(),
+		[](const Segment& a, const Segment& b) { return a.base < b.base; });
+
+	for (size_t i = 0; i < _segs.size(); i++)
+	{
+		scan_segment(_segs[i], i + 1 == _segs.size());
+		if (0 < i and _segs[i].base != _segs[i-1].end)
+			throw RuntimeException(TRACE_INFO,
+				"Log segment \"%s\" does not follow on from the one "
+				"before it\n", _segs[i].path.c_str());
+	}
+
+	// A new log starts after whatever was acknowledged, so that
+	// offsets are never handed out twice.
+	if (_segs.empty())
+	{
+		_next = _durable = _pending_end = _acked + 1;
+		open_segment(_next);
+		return;
+	}
+
+	// Records in the last segment use its type numbers; if ours are
+	// not the same, ours go into a segment of their own. One with no
+	// records in it, or only part of a header, is simply made anew.
+	Segment& last = _segs.back();
+	if (not last.our_types)
+	{
+		uint64_t base = last.end;
+		if (last.base == last.end) _segs.pop_back();
+		_next = _durable = _pending_end = base;
+		open_segment(base);
+		return;
+	}
+
+	_fd = ::open(last.path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+	if (0 > _fd)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to open log segment \"%s\": %s\n",
+			last.path.c_str(), strerror(errno));
+	struct stat st;
+	fstat(_fd, &st);
+	_seg_bytes = st.st_size;
+	_next = _durable = _pending_end = last.end;
+}
+
+// Walk the records of a segment, to find where it ends. A bad record
+// at the end of the last segment is what a crash in mid-write leaves
+// behind; it was never acknowledged to anyone, and is cut off. Any
+// other bad record is damage, and is not papered over.
+void WriteAheadLog::scan_segment(Segment& seg, bool last)
+{
+	int fd = ::open(seg.path.c_str(), O_RDWR | O_CLOEXEC);
+	if (0 > fd)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to open log segment \"%s\": %s\n",
+			seg.path.c_str(), strerror(errno));
+
+	struct stat st;
+	fstat(fd, &st);
+	size_t len = st.st_size;
+	const char* map = nullptr;
+	if (0 < len)
+	{
+		void* mp = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (MAP_FAILED == mp)
+		{
+			::close(fd);
+			throw RuntimeException(TRACE_INFO,
+				"Unable to map log segment \"%s\": %s\n",
+				seg.path.c_str(), strerror(errno));
+		}
+		map = (const char*) mp;
+	}
+
+	size_t pos = header_size(map, len);
+	seg.our_types = (pos == _header.size() and
+		0 == memcmp(map, _header.data(), pos));
+	uint64_t expect = seg.base;
+	bool bad = (0 == pos);
+	while (not bad and pos < len)
+	{
+		uint32_t vlen, crc;
+		uint64_t off;
+		if (len - pos < HDR_BYTES) { bad = true; break; }
+		memcpy(&vlen, map + pos, 4);
+		memcpy(&crc, map + pos + 4, 4);
+		memcpy(&off, map + pos + 8, 8);
+		if (len - pos - HDR_BYTES < vlen or off != expect) { bad = true; break; }
+		uint32_t sum = crc32c(0, map + pos + HDR_BYTES, vlen);
+		if (crc != crc32c(sum, map + pos + 8, 8)) { bad = true; break; }
+		pos += HDR_BYTES + vlen;
+		expect++;
+	}
+	if (map) munmap((void*) map, len);
+
+	if (bad and not last)
+	{
+		::close(fd);
+		throw RuntimeException(TRACE_INFO,
+			"Log segment \"%s\" is damaged at byte %zu\n",
+			seg.path.c_str(), pos);
+	}
+	if (bad)
+	{
+		if (0 != ftruncate(fd, pos) or 0 != fsync(fd))
+		{
+			int err = errno;
+			::close(fd);
+			throw RuntimeException(TRACE_INFO,
+				"Unable to cut off the torn end of \"%s\": %s\n",
+				seg.path.c_str(), strerror(err));
+		}
+	}
+	::close(fd);
+	seg.end = expect;
+}
+
+// Start a new segment; called with the lock held, or before anyone
+// else can see the log.
+void WriteAheadLog::open_segment(uint64_t base)
+{
+	char name[32];
+	snprintf(name, sizeof(name), "/%020llu.wal", (unsigned long long) base);
+	std::string path = _dir + name;
+	int fd = ::open(path.c_str(),
+		O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0600);
+	if (0 > fd)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to create log segment \"%s\": %s\n",
+			path.c_str(), strerror(errno));
+
+	int err = write_all(fd, _header.data(), _header.size());
+	if (0 == err and 0 != fdatasync(fd)) err = errno;
+	if (err)
+	{
+		::close(fd);
+		unlink(path.c_str());
+		throw RuntimeException(TRACE_INFO,
+			"Unable to write log segment \"%s\": %s\n",
+			path.c_str(), strerror(err));
+	}
+	fsync_dir(_dir);
+
+	if (0 <= _fd) ::close(_fd);
+	_fd = fd;
+	_seg_bytes = _header.size();
+	_segs.push_back({base, base, path, true});
+}
+
+// ==============================================================
+// Group commit. Whoever finds no commit under way takes everything
+// pending, writes it, and syncs it, outside the lock; those who come
+// along meanwhile pile up in _pending, for the next one.
+
+void WriteAheadLog::commit(std::unique_lock<std::mutex>& lock)
+{
+	_committing = true;
+	std::string batch;
+	batch.swap(_pending);
+	uint64_t end = _pending_end;
+	int fd = _fd;
+	lock.unlock();
+
+	int err = write_all(fd, batch.data(), batch.size());
+	if (0 == err and 0 != fdatasync(fd)) err = errno;
+
+	lock.lock();
+	_committing = false;
+	if (err)
+	{
+		_error = err;
+		_cv.notify_all();
+		return;
+	}
+
+	_commits++;
+	_committed += end - _durable;
+	_durable = end;
+	_seg_bytes += batch.size();
+	_segs.back().end = end;
+
+	if (SEGMENT_BYTES <= _seg_bytes)
+	{
+		// Appends after this one will fail; this one is safe.
+		try { open_segment(end); }
+		catch (const RuntimeException&) { _error = EIO; }
+	}
+	_cv.notify_all();
+}
+
+uint64_t WriteAheadLog::append(const ValuePtr& vp)
+{
+	std::string rec(HDR_BYTES, 0);
+	ValueCodec::encode(vp, rec);
+	uint32_t vlen = rec.size() - HDR_BYTES;
+	uint32_t sum = crc32c(0, rec.data() + HDR_BYTES, vlen);
+
+	std::unique_lock<std::mutex> lock(_mtx);
+	if (_error)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to write log \"%s\": %s\n", _dir.c_str(), strerror(_error));
+
+	uint64_t off = _next++;
+	memcpy(rec.data() + 8, &off, 8);
+	uint32_t crc = crc32c(sum, rec.data() + 8, 8);
+	memcpy(rec.data(), &vlen, 4);
+	memcpy(rec.data() + 4, &crc, 4);
+	_pending.append(rec);
+	_pending_end = _next;
+
+	while (_durable <= off)
+	{
+		if (_error)
+			throw RuntimeException(TRACE_INFO,
+				"Unable to write log \"%s\": %s\n",
+				_dir.c_str(), strerror(_error));
+		if (_committing)
+			_cv.wait(lock);
+		else
+			commit(lock);
+	}
+	return off;
+}
+
+// ==============================================================
+
+// Written aside and renamed, so that a crash leaves either the old
+// offset or the new one, never half of one.
+void WriteAheadLog::save_ack(int64_t off)
+{
+	std::string tmp = _dir + "/ack.tmp";
+	int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+	if (0 > fd)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to write \"%s\": %s\n", tmp.c_str(), strerror(errno));
+	std::string txt = std::to_string(off) + "\n";
+	int err = write_all(fd, txt.data(), txt.size());
+	if (0 == err and 0 != fsync(fd)) err = errno;
+	::close(fd);
+	if (0 == err and 0 != rename(tmp.c_str(), (_dir + "/ack").c_str()))
+		err = errno;
+	if (err)
+		throw RuntimeException(TRACE_INFO,
+			"Unable to save the ack offset in \"%s\": %s\n",
+			_dir.c_str(), strerror(err));
+	fsync_dir(_dir);
+}
+
+void WriteAheadLog::ack(uint64_t off)
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	if ((int64_t) off <= _acked) return;
+	if (_durable <= off)
+		throw RuntimeException(TRACE_INFO,
+			"Cannot acknowledge offset %llu; the log only goes to %lld\n",
+			(unsigned long long) off, (long long) _durable - 1);
+
+	save_ack(off);
+	_acked = off;
+
+	// The segment being written to is always kept.
+	while (1 < _segs.size() and _segs.front().end <= off + 1)
+	{
+		unlink(_segs.front().path.c_str());
+		_segs.erase(_segs.begin());
+	}
+}
+
+int64_t WriteAheadLog::acked(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	return _acked;
+}
+
+uint64_t WriteAheadLog::next_offset(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	return _next;
+}
+
+std::string WriteAheadLog::to_string(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	std::string rpt = "Write-ahead log: " + _dir + "\n";
+	rpt += "   Next offset: " + std::to_string(_next) +
+		"   Acknowledged: " + std::to_string(_acked) + "\n";
+	rpt += "   Segments: " + std::to_string(_segs.size()) +
+		"   Commits: " + std::to_string(_commits) + " for " +
+		std::to_string(_committed) + " items\n";
+	if (_error)
+		rpt += "   Failed: " + std::string(strerror(_error)) + "\n";
+	return rpt;
+}
+
+// ==============================================================
+// Reading it back.
+
+std::unique_ptr<WriteAheadLog::Reader>
+WriteAheadLog::replay(uint64_t from, uint64_t end) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	return std::make_unique<Reader>(_segs, from, std::min(end, _durable));
+}
+
+WriteAheadLog::Reader::Reader(std::vector<Segment> segs,
+                              uint64_t from, uint64_t end) :
+	_segs(std::move(segs)),
+	_iseg(0),
+	_map(nullptr),
+	_len(0),
+	_pos(0),
+	_next(from),
+	_end(end)
+{
+	while (_iseg < _segs.size() and _segs[_iseg].end <= from
+	       and _iseg + 1 < _segs.size())
+		_iseg++;
+}
+
+WriteAheadLog::Reader::~Reader()
+{
+	unmap();
+}
+
+void WriteAheadLog::Reader::unmap(void)
+{
+	if (_map) munmap((void*) _map, _len);
+	_map = nullptr;
+	_len = 0;
+	_pos = 0;
+}
+
+ValuePtr WriteAheadLog::Reader::next(uint64_t& off)
+{
+	while (_next < _end)
+	{
+		if (nullptr == _map)
+		{
+			if (_segs.size() <= _iseg) return nullptr;
+			const std::string& path = _segs[_iseg].path;
+
+			// Gone, if acknowledged since the reader was made.
+			int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (0 > fd) return nullptr;
+			struct stat st;
+			fstat(fd, &st);
+			if (0 == st.st_size)
+			{
+				::close(fd);
+				_iseg++;
+				continue;
+			}
+			void* mp = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			::close(fd);
+			if (MAP_FAILED == mp)
+				throw RuntimeException(TRACE_INFO,
+					"Unable to map log segment \"%s\": %s\n",
+					path.c_str(), strerror(errno));
+			madvise(mp, st.st_size, MADV_SEQUENTIAL);
+			_map = (const char*) mp;
+			_len = st.st_size;
+
+			// Records are written with the type numbers of the
+			// process that made the segment; map them to ours.
+			size_t hdr = header_size(_map, _len);
+			if (0 == hdr)
+				throw RuntimeException(TRACE_INFO,
+					"Log segment \"%s\" has a damaged header\n", path.c_str());
+			const char* tp = _map + SEG_HDR_BYTES;
+			_types = ValueCodec::get_types(tp, _map + hdr);
+			_pos = hdr;
+		}
+
+		if (_len - _pos < HDR_BYTES)
+		{
+			unmap();
+			_iseg++;
+			continue;
+		}
+
+		uint32_t vlen, crc;
+		uint64_t roff;
+		memcpy(&vlen, _map + _pos, 4);
+		memcpy(&crc, _map + _pos + 4, 4);
+		memcpy(&roff, _map + _pos + 8, 8);
+		const char* p = _map + _pos + HDR_BYTES;
+		if (_len - _pos - HDR_BYTES < vlen or
+		    crc != crc32c(crc32c(0, p, vlen), _map + _pos + 8, 8))
+			throw RuntimeException(TRACE_INFO,
+				"Log segment \"%s\" is damaged at byte %zu\n",
+				_segs[_iseg].path.c_str(), _pos);
+		_pos += HDR_BYTES + vlen;
+
+		// Skip up to the starting point.
+		if (roff < _next) continue;
+
+		ValuePtr vp(ValueCodec::decode(p, p + vlen, &_types));
+		_next = roff + 1;
+		off = roff;
+		return vp;
+	}
+	return nullptr;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,159 @@
+/*
+ * opencog/atoms/sensory/WriteAheadLog.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_WRITE_AHEAD_LOG_H
+#define _OPENCOG_WRITE_AHEAD_LOG_H
+
+#include <stdint.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * WriteAheadLog - A durable, append-only log of Values, on disk.
+ *
+ * Each Value appended gets the next offset, counting up from zero,
+ * and is on disk, fsync'ed, by the time append() returns. Appends from
+ * many threads are committed together: while one thread is in fsync,
+ * the others queue up their records, and the next fsync takes all of
+ * them. So a busy log costs one fsync per batch, not per item.
+ *
+ * The log is a directory of segment files, each named by the offset
+ * of its first record, and rolled over at about SEGMENT_BYTES. A
+ * record is its length, a CRC32C checksum, its offset, and then the
+ * Value, in ValueCodec form. On open, the segments are checked, and a
+ * record torn by a crash, at the end of the last one, is cut off.
+ *
+ * Consumers acknowledge offsets with ack(); the last one is kept in
+ * the directory, so that it survives a restart. Segments holding
+ * nothing but acknowledged records are deleted.
+ *
+ * Type numbers differ from one process to the next, depending on the
+ * order in which modules were loaded. So each segment starts with the
+ * names of the types, as numbered by the process that wrote it, and
+ * records are read back through that table. After a restart that
+ * numbers them differently, a new segment is begun, rather than
+ * appending to the last one.
+ */
+class WriteAheadLog
+{
+	struct Segment
+	{
+		uint64_t base;      // Offset of the first record
+		uint64_t end;       // Offset after the last record
+		std::string path;
+		bool our_types;     // Its type table is the same as ours
+	};
+
+	std::string _dir;
+	std::string _header;    // Starts each segment we make
+
+	mutable std::mutex _mtx;
+	std::condition_variable _cv;
+	std::vector<Segment> _segs;
+	int _fd;                // Open on the last segment
+	size_t _seg_bytes;      // Size of the last segment
+
+	uint64_t _next;         // Offset of the next append
+	uint64_t _durable;      // Everything before this is on disk
+	int64_t _acked;         // -1 if nothing was acknowledged yet
+	std::string _pending;   // Records waiting for the next commit
+	uint64_t _pending_end;
+	bool _committing;
+	int _error;             // errno of a failed commit; the log is dead
+
+	size_t _commits;
+	size_t _committed;
+
+	void recover(void);
+	void scan_segment(Segment&, bool last);
+	void open_segment(uint64_t base);
+	void commit(std::unique_lock<std::mutex>&);
+	void save_ack(int64_t);
+
+public:
+	static constexpr size_t SEGMENT_BYTES = 64 * 1024 * 1024;
+	static constexpr const char* MAGIC = "OCWAL001";
+
+	/// Open, or create, the log in the given directory.
+	WriteAheadLog(const std::string& dir);
+	~WriteAheadLog();
+
+	WriteAheadLog(const WriteAheadLog&) = delete;
+	WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+	/// Append the Value, wait until it is on disk, and return its
+	/// offset.
+	uint64_t append(const ValuePtr&);
+
+	/// Record that everything up to and including `off` has been
+	/// dealt with, and need not be replayed.
+	void ack(uint64_t off);
+
+	/// The last offset acknowledged, or -1 if none.
+	int64_t acked(void) const;
+
+	/// The offset that the next append() will get.
+	uint64_t next_offset(void) const;
+
+	const std::string& dir(void) const { return _dir; }
+	std::string to_string(void) const;
+
+	/**
+	 * Reader - reads the log in order, from a given offset, up to a
+	 * given end. Each segment is mapped into memory, and read straight
+	 * through. Segments deleted by ack() before the reader gets to
+	 * them end the replay early.
+	 */
+	class Reader
+	{
+		std::vector<Segment> _segs;
+		std::vector<Type> _types;
+		size_t _iseg;
+		const char* _map;
+		size_t _len;
+		size_t _pos;
+		uint64_t _next;
+		uint64_t _end;
+
+		void unmap(void);
+
+	public:
+		Reader(std::vector<Segment>, uint64_t from, uint64_t end);
+		~Reader();
+
+		/// The next Value and its offset; nullptr once at the end.
+		ValuePtr next(uint64_t& off);
+	};
+
+	/// Read the log from `from`, up to, but not including, `end`.
+	std::unique_ptr<Reader> replay(uint64_t from, uint64_t end) const;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_WRITE_AHEAD_LOG_H
@@ -43,6 +43,10 @@ namespace opencog
  * out of a blocking read in one thread is to call close() from a
  * different thread.
  *
+ * The socket is non-blocking; async_read() and async_write() wait for
+ * it in the Executor, without holding a thread. The plain read() and
+ * write() wait in the calling thread, as before.
+ *
  * URI format: tcp://host:port (e.g. tcp://0.0.0.0:5000)
  *
  * This is experimental.
@@ -62,8 +66,9 @@ protected:
 	int _port;                // TCP port number
 	mutable std::string _read_buf; // Partial-line read buffer
 
-	void do_accept(void) const;
+	AsyncTask<int> async_accept(Deadline) const;
 	virtual void do_write(const std::string&);
+	virtual AsyncTask<void> async_do_write(std::string);
 
 	virtual void open(const ValuePtr&);
 	virtual void close(const ValuePtr&);
@@ -71,12 +76,17 @@ protected:
 	virtual bool connected(void) const;
 	virtual void barrier(AtomSpace* = nullptr);
 	virtual std::string do_read(void) const;
+	virtual AsyncTask<std::string> async_do_read(void) const;
+	virtual bool ready(void) const;
+	virtual int ready_fd(void) const;
 
 public:
 	TcpSocketNode(const std::string&&);
 	TcpSocketNode(Type t, const std::string&&);
 	virtual ~TcpSocketNode();
 
+	virtual AsyncTask<void> async_write(ValuePtr);
+
 	static Handle factory(const Handle&);
 };
 
@@ -19,6 +19,8 @@
 #include <string.h> // for strerror()
 #include <unistd.h>
 
+#include <poll.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 
@@ -97,8 +99,9 @@ void UnixSocketNode::open(const ValuePtr& vty)
 	// Remove any stale socket file left over from a previous run.
 	unlink(_sock_path.c_str());
 
-	// Create the Unix domain socket.
-	_listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	// Create the Unix domain socket, non-blocking, so that accept()
+	// can be waited on with fd_ready().
+	_listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
 	if (0 > _listen_fd)
 		throw RuntimeException(TRACE_INFO,
 			"Unable to create socket: (%d) %s\n",
@@ -147,36 +150,75 @@ void UnixSocketNode::open(const ValuePtr& vty)
 }
 
 /// Accept a client connection, if one has not yet been accepted.
-/// This blocks until a client connects. Called lazily from do_read()
-/// and do_write(). Caller must hold _mtx.
-void UnixSocketNode::do_accept(void) const
+/// Suspends until a client connects. Returns the client fd, or -1 if
+/// the node was closed in the meantime. Throws ReadTimeout if the
+/// deadline passes first. Called lazily from the reads and writes;
+/// must not be called with _mtx held.
+AsyncTask<int> UnixSocketNode::async_accept(Deadline dl) const
 {
-	if (0 <= _client_fd) return;
-	if (0 > _listen_fd) return;
-
-	int cfd = accept(_listen_fd, nullptr, nullptr);
-	if (0 > cfd)
+	while (true)
 	{
-		int norr = errno;
-		throw RuntimeException(TRACE_INFO,
-			"Unable to accept connection on \"%s\": (%d) %s\n",
-			_sock_path.c_str(), norr, strerror(norr));
-	}
+		int lfd;
+		{
+			std::lock_guard<std::mutex> lock(_mtx);
+			if (0 <= _client_fd) co_return _client_fd;
+			lfd = _listen_fd;
+		}
+		if (0 > lfd) co_return -1;
+
+		int cfd = accept4(lfd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (0 > cfd)
+		{
+			int norr = errno;
+			if (EAGAIN == norr or EWOULDBLOCK == norr or
+			    EINTR == norr or ECONNABORTED == norr)
+			{
+				if (dl.expired()) throw ReadTimeout();
+				co_await fd_ready(lfd, EPOLLIN, dl);
+				continue;
+			}
+
+			// Closed by another thread, while we were at it?
+			{
+				std::lock_guard<std::mutex> lock(_mtx);
+				if (lfd != _listen_fd) continue;
+			}
+			throw RuntimeException(TRACE_INFO,
+				"Unable to accept connection on \"%s\": (%d) %s\n",
+				_sock_path.c_str(), norr, strerror(norr));
+		}
 
-	printf("Client connected on %s\n", _sock_path.c_str());
-	_client_fd = cfd;
+		std::lock_guard<std::mutex> lock(_mtx);
+		if (lfd != _listen_fd or 0 <= _client_fd)
+		{
+			// Lost a race with close(), or with another reader.
+			::close(cfd);
+			continue;
+		}
+		printf("Client connected on %s\n", _sock_path.c_str());
+		_client_fd = cfd;
+		co_return cfd;
+	}
 }
 
 void UnixSocketNode::close(const ValuePtr&)
 {
 	std::lock_guard<std::mutex> lock(_mtx);
 
+	// Shut down before closing, so that readers and writers waiting
+	// in fd_ready() wake up now, instead of at their next timeout.
 	if (0 <= _client_fd)
+	{
+		shutdown(_client_fd, SHUT_RDWR);
 		::close(_client_fd);
+	}
 	_client_fd = -1;
 
 	if (0 <= _listen_fd)
+	{
+		shutdown(_listen_fd, SHUT_RDWR);
 		::close(_listen_fd);
+	}
 	_listen_fd = -1;
 
 	_read_buf.clear();
@@ -202,26 +244,19 @@ bool UnixSocketNode::connected(void) const
 // ==============================================================
 
 // This will read one line from the socket, and return that line.
-// This is a line-oriented, buffered interface.
-// This blocks, waiting for input, if there is no input.
-// On the first call, this will also block waiting for a client
-// to connect (via accept()).
+// This is a line-oriented, buffered interface. If there is no input,
+// this suspends until there is. On the first call, this will also wait
+// for a client to connect.
 //
 // Uses raw read() instead of fgets/FILE* to avoid stdio buffering
-// issues on socket file descriptors.
-std::string UnixSocketNode::do_read(void) const
+// issues on socket file descriptors. The fd is non-blocking; when it
+// runs dry, wait with fd_ready(), and then check that it is still open.
+// A partial line stays buffered when a read times out.
+AsyncTask<std::string> UnixSocketNode::async_do_read(void) const
 {
-	static const std::string empty_string;
-
-	// If no client yet, accept one (blocks until a client connects).
-	{
-		std::lock_guard<std::mutex> lock(_mtx);
-		if (0 > _client_fd)
-		{
-			do_accept();
-			if (0 > _client_fd) return empty_string;
-		}
-	}
+	Deadline dl(read_deadline());
+	int cfd = co_await async_accept(dl);
+	if (0 > cfd) co_return std::string();
 
 	// Check if the read buffer already contains a complete line.
 	size_t nl = _read_buf.find('\n');
@@ -229,31 +264,33 @@ std::string UnixSocketNode::do_read(void) const
 	{
 		std::string line = _read_buf.substr(0, nl + 1);
 		_read_buf.erase(0, nl + 1);
-		return line;
+		co_return line;
 	}
 
 	// Read from the socket until we get a newline or EOF.
 	char buf[4096];
 	while (true)
 	{
-		int cfd;
 		{
 			std::lock_guard<std::mutex> lock(_mtx);
 			cfd = _client_fd;
 		}
-		if (0 > cfd) return empty_string;
+		if (0 > cfd) co_return std::string();
 
 		ssize_t nr = ::read(cfd, buf, sizeof(buf));
+		if (0 > nr and (EAGAIN == errno or EWOULDBLOCK == errno or EINTR == errno))
+		{
+			if (dl.expired()) throw ReadTimeout();
+			co_await fd_ready(cfd, EPOLLIN, dl);
+			continue;
+		}
 		if (0 >= nr)
 		{
 			// EOF or error. Return whatever partial line we have,
 			// or empty string if nothing buffered.
-			if (_read_buf.empty())
-				return empty_string;
-
 			std::string line;
 			line.swap(_read_buf);
-			return line;
+			co_return line;
 		}
 
 		_read_buf.append(buf, nr);
@@ -264,37 +301,74 @@ std::string UnixSocketNode::do_read(void) const
 		{
 			std::string line = _read_buf.substr(0, nl + 1);
 			_read_buf.erase(0, nl + 1);
-			return line;
+			co_return line;
 		}
 	}
 }
 
-// ==============================================================
-// Write stuff to the socket.
-
-void UnixSocketNode::do_write(const std::string& str)
+// Ready if a line is buffered, or if the client has sent something,
+// or if closed. A partial line counts as ready: a read then waits
+// for the rest of it. With no client yet, take one if it is waiting,
+// but do not wait for it; until then, the listen socket is the fd.
+bool UnixSocketNode::ready(void) const
 {
-	// If no client yet, accept one (blocks until a client connects).
+	if (std::string::npos != _read_buf.find('\n')) return true;
+
+	int cfd;
+	try
 	{
-		std::lock_guard<std::mutex> lock(_mtx);
-		if (0 > _client_fd)
-			do_accept();
+		cfd = sync_wait(async_accept(Deadline(std::chrono::milliseconds(0))));
 	}
+	catch (const ReadTimeout&)
+	{
+		return false;
+	}
+	if (0 > cfd) return true;
+
+	struct pollfd pfd = {cfd, POLLIN, 0};
+	return 0 < poll(&pfd, 1, 0);
+}
+
+int UnixSocketNode::ready_fd(void) const
+{
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (0 <= _client_fd) return _client_fd;
+	return _listen_fd;
+}
 
-	if (0 > _client_fd)
+// Blocks the calling thread; see async_do_read() for the details.
+std::string UnixSocketNode::do_read(void) const
+{
+	return sync_wait(async_do_read());
+}
+
+// ==============================================================
+// Write stuff to the socket.
+
+AsyncTask<void> UnixSocketNode::async_do_write(std::string str)
+{
+	// If no client yet, wait for one to connect.
+	int cfd = co_await async_accept(Deadline());
+	if (0 > cfd)
 		throw RuntimeException(TRACE_INFO,
 			"UnixSocket not open: URI \"%s\"\n", _name.c_str());
 
-	// Write the entire string.
+	// Write the entire string, waiting for room whenever the
+	// socket send buffer is full.
 	const char* data = str.c_str();
 	size_t remaining = str.length();
 	while (0 < remaining)
 	{
-		ssize_t nw = ::write(_client_fd, data, remaining);
+		ssize_t nw = ::write(cfd, data, remaining);
 		if (0 > nw)
 		{
 			int norr = errno;
 			if (EINTR == norr) continue;
+			if (EAGAIN == norr or EWOULDBLOCK == norr)
+			{
+				co_await fd_ready(cfd, EPOLLOUT);
+				continue;
+			}
 			throw RuntimeException(TRACE_INFO,
 				"Write error on socket \"%s\": (%d) %s\n",
 				_sock_path.c_str(), norr, strerror(norr));
@@ -304,6 +378,18 @@ void UnixSocketNode::do_write(const std::string& str)
 	}
 }
 
+void UnixSocketNode::do_write(const std::string& str)
+{
+	sync_wait(async_do_write(str));
+}
+
+// Strings are written with async_do_write(); everything else, such as
+// lists of strings, is unpacked by the synchronous write().
+AsyncTask<void> UnixSocketNode::async_write(ValuePtr content)
+{
+	return async_write_text(std::move(content));
+}
+
 // ==============================================================
 
 // Adds factory when library is loaded.
@@ -25,6 +25,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
 #include <stdlib.h>
 #include <string.h> // for strerror()
@@ -180,6 +181,26 @@ std::string TerminalNode::do_read(void) const
 	// feature or a bug or what the heck this is supposed to be.
 	// However, the xterm demo is low-priority, so further debugging
 	// seems unjustified.
+	//
+	// With a read timeout, wait for the tty in poll() first, unless
+	// stdio already has input buffered.
+	int ms = _timeout_ms;
+	if (0 < ms)
+	{
+		Deadline dl(std::chrono::milliseconds{ms});
+		bool buffered = input_buffered();
+		struct pollfd pfd;
+		pfd.fd = fileno(_fh);
+		pfd.events = POLLIN;
+		while (not buffered)
+		{
+			int rc = poll(&pfd, 1, dl.wait_ms(ms));
+			if (0 < rc) break;
+			if (0 > rc and EINTR != errno) break;
+			if (dl.expired()) throw ReadTimeout();
+		}
+	}
+
 #ifdef _GNU_SOURCE
 	char* rd = fgets_unlocked(buff, BUFSZ, _fh);
 #else
@@ -196,6 +217,33 @@ std::string TerminalNode::do_read(void) const
 	return str;
 }
 
+// True if stdio holds input not yet returned. This peeks at glibc
+// internals, as there is no public way of asking.
+bool TerminalNode::input_buffered(void) const
+{
+#ifdef _GNU_SOURCE
+	return _fh->_IO_read_ptr < _fh->_IO_read_end;
+#else
+	return false;
+#endif
+}
+
+bool TerminalNode::ready(void) const
+{
+	if (nullptr == _fh) return true;
+	if (input_buffered()) return true;
+
+	struct pollfd pfd = {fileno(_fh), POLLIN, 0};
+	return 0 < poll(&pfd, 1, 0);
+}
+
+int TerminalNode::ready_fd(void) const
+{
+	FILE* fh = _fh;
+	if (nullptr == fh) return -1;
+	return fileno(fh);
+}
+
 // ==============================================================
 // Write stuff to a file.
 
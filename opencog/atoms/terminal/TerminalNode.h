@@ -47,6 +47,7 @@ class TerminalNode
 protected:
 	mutable std::mutex _mtx;
 	void halt(void) const;
+	bool input_buffered(void) const;
 
 	mutable FILE* _fh;
 	mutable pid_t _xterm_pid;
@@ -57,6 +58,8 @@ protected:
 	// virtual void write(const ValuePtr&); inherited from TextWriterNode
 	virtual bool connected(void) const;
 	virtual std::string do_read(void) const;
+	virtual bool ready(void) const;
+	virtual int ready_fd(void) const;
 
 public:
 	TerminalNode(const std::string&&);
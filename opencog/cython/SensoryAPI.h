@@ -0,0 +1,122 @@
+/*
+ * opencog/cython/SensoryAPI.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _OPENCOG_SENSORY_API_H
+#define _OPENCOG_SENSORY_API_H
+
+#include <string>
+#include <vector>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/value/Float32Value.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/StringValue.h>
+#include <opencog/atoms/value/VoidValue.h>
+
+#include <opencog/sensory/types/atom_types.h>
+
+namespace opencog
+{
+
+// The C++ half of the python bindings. Each call does all of its work
+// here, without calling back into python, so that the python side can
+// drop the GIL around it; a blocking read does not stall other python
+// threads.
+
+inline void sensory_set(const Handle& node, const std::string& msg,
+                        const ValuePtr& arg)
+{
+	node->setValue(createNode(PREDICATE_NODE, msg),
+		arg ? arg : createVoidValue());
+}
+
+inline ValuePtr sensory_get(const Handle& node, const std::string& msg)
+{
+	return node->getValue(createNode(PREDICATE_NODE, msg));
+}
+
+// Read up to n items. A read that times out (a TimeoutValue) or
+// hits the end of the stream (a VoidValue) ends the batch early; the
+// marker is not returned, and eof is set for the latter.
+inline std::vector<ValuePtr> sensory_read_many(const Handle& node,
+                                               size_t n, bool& eof)
+{
+	static const Handle p_read(createNode(PREDICATE_NODE, "*-read-*"));
+
+	std::vector<ValuePtr> items;
+	items.reserve(n);
+	eof = false;
+	while (items.size() < n)
+	{
+		ValuePtr vp(node->getValue(p_read));
+		if (nullptr == vp or vp->is_type(VOID_VALUE))
+		{
+			eof = true;
+			break;
+		}
+		if (TIMEOUT_VALUE == vp->get_type()) break;
+		items.emplace_back(std::move(vp));
+	}
+	return items;
+}
+
+// As above, but for text streams: the strings of each item, with no
+// Value wrappers to build on the python side.
+inline std::vector<std::vector<std::string>>
+sensory_read_strings(const Handle& node, size_t n, bool& eof)
+{
+	std::vector<std::vector<std::string>> strs;
+	for (const ValuePtr& vp : sensory_read_many(node, n, eof))
+	{
+		if (not vp->is_type(STRING_VALUE))
+			throw RuntimeException(TRACE_INFO,
+				"Expecting a StringValue; got %s\n",
+				vp->to_string().c_str());
+		strs.emplace_back(StringValueCast(vp)->value());
+	}
+	return strs;
+}
+
+// The numbers held in a Float32Value or FloatValue, in place. Values
+// are immutable, so the pointer is good for as long as the Value is
+// held. Returns nullptr for anything else.
+inline const void* float_data(const ValuePtr& vp, size_t& len,
+                              size_t& itemsize)
+{
+	if (nullptr == vp) return nullptr;
+	if (vp->is_type(FLOAT32_VALUE))
+	{
+		const std::vector<float>& v = Float32ValueCast(vp)->value();
+		len = v.size();
+		itemsize = sizeof(float);
+		return v.data();
+	}
+	if (vp->is_type(FLOAT_VALUE))
+	{
+		const std::vector<double>& v = FloatValueCast(vp)->value();
+		len = v.size();
+		itemsize = sizeof(double);
+		return v.data();
+	}
+	return nullptr;
+}
+
+} // namespace opencog
+
+#endif // _OPENCOG_SENSORY_API_H
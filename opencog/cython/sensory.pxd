@@ -0,0 +1,31 @@
+from libcpp cimport bool
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+from opencog.atomspace cimport cHandle, cValuePtr, Atom, Value
+
+# This is the name of the constructor in the libsensory-types.so
+# shared library. If we don't call it, the sensory Atom types
+# don't get initialized correctly for python.
+cdef extern void sensory_types_init()
+
+# The C++ half of the bindings. All of these are safe to call
+# without the GIL.
+cdef extern from "SensoryAPI.h" namespace "opencog":
+    void sensory_set(const cHandle&, const string&, const cValuePtr&) except + nogil
+    cValuePtr sensory_get(const cHandle&, const string&) except + nogil
+    vector[cValuePtr] sensory_read_many(const cHandle&, size_t, bool&) except + nogil
+    vector[vector[string]] sensory_read_strings(const cHandle&, size_t, bool&) except + nogil
+    const void* float_data(const cValuePtr&, size_t&, size_t&) nogil
+
+cdef class Stream:
+    cdef cHandle _node
+    cdef readonly object atom
+    cdef readonly bint eof
+
+cdef class FloatView:
+    cdef cValuePtr _value
+    cdef const void* _data
+    cdef Py_ssize_t _shape[1]
+    cdef Py_ssize_t _strides[1]
+    cdef Py_ssize_t _itemsize
@@ -0,0 +1,182 @@
+#
+# Python bindings for the sensory nodes. Import with
+#
+# from opencog.sensory import *
+#
+# This provides the python wrappers for creating the sensory Atoms,
+# and the Stream class, for driving them without going through the
+# Atomese SetValue and ValueOf plumbing; see below.
+#
+from cpython.buffer cimport PyBUF_FORMAT, PyBUF_WRITABLE
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+from opencog.atomspace cimport create_python_value_from_c_value
+
+from opencog.atomspace import types
+from opencog.atomspace import regenerate_types
+from opencog.utilities import add_node, add_link
+
+# Step one: force the C++ shared lib ctor to run and report
+# the new Atom type to the atomspace nameserver.
+sensory_types_init()
+
+# Step two: Ask python to rebuild the list of Atom Types that it knows
+# about.  This adds new attributes to the python .types class.
+regenerate_types()
+
+# Step three: declare some wrappers to make python easier to use.
+include "opencog/sensory/types/sensory_types.pyx"
+
+
+cdef cValuePtr _c_value(arg) except *:
+    cdef cValuePtr none
+    if arg is None:
+        return none
+    if isinstance(arg, str):
+        arg = add_node(types.ItemNode, arg)
+    return (<Value?>arg).get_c_value_ptr()
+
+
+cdef class Stream:
+    """
+    A sensory node, such as a TextFileNode, OllamaNode or TcpSocketNode,
+    driven directly from python. The methods are the messages of the
+    node: `s.open(x)` is the same as
+    `(SetValue node (Predicate "*-open-*") x)`, and so on.
+
+    The GIL is released while the node does its work, so a read that
+    blocks does not hold up other python threads.
+
+        s = Stream(TextFileNode("file:///tmp/demo.txt"))
+        s.open(TypeNode("StringValue"))
+        for line in s.read_strings(1000): ...
+    """
+    def __cinit__(self, Atom atom):
+        self.atom = atom
+        self._node = atom.get_c_handle()
+        self.eof = False
+
+    def send(self, msg, arg=None):
+        """Send an arbitrary message, e.g. send("*-timeout-*", Number(50))."""
+        cdef string cmsg = msg.encode()
+        cdef cValuePtr carg = _c_value(arg)
+        with nogil:
+            sensory_set(self._node, cmsg, carg)
+
+    def get(self, msg):
+        """Get the Value of an arbitrary message, e.g. get("*-offset-*")."""
+        cdef string cmsg = msg.encode()
+        cdef cValuePtr vp
+        with nogil:
+            vp = sensory_get(self._node, cmsg)
+        return create_python_value_from_c_value(vp)
+
+    def open(self, arg=None):
+        self.eof = False
+        self.send("*-open-*", arg)
+
+    def close(self):
+        self.send("*-close-*")
+
+    def write(self, item):
+        """Write a Value, an Atom, or a python string."""
+        self.send("*-write-*", item)
+
+    def read(self):
+        """One item, exactly as *-read-* returns it."""
+        return self.get("*-read-*")
+
+    def stream(self):
+        return self.get("*-stream-*")
+
+    def connected(self):
+        return self.get("*-connected?-*").to_list()[0]
+
+    def monitor(self):
+        return self.get("*-monitor-*").to_list()[0]
+
+    def read_many(self, size_t n):
+        """
+        Up to n items, as a list of Values, in one call. The list is
+        short if a read times out, or at the end of the stream; in the
+        latter case, `eof` is set.
+        """
+        cdef vector[cValuePtr] items
+        cdef bool ateof = False
+        with nogil:
+            items = sensory_read_many(self._node, n, ateof)
+        self.eof = ateof
+        return [create_python_value_from_c_value(vp) for vp in items]
+
+    def read_strings(self, size_t n):
+        """
+        As read_many, for text streams, but without the Value wrappers:
+        a list of str for items holding one string, and of lists of str
+        for items that were split into fields.
+        """
+        cdef vector[vector[string]] items
+        cdef bool ateof = False
+        with nogil:
+            items = sensory_read_strings(self._node, n, ateof)
+        self.eof = ateof
+
+        result = []
+        for item in items:
+            if 1 == item.size():
+                result.append(item[0].decode('utf-8', 'replace'))
+            else:
+                result.append([s.decode('utf-8', 'replace') for s in item])
+        return result
+
+    def embed(self, text):
+        """
+        The embedding of the text, from an OllamaNode, as a FloatView;
+        wrap it with numpy.asarray() to get an array with no copy.
+        """
+        self.send("*-embedding-*", text)
+        return FloatView(self.get("*-embedding-*"))
+
+
+cdef class FloatView:
+    """
+    A read-only buffer-protocol view of the numbers in a Float32Value
+    (format 'f') or FloatValue (format 'd'). numpy.asarray(view) and
+    memoryview(view) share the memory of the Value, which is kept alive
+    for as long as the view is.
+    """
+    def __cinit__(self, Value value):
+        cdef size_t n = 0
+        cdef size_t itemsize = 0
+        self._value = value.get_c_value_ptr()
+        self._data = float_data(self._value, n, itemsize)
+        if NULL == self._data:
+            raise TypeError("Expecting a Float32Value or FloatValue; got %s"
+                % str(value))
+        self._shape[0] = n
+        self._strides[0] = itemsize
+        self._itemsize = itemsize
+
+    def __len__(self):
+        return self._shape[0]
+
+    def __getbuffer__(self, Py_buffer* buf, int flags):
+        if flags & PyBUF_WRITABLE:
+            raise BufferError("Values are immutable; the view is read-only")
+
+        buf.buf = <void*> self._data
+        buf.obj = self
+        buf.len = self._shape[0] * self._itemsize
+        buf.readonly = 1
+        buf.itemsize = self._itemsize
+        buf.format = NULL
+        if flags & PyBUF_FORMAT:
+            buf.format = b'f' if 4 == self._itemsize else b'd'
+        buf.ndim = 1
+        buf.shape = self._shape
+        buf.strides = self._strides
+        buf.suboffsets = NULL
+        buf.internal = NULL
+
+    def __releasebuffer__(self, Py_buffer* buf):
+        pass
@@ -11,30 +11,48 @@
 	(string-append opencog-ext-path-sensory-types "libsensory-types")
 	"sensory_types_init")
 
+; The base classes of the nodes, and the Links and Values that work
+; with them, are always needed.
 (load-extension
 	(string-append opencog-ext-path-sensory "libsensory")
 	"opencog_sensory_init")
 
-(load-extension
-	(string-append opencog-ext-path-sensory-filedir "libsensory-filedir")
-	"opencog_sensory_filedir_init")
+; The node libraries are loaded on demand, the first time a node of
+; one of their types is made; most programs use only one or two of
+; them. Until then, the types get a stand-in factory, that does the
+; loading. See lazy_library.cc for how this works.
+(use-modules (system foreign))
 
-(load-extension
-	(string-append opencog-ext-path-sensory-irc "libsensory-irc")
-	"opencog_sensory_irc_init")
+(define lazy-library
+	(pointer->procedure int
+		(dynamic-func "sensory_lazy_library"
+			(dynamic-link
+				(string-append opencog-ext-path-sensory-types "libsensory-types")))
+		(list '* '*)))
+
+(define (load-on-demand dir lib . types)
+	(lazy-library
+		(string->pointer (string-append dir lib ".so"))
+		(string->pointer (string-join (map symbol->string types)))))
+
+(load-on-demand opencog-ext-path-sensory-filedir "libsensory-filedir"
+	'TextFileNode 'FileSysNode)
+
+(load-on-demand opencog-ext-path-sensory-irc "libsensory-irc"
+	'IRChatNode)
 
 ; The Ollama module is optional; it requires cpp-httplib to build.
 (if (defined? 'opencog-ext-path-sensory-ollama)
-	(load-extension
-		(string-append opencog-ext-path-sensory-ollama "libsensory-ollama")
-		"opencog_sensory_ollama_init"))
+	(load-on-demand opencog-ext-path-sensory-ollama "libsensory-ollama"
+		'OllamaNode))
 
-(load-extension
-	(string-append opencog-ext-path-sensory-terminal "libsensory-terminal")
-	"opencog_sensory_terminal_init")
+(load-on-demand opencog-ext-path-sensory-terminal "libsensory-terminal"
+	'TerminalNode)
 
-(load-extension
-	(string-append opencog-ext-path-sensory-sockets "libsensory-sockets")
-	"opencog_sensory_sockets_init")
+(load-on-demand opencog-ext-path-sensory-sockets "libsensory-sockets"
+	'TcpSocketNode 'UnixSocketNode)
+
+(load-on-demand opencog-ext-path-sensory-replay "libsensory-replay"
+	'ReplayNode)
 
 (include-from-path "opencog/sensory/types/sensory_types.scm")
@@ -0,0 +1,98 @@
+/*
+ * opencog/sensory/types/lazy_library.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics LLC
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <dlfcn.h>
+
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/base/ClassServer.h>
+
+using namespace opencog;
+
+// Loading the node libraries on demand.
+//
+// Each sensory node type lives in a shared library of its own, and its
+// factory is installed by that library's ctors. Rather than load them
+// all at startup, sensory.scm hands each library's path, and the types
+// it holds, to sensory_lazy_library(). That installs a stand-in
+// factory for those types, which loads the library the first time a
+// node of one of them is made. The library's ctors then replace the
+// stand-in with the real factory, which makes the node; after that,
+// the stand-in is never called again.
+
+static std::mutex lazy_mtx;
+static std::map<Type, std::string> lazy_path;
+
+static Handle lazy_factory(const Handle& h)
+{
+	Type t = h->get_type();
+	std::string path;
+	{
+		std::lock_guard<std::mutex> lock(lazy_mtx);
+		path = lazy_path.at(t);
+	}
+
+	// Never closed; the real factory now lives in there. dlopen() is
+	// reference-counted, so threads racing to get here are harmless.
+	if (nullptr == dlopen(path.c_str(), RTLD_NOW | RTLD_GLOBAL))
+		throw RuntimeException(TRACE_INFO,
+			"Unable to load %s for %s: %s\n", path.c_str(),
+			nameserver().getTypeName(t).c_str(), dlerror());
+
+	ClassServer::AtomFactory* fact = classserver().getFactory(t);
+	if (nullptr == fact or lazy_factory == fact)
+		throw RuntimeException(TRACE_INFO,
+			"Library %s did not define a factory for %s\n", path.c_str(),
+			nameserver().getTypeName(t).c_str());
+
+	return (*fact)(h);
+}
+
+/// Defer loading the library at `path` until a node of one of the
+/// `types` is first made. The types are names, separated by spaces.
+/// If the library is already loaded (for example, by the python
+/// bindings, which link to all of them), its factories are already in
+/// place, and this does nothing. Returns the number of types deferred.
+extern "C" int sensory_lazy_library(const char* path, const char* types)
+{
+	void* lib = dlopen(path, RTLD_NOW | RTLD_NOLOAD);
+	if (lib)
+	{
+		dlclose(lib);
+		return 0;
+	}
+
+	int ntypes = 0;
+	std::istringstream names(types);
+	std::string name;
+	std::lock_guard<std::mutex> lock(lazy_mtx);
+	while (names >> name)
+	{
+		Type t = nameserver().getType(name);
+		if (NOTYPE == t) continue;
+		lazy_path[t] = path;
+		classserver().addFactory(t, lazy_factory);
+		ntypes++;
+	}
+	return ntypes;
+}
@@ -0,0 +1,79 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; conflate-test.scm -- Test the *-conflate-* mode of *-stream-*
+;
+; With conflation on, a file is read as fast as it can be, and the
+; stream gives only the latest line each time: never an old one, and
+; always the last one, in the end. Every line is either taken or
+; superseded.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+(use-modules (srfi srfi-1))
+
+(opencog-test-runner)
+
+(define tname "conflate-test")
+(test-begin tname)
+
+(define src-file "/tmp/conflate-test.txt")
+
+(define nlines 1000)
+(call-with-output-file src-file
+	(lambda (port) (for-each (lambda (i) (format port "~a\n" i)) (iota nlines))))
+
+(define txt (TextFile (string-append "file://" src-file)))
+(cog-set-value! txt (Predicate "*-open-*") (Type 'StringValue))
+
+(define (monitor)
+	(cog-value-ref (cog-value txt (Predicate "*-monitor-*")) 0))
+
+; ----------------------------------------------------------
+
+(cog-set-value! txt (Predicate "*-conflate-*") (BoolValue #t))
+(define samples (cog-value txt (Predicate "*-stream-*")))
+(test-equal "stream-type" 'SampleStream (cog-type samples))
+
+; The line numbers sampled, slowly enough for many to be superseded.
+(define got
+	(let loop ((item (cog-value-ref samples 0)) (acc '()))
+		(if (equal? 'VoidValue (cog-type item))
+			(reverse acc)
+			(begin
+				(usleep 100)
+				(loop (cog-value-ref samples 0)
+					(cons (string->number (string-trim-right (cog-value-ref item 0))) acc))))))
+
+(test-assert "some" (< 0 (length got)))
+(test-assert "increasing" (every < got (cdr got)))
+(test-equal "freshest-last" (- nlines 1) (last got))
+(test-equal "stays-eof" 'VoidValue (cog-type (cog-value-ref samples 0)))
+
+(test-assert "monitor-items"
+	(string-contains (monitor)
+		(format #f "Items: ~a   Taken: ~a   Superseded: ~a"
+			nlines (length got) (- nlines (length got)))))
+
+; ----------------------------------------------------------
+; Off again: every line, in order.
+
+(cog-set-value! txt (Predicate "*-conflate-*") (BoolValue #f))
+(cog-set-value! txt (Predicate "*-close-*") (VoidValue))
+(cog-set-value! txt (Predicate "*-open-*") (Type 'StringValue))
+(test-equal "plain-type" 'StringStream
+	(cog-type (cog-value txt (Predicate "*-stream-*"))))
+
+(test-assert "bad-arg"
+	(catch #t
+		(lambda () (cog-set-value! txt (Predicate "*-conflate-*") (Number 1)) #f)
+		(lambda args #t)))
+
+(cog-set-value! txt (Predicate "*-close-*") (VoidValue))
+(delete-file src-file)
+
+(test-end tname)
+
+(opencog-test-end)
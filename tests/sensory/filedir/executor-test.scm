@@ -0,0 +1,72 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; executor-test.scm -- Test many watchers sharing the background executor
+;
+; Directory watches no longer run a thread each; they share one small
+; pool. Run the pool with a single worker, and check that events on
+; many watched directories are all delivered, and that the watches
+; can be stopped and started again.
+;
+; The pool is started on first use, so this must come first.
+(setenv "SENSORY_EXECUTOR_THREADS" "1")
+
+(use-modules (opencog) (opencog sensory))
+(use-modules (opencog test-runner))
+(use-modules (srfi srfi-1))
+
+(opencog-test-runner)
+
+(define tname "executor")
+(test-begin tname)
+
+(define test-dir "/tmp/executor-test")
+(system (string-append "rm -rf " test-dir))
+(mkdir test-dir)
+
+(define ndirs 8)
+(define dirs
+	(map (lambda (i) (string-append test-dir "/d" (number->string i)))
+		(iota ndirs)))
+(for-each mkdir dirs)
+
+(define (start-watching dir)
+	(define fsn (FileSysNode (string-append "file://" dir)))
+	(cog-set-value! fsn (Predicate "*-open-*") (Type 'StringValue))
+	(cog-set-value! fsn (Predicate "*-write-*") (Node "watch"))
+	fsn)
+
+(define (touch-all name)
+	(for-each
+		(lambda (dir) (system (string-append "touch " dir "/" name)))
+		dirs))
+
+(define (got-event? fsn name)
+	(define ev (Trigger (ValueOf fsn (Predicate "*-read-*"))))
+	(and (equal? 'StringValue (cog-type ev))
+	     (string-contains (cog-value-ref ev 0) name)))
+
+(define nodes (map start-watching dirs))
+(touch-all "first.txt")
+(test-assert "all-watchers-delivered"
+	(every (lambda (fsn) (got-event? fsn "first.txt")) nodes))
+
+; Stop them all, and start over.
+(for-each
+	(lambda (fsn) (cog-set-value! fsn (Predicate "*-close-*") (VoidValue)))
+	nodes)
+(set! nodes (map start-watching dirs))
+(touch-all "second.txt")
+(test-assert "restarted-watchers-delivered"
+	(every (lambda (fsn) (got-event? fsn "second.txt")) nodes))
+
+(for-each
+	(lambda (fsn) (cog-set-value! fsn (Predicate "*-close-*") (VoidValue)))
+	nodes)
+
+(system (string-append "rm -rf " test-dir))
+
+(test-end tname)
+
+(opencog-test-end)
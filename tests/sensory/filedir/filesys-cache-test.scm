@@ -0,0 +1,69 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; filesys-cache-test.scm -- Test the FileSysNode listing cache
+;
+; Tests that cached listings and file sizes are dropped when the
+; directory or the files in it change.
+;
+(use-modules (opencog) (opencog sensory))
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "filesys-cache")
+(test-begin tname)
+
+(define test-dir "/tmp/filesys-cache-test")
+
+(catch #t
+	(lambda () (system (string-append "rm -rf " test-dir)))
+	(lambda (key . args) #f))
+
+(mkdir test-dir)
+(system (string-append "echo 'abc' > " test-dir "/one.txt"))
+
+(define fsnode (FileSysNode (string-append "file://" test-dir)))
+(cog-set-value! fsnode (Predicate "*-open-*") (Type 'StringValue))
+(cog-set-value! fsnode (Predicate "*-cache-*") (BoolValue #t))
+
+(define (run-cmd cmd)
+	(cog-set-value! fsnode (Predicate "*-write-*") (Item cmd))
+	(Trigger (ValueOf fsnode (Predicate "*-read-*"))))
+
+; The results are a LinkValue; the first entry is the command.
+(test-equal "first-ls" 2 (cog-arity (run-cmd "ls")))
+(test-equal "cached-ls" 2 (cog-arity (run-cmd "ls")))
+
+; Adding a file must show up, even though the listing was cached.
+(system (string-append "touch " test-dir "/two.txt"))
+(test-equal "ls-after-create" 3 (cog-arity (run-cmd "ls")))
+
+; Stat results are cached too, and dropped when the file is written.
+(define (size-of-one)
+	(define sizes (run-cmd "filesize"))
+	(define (find-one i)
+		(define ent (cog-value-ref sizes i))
+		(if (string-suffix? "one.txt" (cog-value-ref (cog-value-ref ent 0) 0))
+			(cog-value-ref (cog-value-ref ent 1) 0)
+			(find-one (+ i 1))))
+	(find-one 1))
+
+(test-equal "first-size" 4.0 (size-of-one))
+(system (string-append "echo 'abcdefg' > " test-dir "/one.txt"))
+(test-equal "size-after-write" 8.0 (size-of-one))
+
+; Turning the cache off must still work.
+(cog-set-value! fsnode (Predicate "*-cache-*") (BoolValue #f))
+(test-equal "uncached-ls" 3 (cog-arity (run-cmd "ls")))
+
+(cog-set-value! fsnode (Predicate "*-close-*") (VoidValue))
+
+(catch #t
+	(lambda () (system (string-append "rm -rf " test-dir)))
+	(lambda (key . args) #f))
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,83 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; filesys-fingerprint-test.scm -- Test FileSysNode content fingerprints
+;
+; Tests that identical files get identical fingerprints, that changed
+; files get new ones, that large (multi-chunk) files work, and that an
+; unreadable file does not spoil a directory listing.
+;
+(use-modules (opencog) (opencog sensory))
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "filesys-fingerprint")
+(test-begin tname)
+
+(define test-dir "/tmp/filesys-fingerprint-test")
+
+(catch #t
+	(lambda () (system (string-append "rm -rf " test-dir)))
+	(lambda (key . args) #f))
+
+(mkdir test-dir)
+(system (string-append "echo 'hello' > " test-dir "/a.txt"))
+(system (string-append "echo 'hello' > " test-dir "/b.txt"))
+(system (string-append "echo 'world' > " test-dir "/c.txt"))
+
+; Big enough to be hashed in several chunks.
+(system (string-append
+	"head -c 20000000 /dev/zero > " test-dir "/big.bin && "
+	"cp " test-dir "/big.bin " test-dir "/big2.bin"))
+
+(define fsnode (FileSysNode (string-append "file://" test-dir)))
+(cog-set-value! fsnode (Predicate "*-open-*") (Type 'StringValue))
+
+; Fingerprint of a single file, as a hex string.
+(define (fprint name)
+	(cog-set-value! fsnode (Predicate "*-write-*")
+		(List (Item "fingerprint")
+			(Item (string-append "file://" test-dir "/" name))))
+	(define result (Trigger (ValueOf fsnode (Predicate "*-read-*"))))
+	(cog-value-ref (cog-value-ref result 1) 1))
+
+(test-equal "same-content" (fprint "a.txt") (fprint "b.txt"))
+(test-assert "different-content"
+	(not (equal? (fprint "a.txt") (fprint "c.txt"))))
+(test-equal "large-same-content" (fprint "big.bin") (fprint "big2.bin"))
+(test-equal "hex-digits" 16 (string-length (fprint "big.bin")))
+
+; The remembered fingerprint must not survive a change to the file.
+(define before (fprint "c.txt"))
+(system (string-append "echo 'world, again' > " test-dir "/c.txt"))
+(test-assert "changed-content" (not (equal? before (fprint "c.txt"))))
+
+; All files in the current directory.
+(cog-set-value! fsnode (Predicate "*-write-*") (Item "fingerprint"))
+(test-equal "whole-directory" 6
+	(cog-arity (Trigger (ValueOf fsnode (Predicate "*-read-*")))))
+
+; A file that can't be read is left out, and the rest are still listed.
+; (Unless running as root, which can read it anyway.)
+(system (string-append "echo 'secret' > " test-dir "/locked.txt"))
+(chmod (string-append test-dir "/locked.txt") #o000)
+(cog-set-value! fsnode (Predicate "*-write-*") (Item "fingerprint"))
+(test-equal "unreadable-skipped" (if (zero? (getuid)) 7 6)
+	(cog-arity (Trigger (ValueOf fsnode (Predicate "*-read-*")))))
+
+; A FIFO is refused, rather than waited on forever.
+(system (string-append "mkfifo " test-dir "/pipe"))
+(test-assert "fifo-rejected"
+	(catch #t (lambda () (fprint "pipe") #f) (lambda args #t)))
+
+(cog-set-value! fsnode (Predicate "*-close-*") (VoidValue))
+
+(catch #t
+	(lambda () (system (string-append "rm -rf " test-dir)))
+	(lambda (key . args) #f))
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,67 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; filesys-search-test.scm -- Test FileSysNode content search
+;
+; Tests that literal and regex searches find every matching line in
+; a tree, with correct line numbers, and skip binary files.
+;
+(use-modules (opencog) (opencog sensory))
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "filesys-search")
+(test-begin tname)
+
+(define test-dir "/tmp/filesys-search-test")
+
+(catch #t
+	(lambda () (system (string-append "rm -rf " test-dir)))
+	(lambda (key . args) #f))
+
+(system (string-append "mkdir -p " test-dir "/sub"))
+(system (string-append
+	"printf 'one\\nneedle here\\nthree\\n' > " test-dir "/a.txt && "
+	"printf 'needle\\nx\\ny needle\\n' > " test-dir "/sub/b.txt && "
+	"printf 'needle\\0binary' > " test-dir "/c.bin"))
+
+(define fsnode (FileSysNode (string-append "file://" test-dir)))
+(cog-set-value! fsnode (Predicate "*-open-*") (Type 'StringValue))
+
+; Collect all matches, until the end-of-search marker.
+(define (drain-search matches)
+	(define batch (Trigger (ValueOf fsnode (Predicate "*-read-*"))))
+	(if (= 1 (cog-arity batch))
+		matches
+		(drain-search (append matches (cdr (cog-value->list batch))))))
+
+(define (line-numbers matches)
+	(sort (map (lambda (m) (inexact->exact (cog-value-ref m 1))) matches) <))
+
+(cog-set-value! fsnode (Predicate "*-write-*")
+	(List (Item "search") (Item "needle")))
+(define found (drain-search '()))
+
+(test-equal "literal-count" 3 (length found))
+(test-equal "literal-lines" '(1 2 3) (line-numbers found))
+(test-assert "line-text"
+	(any (lambda (m) (equal? "y needle" (cog-value-ref m 2))) found))
+
+(cog-set-value! fsnode (Predicate "*-write-*")
+	(List (Item "search-regex") (Item "^needle$")
+		(Item (string-append "file://" test-dir "/sub"))))
+(define rfound (drain-search '()))
+(test-equal "regex-count" 1 (length rfound))
+(test-equal "regex-line" 1 (inexact->exact (cog-value-ref (car rfound) 1)))
+
+(cog-set-value! fsnode (Predicate "*-close-*") (VoidValue))
+
+(catch #t
+	(lambda () (system (string-append "rm -rf " test-dir)))
+	(lambda (key . args) #f))
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,77 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; filesys-spill-test.scm -- Test the *-spill-* message
+;
+; Queue up many more results than the memory cap holds, without
+; reading them; check that the rest went to disk, and that all of
+; them come back, in order, when they are read.
+;
+(use-modules (opencog) (opencog sensory))
+(use-modules (opencog test-runner))
+(use-modules (ice-9 ftw))
+
+(opencog-test-runner)
+
+(define tname "filesys-spill")
+(test-begin tname)
+
+(define test-dir "/tmp/filesys-spill-test")
+(define spill-dir "/tmp/filesys-spill-test-spill")
+
+(define (clean-up)
+	(system (string-append "rm -rf " test-dir " " spill-dir)))
+(clean-up)
+
+(mkdir test-dir)
+(mkdir spill-dir)
+(do ((i 0 (+ i 1))) ((= i 50))
+	(system (format #f "touch ~a/file-~a.txt" test-dir i)))
+
+(define fsnode (FileSysNode (string-append "file://" test-dir)))
+(cog-set-value! fsnode (Predicate "*-spill-*")
+	(List (Number 2000) (Item spill-dir)))
+(cog-set-value! fsnode (Predicate "*-open-*") (Type 'StringValue))
+
+(define (monitor)
+	(cog-value-ref (cog-value fsnode (Predicate "*-monitor-*")) 0))
+
+; The results are a LinkValue: the command, then the files. The
+; commands are told apart by name.
+(define nresults 100)
+(do ((i 0 (+ i 1))) ((= i nresults))
+	(cog-set-value! fsnode (Predicate "*-write-*")
+		(Item (if (even? i) "ls" "pwd"))))
+
+(test-assert "monitor-spill" (string-contains (monitor) "Spill queue: cap 2000"))
+(test-assert "spilled" (not (string-contains (monitor) "On disk: 0 items")))
+(test-equal "spill-files" 1
+	(length (filter (lambda (f) (string-prefix? "opencog-spill-" f))
+		(scandir spill-dir))))
+
+(define (read-one) (Trigger (ValueOf fsnode (Predicate "*-read-*"))))
+
+(define in-order
+	(let loop ((i 0) (ok #t))
+		(if (= i nresults) ok
+			(let* ((r (read-one))
+			       (cmd (cog-name (cog-value-ref r 0)))
+			       (want (if (even? i) "ls" "pwd"))
+			       (n (if (even? i) 51 2)))
+				(loop (+ i 1)
+					(and ok (equal? cmd want) (= n (cog-arity r))))))))
+(test-assert "all-back-in-order" in-order)
+(test-assert "disk-drained" (string-contains (monitor) "On disk: 0 items"))
+
+; Zero turns it off, from the next open.
+(cog-set-value! fsnode (Predicate "*-spill-*") (Number 0))
+(cog-set-value! fsnode (Predicate "*-open-*") (Type 'StringValue))
+(test-assert "spill-off" (not (string-contains (monitor) "Spill queue")))
+
+(cog-set-value! fsnode (Predicate "*-close-*") (VoidValue))
+(clean-up)
+
+(test-end tname)
+
+(opencog-test-end)
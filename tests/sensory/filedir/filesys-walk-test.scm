@@ -0,0 +1,68 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; filesys-walk-test.scm -- Test recursive walk for FileSysNode
+;
+; Tests that the `walk` command streams every file below a directory,
+; in batches, ending with a batch that holds only the command, and
+; that symlink loops do not cause infinite recursion.
+;
+(use-modules (opencog) (opencog sensory))
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "filesys-walk")
+(test-begin tname)
+
+(define test-dir "/tmp/filesys-walk-test")
+
+(catch #t
+	(lambda () (system (string-append "rm -rf " test-dir)))
+	(lambda (key . args) #f))
+
+; Build a small tree: 3 levels, 5 files per directory, plus a
+; symlink pointing back up to the top, to make a loop.
+(system (string-append
+	"mkdir -p " test-dir "/a/b/c && "
+	"for d in " test-dir " " test-dir "/a " test-dir "/a/b " test-dir "/a/b/c; "
+	"do for i in 1 2 3 4 5; do touch $d/f$i.txt; done; done && "
+	"ln -s " test-dir " " test-dir "/a/b/loop"))
+
+(define fsnode (FileSysNode (string-append "file://" test-dir)))
+(cog-set-value! fsnode (Predicate "*-open-*") (Type 'StringValue))
+(cog-set-value! fsnode (Predicate "*-write-*") (Item "walk"))
+
+; Drain batches until the end marker (a batch with only the command).
+(define (drain-walk count)
+	(define batch (Trigger (ValueOf fsnode (Predicate "*-read-*"))))
+	(define n (- (cog-arity batch) 1))
+	(if (= 0 n) count (drain-walk (+ count n))))
+
+; 20 files, 3 directories and the symlink itself.
+(test-equal "walk-finds-everything" 24 (drain-walk 0))
+
+; ----------------------------------------------------------
+; Walk of a subdirectory, given as an argument.
+
+(cog-set-value! fsnode (Predicate "*-write-*")
+	(List (Item "walk") (Item (string-append "file://" test-dir "/a/b"))))
+
+(define first-batch (Trigger (ValueOf fsnode (Predicate "*-read-*"))))
+(test-assert "walk-batch-starts-with-command"
+	(equal? 'ListLink (cog-type (cog-value-ref first-batch 0))))
+
+(test-assert "walk-batch-holds-urls"
+	(string-prefix? (string-append "file://" test-dir "/a/b/")
+		(cog-value-ref (cog-value-ref first-batch 1) 0)))
+
+(cog-set-value! fsnode (Predicate "*-close-*") (VoidValue))
+
+(catch #t
+	(lambda () (system (string-append "rm -rf " test-dir)))
+	(lambda (key . args) #f))
+
+(test-end tname)
+
+(opencog-test-end)
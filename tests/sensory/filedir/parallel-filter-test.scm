@@ -0,0 +1,130 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; parallel-filter-test.scm -- Test ParallelFilterLink
+;
+; Applies a rule to each line of a file, on several threads, taking
+; the lines from the node itself, from its *-stream-*, and from a
+; QueueValue. In order, the results must come back exactly as the
+; lines went in; out of order, all of them must come back, once each.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+(use-modules (srfi srfi-1))
+
+(opencog-test-runner)
+
+(define tname "parallel-filter-test")
+(test-begin tname)
+
+(define src-file "/tmp/parallel-filter-test.txt")
+
+(define nlines 200)
+(with-output-to-file src-file
+	(lambda ()
+		(do ((i 0 (+ i 1))) ((= i nlines))
+			(format #t "line ~a\n" i))))
+
+(define (expected)
+	(map (lambda (i) (format #f "line ~a\n" i)) (iota nlines)))
+
+(define txt (TextFile (string-append "file://" src-file)))
+(define (reopen)
+	(cog-set-value! txt (Predicate "*-close-*") (VoidValue))
+	(cog-set-value! txt (Predicate "*-open-*") (Type 'StringValue)))
+
+; Pair each line with itself.
+(define rule
+	(Rule
+		(TypedVariable (Variable "$x") (Type 'StringValue))
+		(Variable "$x")
+		(LinkSignature (Type 'LinkValue) (Variable "$x") (Variable "$x"))))
+
+; Everything in the stream, up to the VoidValue at the end.
+(define (drain pstream)
+	(let loop ((acc '()))
+		(define item (cog-value-ref pstream 0))
+		(if (equal? 'VoidValue (cog-type item))
+			(reverse acc)
+			(loop (cons item acc)))))
+
+(define (first-strings items)
+	(map (lambda (pair) (cog-value-ref (cog-value-ref pair 0) 0)) items))
+
+; ----------------------------------------------------------
+; In input order, reading the node directly.
+
+(reopen)
+(define ordered (cog-execute! (ParallelFilter rule txt (Number 4 8))))
+(test-equal "stream-type" 'ParallelStream (cog-type ordered))
+
+(define results (drain ordered))
+(test-equal "ordered-count" nlines (length results))
+(test-equal "ordered" (expected) (first-strings results))
+(test-assert "paired"
+	(every (lambda (pair)
+		(equal? (cog-value-ref pair 0) (cog-value-ref pair 1))) results))
+
+; Past the end, it stays at the end.
+(test-equal "stays-eof" 'VoidValue (cog-type (cog-value-ref ordered 0)))
+
+; ----------------------------------------------------------
+; In the order finished, reading the *-stream-* of the node.
+
+(reopen)
+(define unordered
+	(cog-execute!
+		(UnorderedFilter rule (ValueOf txt (Predicate "*-stream-*"))
+			(Number 4))))
+
+(define unresults (first-strings (drain unordered)))
+(test-equal "unordered-count" nlines (length unresults))
+(test-equal "unordered-all"
+	(sort (expected) string<?) (sort unresults string<?))
+
+; ----------------------------------------------------------
+; From a QueueValue, as *-stream-* gives for chat and file system
+; nodes: its items are taken off one by one, until it is closed and
+; empty. (A QueueValue made with its contents is closed.)
+
+(define queue-anchor (Anchor "parallel-filter-test"))
+(cog-set-value! queue-anchor (Predicate "queue")
+	(apply QueueValue (map StringValue (expected))))
+(define queued
+	(cog-execute!
+		(ParallelFilter rule (ValueOf queue-anchor (Predicate "queue"))
+			(Number 4))))
+
+(test-equal "queue-all" (expected) (first-strings (drain queued)))
+
+; ----------------------------------------------------------
+; Bad arguments.
+
+; A plain value, not a stream, would give the same item forever.
+(test-assert "not-a-stream"
+	(catch #t
+		(lambda ()
+			(cog-set-value! queue-anchor (Predicate "plain") (StringValue "x"))
+			(cog-execute!
+				(ParallelFilter rule (ValueOf queue-anchor (Predicate "plain"))))
+			#f)
+		(lambda args #t)))
+
+(test-assert "no-workers"
+	(catch #t
+		(lambda () (ParallelFilter rule txt (Number 0)) #f)
+		(lambda args #t)))
+
+(test-assert "window-too-small"
+	(catch #t
+		(lambda () (ParallelFilter rule txt (Number 4 2)) #f)
+		(lambda args #t)))
+
+(cog-set-value! txt (Predicate "*-close-*") (VoidValue))
+(delete-file src-file)
+
+(test-end tname)
+
+(opencog-test-end)
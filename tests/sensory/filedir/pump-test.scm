@@ -0,0 +1,117 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; pump-test.scm -- Test PumpLink and PumpThreadedLink
+;
+; Copies one text file into another, with and without batching, and
+; in a thread of its own; checks that a followed file keeps being
+; pumped until it is closed.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+(use-modules (ice-9 rdelim))
+
+(opencog-test-runner)
+
+(define tname "pump-test")
+(test-begin tname)
+
+(define src-file "/tmp/pump-test-src.txt")
+(define dst-file "/tmp/pump-test-dst.txt")
+
+(define (remove-file f)
+	(catch #t (lambda () (delete-file f)) (lambda args #f)))
+
+(define nlines 200)
+(define (make-source)
+	(remove-file src-file)
+	(with-output-to-file src-file
+		(lambda ()
+			(do ((i 0 (+ i 1))) ((= i nlines))
+				(format #t "line ~a\n" i)))))
+
+(define (file-lines f)
+	(with-input-from-file f
+		(lambda ()
+			(let loop ((acc '()))
+				(define l (read-line))
+				(if (eof-object? l) (reverse acc) (loop (cons l acc)))))))
+
+(define (expected)
+	(map (lambda (i) (format #f "line ~a" i)) (iota nlines)))
+
+; Fresh source and sink nodes, opened, and named.
+(define (setup)
+	(make-source)
+	(remove-file dst-file)
+	(PipeLink (Name "pump src") (TextFile (string-append "file://" src-file)))
+	(PipeLink (Name "pump dst") (TextFile (string-append "file://" dst-file)))
+	(Trigger (SetValue (Name "pump src") (Predicate "*-open-*") (Type 'Item)))
+	(Trigger (SetValue (Name "pump dst") (Predicate "*-open-*") (Type 'Item))))
+
+(define (close-both)
+	(Trigger (SetValue (Name "pump src") (Predicate "*-close-*") (Number 1)))
+	(Trigger (SetValue (Name "pump dst") (Predicate "*-close-*") (Number 1))))
+
+; ----------------------------------------------------------
+; Plain pump: runs to EOF, returns the count.
+
+(setup)
+(define moved (Trigger (Pump (Name "pump src") (Name "pump dst"))))
+(test-equal "pump-count" nlines (inexact->exact (cog-value-ref moved 0)))
+(close-both)
+(test-equal "pump-copy" (expected) (file-lines dst-file))
+
+; ----------------------------------------------------------
+; Batched pump.
+
+(setup)
+(define bmoved
+	(Trigger (Pump (Name "pump src") (Name "pump dst") (Number 16))))
+(test-equal "batch-count" nlines (inexact->exact (cog-value-ref bmoved 0)))
+(close-both)
+(test-equal "batch-copy" (expected) (file-lines dst-file))
+
+; ----------------------------------------------------------
+; Threaded pump, on a followed file: keeps going after EOF, until
+; the source is closed.
+
+(define (wait-for-lines n)
+	(let loop ((tries 0))
+		(if (and (< tries 100)
+				(< (length (file-lines dst-file)) n))
+			(begin (usleep 50000) (loop (+ tries 1)))))
+	(length (file-lines dst-file)))
+
+(make-source)
+(remove-file dst-file)
+(define tsrc (TextFile (string-append "file://" src-file)))
+(define tdst (TextFile (string-append "file://" dst-file)))
+(cog-set-value! tsrc (Predicate "*-follow-*") (BoolValue #t))
+(Trigger (SetValue tsrc (Predicate "*-open-*") (Type 'Item)))
+(Trigger (SetValue tdst (Predicate "*-open-*") (Type 'Item)))
+
+(define tpump (PumpThreaded tsrc tdst (Number 1)))
+(Trigger tpump)
+(test-equal "threaded-copy" nlines (wait-for-lines nlines))
+
+(system (string-append "echo 'one more' >> " src-file))
+(test-equal "threaded-follow" (+ 1 nlines) (wait-for-lines (+ 1 nlines)))
+
+(Trigger (SetValue tsrc (Predicate "*-close-*") (Number 1)))
+(usleep 500000)
+(system (string-append "echo 'too late' >> " src-file))
+(usleep 500000)
+(test-equal "threaded-stops-on-close" (+ 1 nlines)
+	(length (file-lines dst-file)))
+
+(Trigger (SetValue tdst (Predicate "*-close-*") (Number 1)))
+
+(remove-file src-file)
+(remove-file dst-file)
+
+(test-end tname)
+
+(opencog-test-end)
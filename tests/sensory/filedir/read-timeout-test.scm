@@ -0,0 +1,118 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; read-timeout-test.scm -- Test the *-timeout-* message
+;
+; A followed file, at EOF, normally blocks the reader. With a timeout,
+; the read returns a TimeoutValue instead, and the next read still
+; gets the lines appended later. JSON lines of `[]` and `null`, which
+; read as empty LinkValues, are items, and are not taken for timeouts.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+(use-modules (ice-9 threads))
+
+(opencog-test-runner)
+
+(define tname "read-timeout")
+(test-begin tname)
+
+(define test-file "/tmp/read-timeout-test.txt")
+(catch #t (lambda () (delete-file test-file)) (lambda args #f))
+
+(with-output-to-file test-file
+	(lambda () (display "first\n")))
+
+(define txt (TextFile (string-append "file://" test-file)))
+(cog-set-value! txt (Predicate "*-follow-*") (BoolValue #t))
+(cog-set-value! txt (Predicate "*-timeout-*") (Number 200))
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+
+(define (read-one) (Trigger (ValueOf txt (Predicate "*-read-*"))))
+
+(define (timed thunk)
+	(let* ((start (get-internal-real-time))
+	       (v (thunk)))
+		(cons v (/ (- (get-internal-real-time) start)
+		           internal-time-units-per-second 1.0))))
+
+(test-assert "first-line" (string-contains (cog-name (read-one)) "first"))
+
+(define tmo (timed read-one))
+(test-equal "timeout-marker" 'TimeoutValue (cog-type (car tmo)))
+(test-equal "timeout-empty" 0 (length (cog-value->list (car tmo))))
+(test-assert "timeout-bounded" (< 0.15 (cdr tmo) 2.0))
+
+(define mon (cog-value-ref (cog-value txt (Predicate "*-monitor-*")) 0))
+(test-assert "monitor-timeout" (string-contains mon "Read timeout: 200 ms"))
+
+; The stream is still open; appended lines are still read.
+(system (string-append "echo second >> " test-file))
+(define (read-skipping-timeouts)
+	(let loop ((n 0))
+		(define v (read-one))
+		(if (and (< n 20) (equal? 'TimeoutValue (cog-type v)))
+			(loop (+ n 1))
+			v)))
+(test-assert "after-timeout"
+	(string-contains (cog-name (read-skipping-timeouts)) "second"))
+
+; Zero turns the timeout off; the read waits again, until close.
+(cog-set-value! txt (Predicate "*-timeout-*") (Number 0))
+(define waiter (call-with-new-thread read-one))
+(usleep 500000)
+(Trigger (SetValue txt (Predicate "*-close-*") (Number 1)))
+(define closed-read (join-thread waiter (+ (current-time) 10) #f))
+(test-assert "no-timeout-waits-for-close"
+	(and closed-read (equal? 'VoidValue (cog-type closed-read))))
+
+; ----------------------------------------------------------
+; JSON: an empty array, or null, is an item, not a timeout.
+
+(define json-file "/tmp/read-timeout-test.ndjson")
+(define dst-file "/tmp/read-timeout-test.out")
+(with-output-to-file json-file
+	(lambda () (display "[]\nnull\n{\"a\":1}\n")))
+
+(define (empty-link? v)
+	(and (equal? 'LinkValue (cog-type v)) (null? (cog-value->list v))))
+
+(define json (TextFile (string-append "file://" json-file)))
+(cog-set-value! json (Predicate "*-follow-*") (BoolValue #t))
+(cog-set-value! json (Predicate "*-timeout-*") (Number 200))
+(Trigger (SetValue json (Predicate "*-open-*") (Type 'LinkValue)))
+(define (read-json) (Trigger (ValueOf json (Predicate "*-read-*"))))
+
+(test-assert "json-empty-array" (empty-link? (read-json)))
+(test-assert "json-null" (empty-link? (read-json)))
+(test-equal "json-object" 1 (length (cog-value->list (read-json))))
+(test-equal "json-timeout" 'TimeoutValue (cog-type (read-json)))
+
+; A tee of the same file passes the empty items on, and skips timeouts.
+(cog-set-value! json (Predicate "*-close-*") (VoidValue))
+(Trigger (SetValue json (Predicate "*-open-*") (Type 'LinkValue)))
+(cog-set-value! json (Predicate "*-tee-*") (LinkValue (Number 8) (StringValue "block")))
+(define json-tee (cog-value json (Predicate "*-tee-*")))
+(test-assert "tee-empty-array" (empty-link? (cog-value-ref json-tee 0)))
+(test-assert "tee-null" (empty-link? (cog-value-ref json-tee 0)))
+(test-equal "tee-object" 1 (length (cog-value->list (cog-value-ref json-tee 0))))
+(cog-set-value! json (Predicate "*-close-*") (VoidValue))
+
+; A pump counts them, too.
+(define pjson (TextFile (string-append "file://" json-file)))
+(define pdst (TextFile (string-append "file://" dst-file)))
+(Trigger (SetValue pjson (Predicate "*-open-*") (Type 'LinkValue)))
+(Trigger (SetValue pdst (Predicate "*-open-*") (Type 'Item)))
+(test-equal "pump-json" 3
+	(inexact->exact (cog-value-ref (Trigger (Pump pjson pdst)) 0)))
+(Trigger (SetValue pdst (Predicate "*-close-*") (VoidValue)))
+
+(catch #t (lambda () (delete-file test-file)) (lambda args #f))
+(catch #t (lambda () (delete-file json-file)) (lambda args #f))
+(catch #t (lambda () (delete-file dst-file)) (lambda args #f))
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,126 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; select-test.scm -- Test SelectLink and SelectReadLink
+;
+; Follows two files, and waits on both at once. Checks that the wait
+; times out when neither has anything new, that it wakes up for the
+; one that was appended to, and only that one, and that a closed
+; node counts as ready. Also checks that a FileSysNode is ready only
+; when a command's results are waiting.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+(use-modules (ice-9 threads))
+
+(opencog-test-runner)
+
+(define tname "select-test")
+(test-begin tname)
+
+(define file-a "/tmp/select-test-a.txt")
+(define file-b "/tmp/select-test-b.txt")
+
+(define (remove-file f)
+	(catch #t (lambda () (delete-file f)) (lambda args #f)))
+
+(define (follow f)
+	(remove-file f)
+	(with-output-to-file f (lambda () (display "")))
+	(let ((txt (TextFile (string-append "file://" f))))
+		(cog-set-value! txt (Predicate "*-follow-*") (BoolValue #t))
+		(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+		txt))
+
+(define txt-a (follow file-a))
+(define txt-b (follow file-b))
+
+(define (timed thunk)
+	(let* ((start (get-internal-real-time))
+	       (v (thunk)))
+		(cons v (/ (- (get-internal-real-time) start)
+		           internal-time-units-per-second 1.0))))
+
+; ----------------------------------------------------------
+; Nothing new in either file: times out, with an empty LinkValue.
+
+(define tmo (timed (lambda () (Trigger (Select txt-a txt-b (Number 200))))))
+(test-equal "timeout-type" 'LinkValue (cog-type (car tmo)))
+(test-equal "timeout-empty" 0 (length (cog-value->list (car tmo))))
+(test-assert "timeout-bounded" (< 0.15 (cdr tmo) 2.0))
+
+; ----------------------------------------------------------
+; Append to the second file, while waiting; only it is ready.
+
+(define waiter (call-with-new-thread
+	(lambda () (Trigger (Select txt-a txt-b (Number 5000))))))
+(usleep 300000)
+(system (string-append "echo hello b >> " file-b))
+
+(define woke (join-thread waiter (+ (current-time) 10) #f))
+(test-assert "wakes-up" woke)
+(test-equal "only-b" (list txt-b) (cog-value->list woke))
+
+; Still ready, since no one has read it yet.
+(test-equal "still-b" (list txt-b)
+	(cog-value->list (Trigger (Select txt-a txt-b (Number 0)))))
+
+; ----------------------------------------------------------
+; SelectRead reads from it, too.
+
+(define got (Trigger (SelectRead txt-a txt-b (Number 1000))))
+(test-equal "read-ready" (list txt-b)
+	(cog-value->list (cog-value-ref got 0)))
+(test-assert "read-item" (string-contains (cog-name (cog-value-ref got 1)) "hello b"))
+
+; Read out; neither is ready.
+(test-equal "drained" 0
+	(length (cog-value->list (Trigger (Select txt-a txt-b (Number 100))))))
+
+; ----------------------------------------------------------
+; Both appended to: both ready, in the order given.
+
+(system (string-append "echo more a >> " file-a))
+(system (string-append "echo more b >> " file-b))
+(usleep 100000)
+(test-equal "both" (list txt-a txt-b)
+	(cog-value->list (Trigger (Select txt-a txt-b (Number 1000)))))
+
+; ----------------------------------------------------------
+; A FileSysNode is ready once a command has queued its results.
+
+(define fsn (FileSysNode "file:///tmp"))
+(Trigger (SetValue fsn (Predicate "*-open-*") (Type 'StringValue)))
+(test-equal "filesys-idle" 0
+	(length (cog-value->list (Trigger (Select fsn (Number 100))))))
+
+(define fs-waiter (call-with-new-thread
+	(lambda () (Trigger (Select fsn (Number 5000))))))
+(usleep 200000)
+(cog-set-value! fsn (Predicate "*-write-*") (Item "pwd"))
+(test-equal "filesys-wakes" (list fsn)
+	(cog-value->list (join-thread fs-waiter (+ (current-time) 10) #f)))
+(Trigger (ValueOf fsn (Predicate "*-read-*")))
+
+; With nothing queued, a read with a timeout gives up.
+(cog-set-value! fsn (Predicate "*-timeout-*") (Number 100))
+(test-equal "filesys-timeout" 'TimeoutValue
+	(cog-type (Trigger (ValueOf fsn (Predicate "*-read-*")))))
+(Trigger (SetValue fsn (Predicate "*-close-*") (VoidValue)))
+
+; ----------------------------------------------------------
+; A closed node is ready: reading it gives end-of-file.
+
+(Trigger (SetValue txt-a (Predicate "*-close-*") (Number 1)))
+(Trigger (SetValue txt-b (Predicate "*-close-*") (Number 1)))
+(test-equal "closed-ready" (list txt-a txt-b)
+	(cog-value->list (Trigger (Select txt-a txt-b (Number 100)))))
+
+(remove-file file-a)
+(remove-file file-b)
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,115 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; tee-stream-test.scm -- Test the *-tee-* readers of a StreamNode
+;
+; Several readers of one file, each of which must get every line.
+; With the "block" policy, none may miss any, however far apart they
+; read; with "drop", a reader that falls behind gets only the lines
+; still in the ring.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+(use-modules (srfi srfi-1))
+(use-modules (ice-9 threads))
+
+(opencog-test-runner)
+
+(define tname "tee-stream-test")
+(test-begin tname)
+
+(define src-file "/tmp/tee-stream-test.txt")
+
+(define nlines 100)
+(with-output-to-file src-file
+	(lambda ()
+		(do ((i 0 (+ i 1))) ((= i nlines))
+			(format #t "line ~a\n" i))))
+
+(define (expected from)
+	(map (lambda (i) (format #f "line ~a\n" i)) (iota (- nlines from) from)))
+
+(define txt (TextFile (string-append "file://" src-file)))
+(define (reopen)
+	(cog-set-value! txt (Predicate "*-close-*") (VoidValue))
+	(cog-set-value! txt (Predicate "*-open-*") (Type 'StringValue)))
+
+(define (tee) (cog-value txt (Predicate "*-tee-*")))
+
+; The next line, or #f at the end.
+(define (next-line stream)
+	(define item (cog-value-ref stream 0))
+	(if (equal? 'VoidValue (cog-type item))
+		#f
+		(cog-value-ref item 0)))
+
+; All of the lines, pausing for `pause` microseconds after each.
+(define* (drain stream #:optional (pause 0))
+	(let loop ((acc '()))
+		(define line (next-line stream))
+		(when (< 0 pause) (usleep pause))
+		(if line (loop (cons line acc)) (reverse acc))))
+
+; ----------------------------------------------------------
+; Blocking, with a ring much smaller than the file. The two readers
+; are in threads of their own; whichever gets ahead waits for the
+; other, and neither loses any lines.
+
+(reopen)
+(cog-set-value! txt (Predicate "*-tee-*") (LinkValue (Number 4) (StringValue "block")))
+(define fast (tee))
+(define slow (tee))
+(test-equal "stream-type" 'TeeStream (cog-type fast))
+
+(define slow-thread
+	(call-with-new-thread
+		(lambda () (drain slow 200))))
+(define fast-lines (drain fast))
+(define slow-lines (join-thread slow-thread))
+
+(test-equal "fast-all" (expected 0) fast-lines)
+(test-equal "slow-all" (expected 0) slow-lines)
+
+; Past the end, it stays at the end.
+(test-equal "stays-eof" 'VoidValue (cog-type (cog-value-ref fast 0)))
+
+; ----------------------------------------------------------
+; Dropping. The first reader takes everything it can; the second,
+; which has not read at all, then finds just the last few lines.
+
+(reopen)
+(cog-set-value! txt (Predicate "*-tee-*") (LinkValue (Number 8) (StringValue "drop")))
+(define eager (tee))
+(define lazy (tee))
+
+(define eager-lines (drain eager))
+(test-assert "eager-some" (< 0 (length eager-lines)))
+(test-equal "eager-last" (format #f "line ~a\n" (- nlines 1)) (last eager-lines))
+(test-equal "lazy-tail" (expected (- nlines 8)) (drain lazy))
+
+(test-assert "monitor"
+	(string-contains
+		(cog-value-ref (cog-value txt (Predicate "*-monitor-*")) 0)
+		"Tee ring: 8 items, drop"))
+
+; ----------------------------------------------------------
+; Bad arguments.
+
+(test-assert "bad-policy"
+	(catch #t
+		(lambda () (cog-set-value! txt (Predicate "*-tee-*") (StringValue "spill")) #f)
+		(lambda args #t)))
+
+(test-assert "bad-size"
+	(catch #t
+		(lambda () (cog-set-value! txt (Predicate "*-tee-*") (Number 0)) #f)
+		(lambda args #t)))
+
+(cog-set-value! txt (Predicate "*-close-*") (VoidValue))
+(delete-file src-file)
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,110 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; textfile-checkpoint-test.scm -- Test resumable reads for TextFileNode
+;
+; Tests that the read offset is checkpointed on close, that a reopen
+; resumes from it, and that a truncated or rotated file is read from
+; the start. Also tests that following survives a logrotate-style
+; rename, and a delete-and-recreate.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+
+(opencog-test-runner)
+
+(define tname "textfile-checkpoint")
+(test-begin tname)
+
+(define test-file "/tmp/textfile-checkpoint-test.txt")
+(define ckpt-file (string-append test-file ".offset"))
+
+(define (cleanup)
+	(for-each
+		(lambda (f) (catch #t (lambda () (delete-file f)) (lambda args #f)))
+		(list test-file ckpt-file (string-append test-file ".1"))))
+(cleanup)
+
+(define (write-lines . lines)
+	(with-output-to-file test-file
+		(lambda () (for-each (lambda (l) (display l) (newline)) lines))))
+
+(write-lines "Line 1" "Line 2" "Line 3")
+
+(define txt (TextFile (string-append "file://" test-file)))
+(define (read-line-node)
+	(Trigger (ValueOf txt (Predicate "*-read-*"))))
+
+(cog-set-value! txt (Predicate "*-checkpoint-*") (BoolValue #t))
+
+; ----------------------------------------------------------
+; Read two lines, close, reopen: the third line is next.
+
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+(read-line-node)
+(read-line-node)
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+(test-assert "checkpoint-written" (file-exists? ckpt-file))
+
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+(test-assert "resume-at-offset"
+	(string-contains (cog-name (read-line-node)) "Line 3"))
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+; ----------------------------------------------------------
+; Rewrite the file in place; the checkpoint no longer applies.
+
+(write-lines "New 1" "New 2" "New 3" "New 4")
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+(test-assert "truncated-restart"
+	(string-contains (cog-name (read-line-node)) "New 1"))
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+; ----------------------------------------------------------
+; Follow across a rename: drain the old file, then the new one.
+
+(cog-set-value! txt (Predicate "*-checkpoint-*") (BoolValue #f))
+(write-lines "Old 1")
+(cog-set-value! txt (Predicate "*-follow-*") (BoolValue #t))
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+(test-assert "follow-old"
+	(string-contains (cog-name (read-line-node)) "Old 1"))
+
+(system (string-append
+	"sleep 1 && echo 'Old 2' >> " test-file " && "
+	"mv " test-file " " test-file ".1 && "
+	"sleep 1 && echo 'Rotated 1' > " test-file " &"))
+
+(test-assert "follow-old-after-rename"
+	(string-contains (cog-name (read-line-node)) "Old 2"))
+(test-assert "follow-new-file"
+	(string-contains (cog-name (read-line-node)) "Rotated 1"))
+
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+; ----------------------------------------------------------
+; Follow across a delete-and-recreate. The node still holds the old
+; file open, so it is not freed, and there is no IN_DELETE_SELF.
+
+(write-lines "Gone 1")
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+(test-assert "follow-before-delete"
+	(string-contains (cog-name (read-line-node)) "Gone 1"))
+
+(system (string-append
+	"sleep 1 && rm " test-file " && "
+	"sleep 1 && echo 'Recreated 1' > " test-file " &"))
+
+(test-assert "follow-recreated-file"
+	(string-contains (cog-name (read-line-node)) "Recreated 1"))
+
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+(cleanup)
+
+(test-end tname)
+
+(opencog-test-end)
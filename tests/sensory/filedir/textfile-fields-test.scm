@@ -0,0 +1,76 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; textfile-fields-test.scm -- Test splitting lines into fields
+;
+; Tests CSV splitting with quoting, TSV splitting, and numeric mode.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+
+(opencog-test-runner)
+
+(define tname "textfile-fields")
+(test-begin tname)
+
+(define test-file "/tmp/textfile-fields-test.csv")
+(catch #t (lambda () (delete-file test-file)) (lambda args #f))
+
+(with-output-to-file test-file
+	(lambda ()
+		(display "name,comment,score\n")
+		(display "alice,\"likes, commas\",3.5\r\n")
+		(display "bob,\"says \"\"hi\"\"\",-2\n")
+		(display "carol,,\n")))
+
+(define txt (TextFile (string-append "file://" test-file)))
+(define (read-rec)
+	(Trigger (ValueOf txt (Predicate "*-read-*"))))
+
+(cog-set-value! txt (Predicate "*-fields-*") (StringValue ","))
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'StringValue)))
+
+(test-equal "header" (list "name" "comment" "score")
+	(cog-value->list (read-rec)))
+(test-equal "quoted-delim" (list "alice" "likes, commas" "3.5")
+	(cog-value->list (read-rec)))
+(test-equal "doubled-quote" (list "bob" "says \"hi\"" "-2")
+	(cog-value->list (read-rec)))
+(test-equal "empty-fields" (list "carol" "" "")
+	(cog-value->list (read-rec)))
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+; Numeric mode; text fields become NaN.
+(cog-set-value! txt (Predicate "*-fields-*")
+	(LinkValue (StringValue ",") (StringValue "numeric")))
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'StringValue)))
+(read-rec)
+(define nums (read-rec))
+(test-equal "numeric-type" 'FloatValue (cog-type nums))
+(test-assert "numeric-nan" (nan? (cog-value-ref nums 0)))
+(test-equal "numeric-value" 3.5 (cog-value-ref nums 2))
+(test-equal "numeric-neg" -2.0 (cog-value-ref (read-rec) 2))
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+; Tab-separated, without quoting.
+(with-output-to-file test-file
+	(lambda () (display "x\t\"y\"\tz\n")))
+(cog-set-value! txt (Predicate "*-fields-*")
+	(List (Item "\t") (Item "noquote")))
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'StringValue)))
+(test-equal "tsv" (list "x" "\"y\"" "z") (cog-value->list (read-rec)))
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+; Off again.
+(cog-set-value! txt (Predicate "*-fields-*") (VoidValue))
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'StringValue)))
+(test-equal "no-fields" 1 (length (cog-value->list (read-rec))))
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+(delete-file test-file)
+
+(test-end tname)
+
+(opencog-test-end)
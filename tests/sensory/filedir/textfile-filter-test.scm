@@ -0,0 +1,75 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; textfile-filter-test.scm -- Test line filtering in a TextFileNode
+;
+; Tests substring, prefix and regex filters, that the monitor reports
+; hit and miss counts, and that the filter can be removed.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+
+(opencog-test-runner)
+
+(define tname "textfile-filter")
+(test-begin tname)
+
+(define test-file "/tmp/textfile-filter-test.txt")
+(catch #t (lambda () (delete-file test-file)) (lambda args #f))
+
+(with-output-to-file test-file
+	(lambda ()
+		(display "INFO starting up\n")
+		(display "ERROR disk full\n")
+		(display "INFO retrying\n")
+		(display "WARN disk nearly full\n")
+		(display "ERROR giving up\n")))
+
+(define txt (TextFile (string-append "file://" test-file)))
+
+(define (read-all)
+	(let loop ((acc '()))
+		(define v (Trigger (ValueOf txt (Predicate "*-read-*"))))
+		(if (cog-atom? v)
+			(loop (cons (cog-name v) acc))
+			(reverse acc))))
+
+(define (open-with filt)
+	(cog-set-value! txt (Predicate "*-filter-*") filt)
+	(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item))))
+
+(open-with (StringValue "disk"))
+(test-equal "substring"
+	(list "ERROR disk full\n" "WARN disk nearly full\n") (read-all))
+
+(define mon (cog-value-ref
+	(cog-value txt (Predicate "*-monitor-*")) 0))
+(test-assert "monitor-hits" (string-contains mon "Filter hits: 2"))
+(test-assert "monitor-misses" (string-contains mon "Filter misses: 3"))
+
+(open-with (LinkValue (StringValue "prefix") (StringValue "ERROR")))
+(test-equal "prefix"
+	(list "ERROR disk full\n" "ERROR giving up\n") (read-all))
+
+(open-with (List (Item "regex") (Item "^(WARN|INFO) .*ing")))
+(test-equal "regex"
+	(list "INFO starting up\n" "INFO retrying\n") (read-all))
+
+(open-with (VoidValue))
+(test-equal "no-filter" 5 (length (read-all)))
+
+(test-assert "bad-regex"
+	(catch #t
+		(lambda ()
+			(cog-set-value! txt (Predicate "*-filter-*")
+				(LinkValue (StringValue "regex") (StringValue "(")))
+			#f)
+		(lambda args #t)))
+
+(delete-file test-file)
+
+(test-end tname)
+
+(opencog-test-end)
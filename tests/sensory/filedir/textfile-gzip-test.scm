@@ -0,0 +1,79 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; textfile-gzip-test.scm -- Test reading and writing gzip'ed files
+;
+; Writes lines to a new .gz file, and appends more in a second
+; session, then reads them all back. Also checks that the file is
+; readable by gzip itself.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+(use-modules (ice-9 popen) (ice-9 rdelim))
+
+(opencog-test-runner)
+
+(define tname "textfile-gzip")
+(test-begin tname)
+
+(define test-file "/tmp/textfile-gzip-test.txt.gz")
+(catch #t (lambda () (delete-file test-file)) (lambda args #f))
+
+(define txt (TextFile (string-append "file://" test-file)))
+
+(define (write-lines from to)
+	(Trigger (SetValue txt (Predicate "*-open-*") (Type 'StringValue)))
+	(for-each
+		(lambda (i)
+			(Trigger (SetValue txt (Predicate "*-write-*")
+				(Item (format #f "line ~A\n" i)))))
+		(iota (- to from) from))
+	(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue))))
+
+; Two sessions; each one appends a gzip member.
+(write-lines 1 101)
+(write-lines 101 201)
+
+; Magic number check: the file really is compressed.
+(define port (open-input-file test-file #:binary #t))
+(test-equal "gzip-magic" 31 (char->integer (read-char port)))
+(test-equal "gzip-magic-2" 139 (char->integer (read-char port)))
+(close-port port)
+
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'StringValue)))
+(define (read-all)
+	(let loop ((acc '()))
+		(define v (Trigger (ValueOf txt (Predicate "*-read-*"))))
+		(if (equal? 'StringValue (cog-type v))
+			(loop (cons (cog-value-ref v 0) acc))
+			(reverse acc))))
+(define got (read-all))
+
+(test-equal "line-count" 200 (length got))
+(test-equal "first-line" "line 1\n" (car got))
+(test-equal "second-session" "line 101\n" (list-ref got 100))
+(test-equal "last-line" "line 200\n" (list-ref got 199))
+
+; Seeking in a compressed file is not possible.
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'StringValue)))
+(test-assert "no-seek"
+	(catch #t
+		(lambda ()
+			(Trigger (SetValue txt (Predicate "*-seek-*") (Number 5)))
+			#f)
+		(lambda args #t)))
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+; Readable by gzip, if it is installed.
+(define pipe (open-input-pipe (string-append "gzip -dc " test-file " 2>/dev/null")))
+(define first (read-line pipe))
+(close-pipe pipe)
+(test-assert "gzip-readable" (or (eof-object? first) (equal? "line 1" first)))
+
+(delete-file test-file)
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,68 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; textfile-json-test.scm -- Test reading JSON lines with a TextFileNode
+;
+; Opening with (Type 'LinkValue) parses each line as JSON.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+(use-modules (srfi srfi-1))
+
+(opencog-test-runner)
+
+(define tname "textfile-json")
+(test-begin tname)
+
+(define test-file "/tmp/textfile-json-test.ndjson")
+(catch #t (lambda () (delete-file test-file)) (lambda args #f))
+
+(with-output-to-file test-file
+	(lambda ()
+		(display "{\"level\":\"warn\",\"code\":42,\"ok\":false}\n")
+		(display "\n")
+		(display "{\"msg\":\"caf\\u00e9 \\\"x\\\"\",\"vec\":[1,2.5,-3],\"tags\":[\"a\",1]}\n")
+		(display "[{\"nested\":{\"deep\":null}}]\n")
+		(display "{\"broken\":\n")))
+
+(define txt (TextFile (string-append "file://" test-file)))
+(define (read-rec)
+	(Trigger (ValueOf txt (Predicate "*-read-*"))))
+
+; Look up a key in the LinkValue of (key value) pairs.
+(define (json-ref obj key)
+	(define pair (find
+		(lambda (kv) (equal? key (cog-value-ref (cog-value-ref kv 0) 0)))
+		(cog-value->list obj)))
+	(and pair (cog-value-ref pair 1)))
+
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'LinkValue)))
+
+(define r1 (read-rec))
+(test-equal "object-type" 'LinkValue (cog-type r1))
+(test-equal "object-size" 3 (length (cog-value->list r1)))
+(test-equal "string" "warn" (cog-value-ref (json-ref r1 "level") 0))
+(test-equal "number" 42.0 (cog-value-ref (json-ref r1 "code") 0))
+(test-equal "bool" 'BoolValue (cog-type (json-ref r1 "ok")))
+
+; The blank line is skipped.
+(define r2 (read-rec))
+(test-equal "escapes" "café \"x\"" (cog-value-ref (json-ref r2 "msg") 0))
+(test-equal "numeric-array" 'FloatValue (cog-type (json-ref r2 "vec")))
+(test-equal "numeric-array-val" -3.0 (cog-value-ref (json-ref r2 "vec") 2))
+(test-equal "mixed-array" 'LinkValue (cog-type (json-ref r2 "tags")))
+
+(define r3 (read-rec))
+(test-equal "top-array" 1 (length (cog-value->list r3)))
+
+(test-assert "bad-json"
+	(catch #t (lambda () (read-rec) #f) (lambda args #t)))
+
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+(delete-file test-file)
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,94 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; textfile-normalize-test.scm -- Test line normalization in a TextFileNode
+;
+; Tests trimming of LF and CRLF, that a trimmed empty line is not
+; taken to be EOF, and UTF-8 validation and repair.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+(use-modules (rnrs bytevectors) (rnrs io ports))
+
+(opencog-test-runner)
+
+(define tname "textfile-normalize")
+(test-begin tname)
+
+(define test-file "/tmp/textfile-normalize-test.txt")
+(catch #t (lambda () (delete-file test-file)) (lambda args #f))
+
+; Written as raw bytes, so that the bad UTF-8 gets through untouched.
+(call-with-output-file test-file
+	(lambda (port)
+		(put-bytevector port (u8-list->bytevector (append
+			(map char->integer (string->list "unix line\n"))
+			(map char->integer (string->list "dos line\r\n"))
+			(list 10)
+			(list #x63 #x61 #x66 #xC3 #xA9 10)
+			(list #x62 #x61 #x64 #xFF #x21 10)
+			(map char->integer (string->list "last\n"))))))
+	#:binary #t)
+
+(define txt (TextFile (string-append "file://" test-file)))
+
+(define (read-all)
+	(let loop ((acc '()))
+		(define v (Trigger (ValueOf txt (Predicate "*-read-*"))))
+		(if (cog-atom? v)
+			(loop (cons (cog-name v) acc))
+			(reverse acc))))
+
+(define (open-with norm)
+	(cog-set-value! txt (Predicate "*-normalize-*") norm)
+	(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item))))
+
+; Trim only. The empty line comes through as an empty string.
+(open-with (StringValue "trim"))
+(define lines (read-all))
+(test-equal "trim-count" 6 (length lines))
+(test-equal "trim-lf" "unix line" (list-ref lines 0))
+(test-equal "trim-crlf" "dos line" (list-ref lines 1))
+(test-equal "empty-not-eof" "" (list-ref lines 2))
+(test-equal "trim-last" "last" (list-ref lines 5))
+
+; Validate drops the bad line.
+(open-with (StringValue "trim" "validate"))
+(set! lines (read-all))
+(test-equal "validate-count" 5 (length lines))
+(test-equal "validate-utf8" "café" (list-ref lines 3))
+(test-equal "validate-next" "last" (list-ref lines 4))
+
+(define mon (cog-value-ref
+	(cog-value txt (Predicate "*-monitor-*")) 0))
+(test-assert "monitor-dropped" (string-contains mon "Normalize dropped: 1"))
+
+; Repair substitutes U+FFFD for the bad byte.
+(open-with (BoolValue #t))
+(set! lines (read-all))
+(test-equal "repair-count" 6 (length lines))
+(test-equal "repair" "bad\xfffd;!" (list-ref lines 4))
+
+(set! mon (cog-value-ref
+	(cog-value txt (Predicate "*-monitor-*")) 0))
+(test-assert "monitor-repaired" (string-contains mon "Normalize repaired: 1"))
+
+; Off again: newlines are back.
+(open-with (VoidValue))
+(test-equal "no-normalize" "unix line\n" (car (read-all)))
+
+(test-assert "bad-option"
+	(catch #t
+		(lambda ()
+			(cog-set-value! txt (Predicate "*-normalize-*")
+				(StringValue "squash"))
+			#f)
+		(lambda args #t)))
+
+(delete-file test-file)
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,73 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; textfile-parallel-test.scm -- Test parallel reading of a TextFileNode
+;
+; Tests that reading with several threads returns every line exactly
+; once, in file order when asked for, and that sequential reading
+; carries on afterwards.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+(use-modules (srfi srfi-1))
+
+(opencog-test-runner)
+
+(define tname "textfile-parallel")
+(test-begin tname)
+
+(define test-file "/tmp/textfile-parallel-test.txt")
+(define nlines 300000)
+
+(define (cleanup)
+	(catch #t (lambda () (delete-file test-file)) (lambda args #f)))
+(cleanup)
+
+; A few megabytes, so that there is more than one chunk.
+(with-output-to-file test-file
+	(lambda ()
+		(for-each
+			(lambda (i) (format #t "line ~A\n" i))
+			(iota nlines 1))))
+
+(define txt (TextFile (string-append "file://" test-file)))
+
+(define (read-all)
+	(let loop ((acc '()))
+		(define v (Trigger (ValueOf txt (Predicate "*-read-*"))))
+		(if (cog-atom? v)
+			(loop (cons (cog-name v) acc))
+			(reverse acc))))
+
+(define expected
+	(map (lambda (i) (format #f "line ~A\n" i)) (iota nlines 1)))
+
+; Ordered: same as reading one line at a time.
+(cog-set-value! txt (Predicate "*-parallel-*") (Number 4))
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+(test-assert "ordered" (equal? expected (read-all)))
+
+; Unordered: the same lines, perhaps in another order.
+(cog-set-value! txt (Predicate "*-parallel-*")
+	(LinkValue (FloatValue 4) (StringValue "unordered")))
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+(define got (read-all))
+(test-equal "unordered-count" nlines (length got))
+(test-assert "unordered-lines" (equal? expected (sort got
+	(lambda (a b)
+		(< (string->number (cadr (string-split (string-trim-right a) #\space)))
+			(string->number (cadr (string-split (string-trim-right b) #\space))))))))
+
+; Seeking first; the threads start from there.
+(cog-set-value! txt (Predicate "*-parallel-*") (Number 3))
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+(Trigger (SetValue txt (Predicate "*-seek-*") (Number 250001)))
+(test-assert "after-seek" (equal? (drop expected 250000) (read-all)))
+
+(cleanup)
+
+(test-end tname)
+
+(opencog-test-end)
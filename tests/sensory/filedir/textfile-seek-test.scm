@@ -0,0 +1,70 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; textfile-seek-test.scm -- Test seeking in a TextFileNode
+;
+; Tests seeking by line number and by byte offset, and that the
+; line index is saved to, and picked up from, a sidecar file.
+;
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+(use-modules (opencog sensory))
+
+(opencog-test-runner)
+
+(define tname "textfile-seek")
+(test-begin tname)
+
+(define test-file "/tmp/textfile-seek-test.txt")
+(define index-file "/tmp/textfile-seek-test.idx")
+
+(define (cleanup)
+	(for-each
+		(lambda (f) (catch #t (lambda () (delete-file f)) (lambda args #f)))
+		(list test-file index-file)))
+(cleanup)
+
+; Enough lines to need more than one index entry.
+(with-output-to-file test-file
+	(lambda ()
+		(for-each
+			(lambda (i) (format #t "line ~A\n" i))
+			(iota 5000 1))))
+
+(define txt (TextFile (string-append "file://" test-file)))
+(define (read-text)
+	(cog-name (Trigger (ValueOf txt (Predicate "*-read-*")))))
+(define (seek-to pos)
+	(Trigger (SetValue txt (Predicate "*-seek-*") pos)))
+
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+(cog-set-value! txt (Predicate "*-index-*") (StringValue index-file))
+
+(seek-to (Number 4321))
+(test-equal "seek-line" "line 4321\n" (read-text))
+(test-assert "index-saved" (file-exists? index-file))
+
+(seek-to (List (Item "line") (Number 1)))
+(test-equal "seek-first-line" "line 1\n" (read-text))
+
+(seek-to (Number 2049))
+(test-equal "seek-stride-boundary" "line 2049\n" (read-text))
+
+; "line 1\n" is 7 bytes; byte 7 is the start of the second line.
+(seek-to (List (Item "byte") (Number 7)))
+(test-equal "seek-byte" "line 2\n" (read-text))
+
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+; Reopen; the saved index should be good.
+(Trigger (SetValue txt (Predicate "*-open-*") (Type 'Item)))
+(seek-to (Number 5000))
+(test-equal "seek-with-saved-index" "line 5000\n" (read-text))
+(Trigger (SetValue txt (Predicate "*-close-*") (VoidValue)))
+
+(cleanup)
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,106 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; textfile-wal-test.scm -- Test the write-ahead log of items read
+;
+; Read some lines with a log, acknowledge a few, then drop the log and
+; pick it up again, as a restarted process would. A replay should hand
+; back exactly the lines after the last one acknowledged.
+;
+(use-modules (opencog) (opencog sensory))
+(use-modules (opencog test-runner))
+(use-modules (ice-9 ftw))
+
+(opencog-test-runner)
+
+(define tname "textfile-wal")
+(test-begin tname)
+
+(define test-file "/tmp/textfile-wal-test.txt")
+(define wal-dir "/tmp/textfile-wal-test-log")
+(define fs-wal-dir "/tmp/textfile-wal-test-fslog")
+
+(define (clean-up)
+	(system (string-append "rm -rf " test-file " " wal-dir " " fs-wal-dir)))
+(clean-up)
+
+(with-output-to-file test-file
+	(lambda ()
+		(for-each (lambda (i) (format #t "Line ~a\n" i)) '(0 1 2 3 4))))
+
+(define txt (TextFile (string-append "file://" test-file)))
+(define (read-one) (Trigger (ValueOf txt (Predicate "*-read-*"))))
+(define (offsets)
+	(cog-value->list (cog-value txt (Predicate "*-offset-*"))))
+
+(cog-set-value! txt (Predicate "*-wal-*") (StringValue wal-dir))
+(cog-set-value! txt (Predicate "*-open-*") (Type 'StringValue))
+
+(define first-read (map (lambda (i) (cog-value-ref (read-one) 0)) '(0 1 2 3 4)))
+(test-equal "read-all" "Line 4\n" (list-ref first-read 4))
+(test-equal "offsets" '(4.0 -1.0 5.0) (offsets))
+
+; Offsets 0 and 1 are dealt with.
+(cog-set-value! txt (Predicate "*-ack-*") (Number 1))
+(test-equal "acked" '(4.0 1.0 5.0) (offsets))
+(test-assert "segment-file"
+	(any (lambda (f) (string-suffix? ".wal" f)) (scandir wal-dir)))
+(test-assert "monitor" (string-contains
+	(cog-value-ref (cog-value txt (Predicate "*-monitor-*")) 0)
+	"Write-ahead log"))
+
+(cog-set-value! txt (Predicate "*-close-*") (VoidValue))
+
+; As if restarted: the log is opened afresh, from the directory.
+(cog-set-value! txt (Predicate "*-wal-*") (VoidValue))
+(test-equal "no-log" 'VoidValue
+	(cog-type (cog-value txt (Predicate "*-offset-*"))))
+(cog-set-value! txt (Predicate "*-wal-*") (StringValue wal-dir))
+(test-equal "recovered" '(-1.0 1.0 5.0) (offsets))
+
+(cog-set-value! txt (Predicate "*-open-*") (Type 'StringValue))
+(cog-set-value! txt (Predicate "*-replay-*") (VoidValue))
+(define replayed (map (lambda (i) (cog-value-ref (read-one) 0)) '(2 3 4)))
+(test-equal "replayed" '("Line 2\n" "Line 3\n" "Line 4\n") replayed)
+(test-equal "replay-offsets" '(4.0 1.0 5.0) (offsets))
+
+; After the replay, reads come from the file again, and are logged
+; after what was there.
+(test-equal "fresh" "Line 0\n" (cog-value-ref (read-one) 0))
+(test-equal "fresh-offset" '(5.0 1.0 6.0) (offsets))
+
+; The last one read can be acknowledged without naming it.
+(cog-set-value! txt (Predicate "*-ack-*") (VoidValue))
+(test-equal "ack-last" '(5.0 5.0 6.0) (offsets))
+
+(cog-set-value! txt (Predicate "*-close-*") (VoidValue))
+(cog-set-value! txt (Predicate "*-wal-*") (VoidValue))
+
+; ----------------------------------------------------------
+; FileSysNode results are logged as they are queued, and replayed.
+
+(define fsn (FileSysNode "file:///tmp"))
+(define (fs-pwd)
+	(cog-set-value! fsn (Predicate "*-write-*") (Item "pwd"))
+	(Trigger (ValueOf fsn (Predicate "*-read-*"))))
+(define (fs-dir v) (cog-value-ref (cog-value-ref v 1) 0))
+
+(cog-set-value! fsn (Predicate "*-wal-*") (StringValue fs-wal-dir))
+(cog-set-value! fsn (Predicate "*-open-*") (Type 'StringValue))
+(define pwd-1 (fs-pwd))
+(fs-pwd)
+(test-equal "fs-offsets" '(1.0 -1.0 2.0)
+	(cog-value->list (cog-value fsn (Predicate "*-offset-*"))))
+
+(cog-set-value! fsn (Predicate "*-replay-*") (Number 0))
+(test-equal "fs-replayed" (fs-dir pwd-1)
+	(fs-dir (Trigger (ValueOf fsn (Predicate "*-read-*")))))
+
+(cog-set-value! fsn (Predicate "*-close-*") (VoidValue))
+(cog-set-value! fsn (Predicate "*-wal-*") (VoidValue))
+(clean-up)
+
+(test-end tname)
+
+(opencog-test-end)
@@ -0,0 +1,123 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; capture-replay-test.scm -- Test *-capture-* and the ReplayNode
+;
+; Capture the lines read from a file, with a pause between two of
+; them; then play the capture back, flat out, and at the recorded
+; pace, and check that the same lines come back, with the pause.
+;
+(use-modules (opencog) (opencog sensory))
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "capture-replay")
+(test-begin tname)
+
+(define test-file "/tmp/capture-replay-test.txt")
+(define cap-file "/tmp/capture-replay-test.cap")
+
+(define (clean-up)
+	(system (string-append "rm -f " test-file " " cap-file)))
+(clean-up)
+
+(with-output-to-file test-file
+	(lambda ()
+		(for-each (lambda (i) (format #t "Line ~a\n" i)) '(0 1 2 3))))
+
+; ----------------------------------------------------------
+; Capture.
+
+(define txt (TextFile (string-append "file://" test-file)))
+(define (read-txt) (cog-value-ref (cog-value txt (Predicate "*-read-*")) 0))
+
+(cog-set-value! txt (Predicate "*-capture-*") (StringValue cap-file))
+(cog-set-value! txt (Predicate "*-open-*") (Type 'StringValue))
+(read-txt)
+(read-txt)
+(usleep 400000)
+(read-txt)
+(read-txt)
+(test-assert "monitor" (string-contains
+	(cog-value-ref (cog-value txt (Predicate "*-monitor-*")) 0)
+	"Capturing to: /tmp/capture-replay-test.cap"))
+
+; Stopping the capture closes the file.
+(cog-set-value! txt (Predicate "*-capture-*") (VoidValue))
+(cog-set-value! txt (Predicate "*-close-*") (VoidValue))
+(test-assert "capture-file" (file-exists? cap-file))
+
+; ----------------------------------------------------------
+; Replay, as fast as possible.
+
+(define rep (ReplayNode (string-append "file://" cap-file)))
+(define (read-rep) (cog-value rep (Predicate "*-read-*")))
+(define (now) (/ (get-internal-real-time) internal-time-units-per-second))
+
+(cog-set-value! rep (Predicate "*-speed-*") (Number 0))
+(cog-set-value! rep (Predicate "*-open-*") (VoidValue))
+
+(define start (now))
+(define fast (map (lambda (i) (cog-value-ref (read-rep) 0)) '(0 1 2 3)))
+(test-equal "fast-lines" '("Line 0\n" "Line 1\n" "Line 2\n" "Line 3\n") fast)
+(test-assert "fast" (< (- (now) start) 0.2))
+(test-equal "eof" 'VoidValue (cog-type (read-rep)))
+
+; ----------------------------------------------------------
+; Replay at the recorded pace: the pause comes back.
+
+(cog-set-value! rep (Predicate "*-speed-*") (Number 1))
+(cog-set-value! rep (Predicate "*-open-*") (VoidValue))
+(read-rep)
+(read-rep)
+(define before (now))
+(test-equal "paced-line" "Line 2\n" (cog-value-ref (read-rep) 0))
+(test-assert "paced" (< 0.3 (- (now) before)))
+
+; A timeout shorter than the gap gives a TimeoutValue, not EOF.
+(cog-set-value! rep (Predicate "*-open-*") (VoidValue))
+(cog-set-value! rep (Predicate "*-timeout-*") (Number 50))
+(read-rep)
+(read-rep)
+(define timed-out (read-rep))
+(test-assert "timeout" (and (equal? 'TimeoutValue (cog-type timed-out))
+	(= 0 (length (cog-value->list timed-out)))))
+(test-assert "replay-monitor" (string-contains
+	(cog-value-ref (cog-value rep (Predicate "*-monitor-*")) 0)
+	"Played: 2 items"))
+
+(cog-set-value! rep (Predicate "*-close-*") (VoidValue))
+
+; ----------------------------------------------------------
+; A live capture can be read while it is still recording: after a
+; barrier, and, failing that, a little while after each item.
+
+(define (replayed)
+	(define live (ReplayNode (string-append "file://" cap-file)))
+	(cog-set-value! live (Predicate "*-speed-*") (Number 0))
+	(cog-set-value! live (Predicate "*-open-*") (VoidValue))
+	(let loop ((n 0))
+		(if (equal? 'VoidValue (cog-type (cog-value live (Predicate "*-read-*"))))
+			(begin (cog-set-value! live (Predicate "*-close-*") (VoidValue)) n)
+			(loop (+ n 1)))))
+
+(cog-set-value! txt (Predicate "*-capture-*") (StringValue cap-file))
+(cog-set-value! txt (Predicate "*-open-*") (Type 'StringValue))
+(read-txt)
+(read-txt)
+(cog-set-value! txt (Predicate "*-barrier-*") (cog-atomspace))
+(test-equal "live-after-barrier" 2 (replayed))
+
+(read-txt)
+(usleep 1000000)
+(test-equal "live-after-wait" 3 (replayed))
+
+(cog-set-value! txt (Predicate "*-capture-*") (VoidValue))
+(cog-set-value! txt (Predicate "*-close-*") (VoidValue))
+(clean-up)
+
+(test-end tname)
+
+(opencog-test-end)
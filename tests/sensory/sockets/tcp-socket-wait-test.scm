@@ -0,0 +1,93 @@
+#! /usr/bin/env guile
+-s
+!#
+;
+; tcp-socket-wait-test.scm -- Test TcpSocketNode waits
+;
+; The socket is non-blocking; reads and writes wait for it to become
+; ready. Check that a read times out when asked to, that a read
+; started before any client connects picks up the client, that a
+; write larger than the socket buffers goes out whole, and that
+; close() from another thread ends a waiting read.
+;
+(use-modules (opencog) (opencog sensory))
+(use-modules (opencog test-runner))
+(use-modules (ice-9 rdelim) (ice-9 threads))
+
+(opencog-test-runner)
+
+(define tname "tcp-socket-wait-test")
+(test-begin tname)
+
+(define test-port 17173)
+(define test-url (string-append "tcp://127.0.0.1:" (number->string test-port)))
+
+(define sock-node (TcpSocketNode test-url))
+(Trigger
+	(SetValue sock-node (Predicate "*-open-*") (Type 'StringValue)))
+
+(Pipe (Name "wait-reader") (ValueOf sock-node (Predicate "*-read-*")))
+
+; ----------------------------------------------------------
+; With a timeout, a read with no client gives up, with a
+; TimeoutValue.
+
+(cog-set-value! sock-node (Predicate "*-timeout-*") (Number 200))
+(define tmo (Trigger (Name "wait-reader")))
+(test-assert "read-timeout"
+	(and (equal? 'TimeoutValue (cog-type tmo))
+	     (= 0 (length (cog-value->list tmo)))))
+(cog-set-value! sock-node (Predicate "*-timeout-*") (Number 0))
+
+; ----------------------------------------------------------
+; Read first, then connect and send.
+
+(define reader (call-with-new-thread
+	(lambda () (Trigger (Name "wait-reader")))))
+
+(sleep 1)
+(define client-sock (socket AF_INET SOCK_STREAM 0))
+(connect client-sock AF_INET (inet-pton AF_INET "127.0.0.1") test-port)
+(display "late line\n" client-sock)
+(force-output client-sock)
+
+(define late (join-thread reader (+ (current-time) 10) #f))
+(test-assert "read-waits-for-client"
+	(and late
+	     (equal? 'StringValue (cog-type late))
+	     (string-contains (cog-value-ref late 0) "late line")))
+
+; ----------------------------------------------------------
+; Write more than the socket buffers hold; the client reads it
+; while the write is still going.
+
+(define big (make-string 4000000 #\x))
+(define writer (call-with-new-thread
+	(lambda ()
+		(Trigger
+			(SetValue sock-node (Predicate "*-write-*")
+				(Item (string-append big "\n"))))
+		#t)))
+
+(define got (read-line client-sock))
+(test-assert "big-write-done" (join-thread writer (+ (current-time) 10) #f))
+(test-equal "big-write-whole" (string-length big) (string-length got))
+
+; ----------------------------------------------------------
+; A read with nothing to read is ended by close().
+
+(define idle (call-with-new-thread
+	(lambda () (Trigger (Name "wait-reader")) #t)))
+
+(sleep 1)
+(Trigger
+	(SetValue sock-node (Predicate "*-close-*") (Number 1)))
+
+(test-assert "close-ends-read" (join-thread idle (+ (current-time) 10) #f))
+
+(close-port client-sock)
+
+; ----------------------------------------------------------
+(test-end tname)
+
+(opencog-test-end)